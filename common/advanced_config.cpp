@@ -141,6 +141,18 @@ static const wxChar DebugZoneFiller[] = wxT( "DebugZoneFiller" );
 
 static const wxChar SkipBoundingBoxFpLoad[] = wxT( "SkipBoundingBoxFpLoad" );
 
+/**
+ * When true, the filled polygons of zones are kept as text when loading a board, and only
+ * parsed when first used.  Faster loads for scripts which don't look at (or will refill) zones.
+ */
+static const wxChar DeferZoneFillLoad[] = wxT( "DeferZoneFillLoad" );
+
+/**
+ * When true, the DRC markers are brought up to date after each change to the board, by
+ * re-testing only the changed items.  Only once DRC has been run on the board.
+ */
+static const wxChar IncrementalDrc[] = wxT( "IncrementalDrc" );
+
 } // namespace KEYS
 
 
@@ -240,6 +252,10 @@ ADVANCED_CFG::ADVANCED_CFG()
 
     m_SkipBoundingBoxOnFpLoad   = false;
 
+    m_DeferZoneFillLoad         = false;
+
+    m_IncrementalDrc            = false;
+
     loadFromConfigFile();
 }
 
@@ -320,6 +336,12 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::SkipBoundingBoxFpLoad,
                                                 &m_SkipBoundingBoxOnFpLoad, false ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DeferZoneFillLoad,
+                                                &m_DeferZoneFillLoad, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalDrc,
+                                                &m_IncrementalDrc, false ) );
+
     wxConfigLoadSetups( &aCfg, configParams );
 
     for( PARAM_CFG* param : configParams )
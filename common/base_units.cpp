@@ -34,6 +34,8 @@
  *       depending on the application.
  */
 
+#include <cmath>
+
 #include <base_units.h>
 #include <common.h>
 #include <kicad_string.h>
@@ -525,59 +527,142 @@ wxString GetAbbreviatedUnitsLabel( EDA_UNITS aUnit, EDA_DATA_TYPE aType )
 }
 
 
-std::string FormatInternalUnits( int aValue )
+// The integer value of a decimal fixed point number, without trailing zeros in the fraction.
+// This is what "%.10g" prints for the numbers KiCad writes: they never have more than ten
+// significant digits.
+static int formatFixedPoint( char* aBuf, long long aValue, int aDecimals )
 {
-    char    buf[50];
-    double  engUnits = aValue;
-    int     len;
+    char               digits[24];
+    int                count = 0;
+    char*              p = aBuf;
+    unsigned long long magnitude = aValue < 0 ? 0ULL - (unsigned long long) aValue : aValue;
 
-    engUnits /= IU_PER_MM;
+    if( aValue < 0 )
+        *p++ = '-';
 
-    if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+    // At least one digit before the decimal point
+    do
     {
-        len = snprintf( buf, sizeof(buf), "%.10f", engUnits );
+        digits[count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while( magnitude || count <= aDecimals );
 
-        while( --len > 0 && buf[len] == '0' )
-            buf[len] = '\0';
+    int fractionEnd = 0;
 
-        if( buf[len] == '.' )
-            buf[len] = '\0';
-        else
-            ++len;
-    }
-    else
+    while( fractionEnd < aDecimals && digits[fractionEnd] == '0' )
+        fractionEnd++;
+
+    for( int ii = count - 1; ii >= aDecimals; --ii )
+        *p++ = digits[ii];
+
+    if( fractionEnd < aDecimals )
     {
-        len = snprintf( buf, sizeof(buf), "%.10g", engUnits );
+        *p++ = '.';
+
+        for( int ii = aDecimals - 1; ii >= fractionEnd; --ii )
+            *p++ = digits[ii];
     }
 
+    *p = '\0';
+    return p - aBuf;
+}
+
+
+// IU_PER_MM is a power of ten in every application
+static constexpr int decimalsOf( double aIuPerMm )
+{
+    return aIuPerMm > 1.0 ? 1 + decimalsOf( aIuPerMm / 10.0 ) : 0;
+}
+
+static constexpr double powerOfTen( int aExponent )
+{
+    return aExponent > 0 ? 10.0 * powerOfTen( aExponent - 1 ) : 1.0;
+}
+
+static constexpr int IU_DECIMALS = decimalsOf( IU_PER_MM );
+
+static_assert( powerOfTen( IU_DECIMALS ) == IU_PER_MM,
+               "FormatInternalUnits() needs IU_PER_MM to be a power of ten" );
+
+
+int FormatInternalUnits( int aValue, char* aBuf )
+{
+    // Same text as "%.10g" of the value in mm (or "%.10f" without trailing zeros for the
+    // smallest values), since an int has at most ten digits, but without the C library.
+    return formatFixedPoint( aBuf, aValue, IU_DECIMALS );
+}
+
+
+std::string FormatInternalUnits( int aValue )
+{
+    char buf[FMT_IU_BUFZ];
+    int  len = FormatInternalUnits( aValue, buf );
+
     return std::string( buf, len );
 }
 
 
+int FormatAngle( double aAngle, char* aBuf )
+{
+    // Angles are almost always whole tenths of degree, which are exact in one decimal
+    if( aAngle == std::floor( aAngle ) && std::fabs( aAngle ) < 1e9
+            && !( aAngle == 0.0 && std::signbit( aAngle ) ) )
+    {
+        return formatFixedPoint( aBuf, (long long) aAngle, 1 );
+    }
+
+    return snprintf( aBuf, FMT_IU_BUFZ, "%.10g", aAngle / 10.0 );
+}
+
+
 std::string FormatAngle( double aAngle )
 {
-    char temp[50];
-    int len;
+    char buf[FMT_IU_BUFZ];
+    int  len = FormatAngle( aAngle, buf );
+
+    return std::string( buf, len );
+}
+
+
+static int formatPair( int aX, int aY, char* aBuf )
+{
+    int len = FormatInternalUnits( aX, aBuf );
+
+    aBuf[len++] = ' ';
+    len += FormatInternalUnits( aY, aBuf + len );
+
+    return len;
+}
+
+
+static std::string formatPair( int aX, int aY )
+{
+    char buf[2 * FMT_IU_BUFZ];
+    int  len = formatPair( aX, aY, buf );
+
+    return std::string( buf, len );
+}
 
-    len = snprintf( temp, sizeof(temp), "%.10g", aAngle / 10.0 );
 
-    return std::string( temp, len );
+int FormatInternalUnits( const VECTOR2I& aPoint, char* aBuf )
+{
+    return formatPair( aPoint.x, aPoint.y, aBuf );
 }
 
 
 std::string FormatInternalUnits( const wxPoint& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    return formatPair( aPoint.x, aPoint.y );
 }
 
 
 std::string FormatInternalUnits( const VECTOR2I& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    return formatPair( aPoint.x, aPoint.y );
 }
 
 
 std::string FormatInternalUnits( const wxSize& aSize )
 {
-    return FormatInternalUnits( aSize.GetWidth() ) + " " + FormatInternalUnits( aSize.GetHeight() );
+    return formatPair( aSize.GetWidth(), aSize.GetHeight() );
 }
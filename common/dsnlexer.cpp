@@ -623,7 +623,7 @@ L_read:
                     case 'v':   c = '\x0b';     break;
 
                     case 'x':   // 1 or 2 byte hex escape sequence
-                        for( i=0; i<2; ++i )
+                        for( i=0; i<2 && head+i<limit; ++i )
                         {
                             if( !isxdigit( head[i] ) )
                                 break;
@@ -639,7 +639,7 @@ L_read:
 
                     default:    // 1-3 byte octal escape sequence
                         --head;
-                        for( i=0; i<3; ++i )
+                        for( i=0; i<3 && head+i<limit; ++i )
                         {
                             if( head[i] < '0' || head[i] > '7' )
                                 break;
@@ -665,7 +665,15 @@ L_read:
                 }
 
                 else
-                    curText += *head++;
+                {
+                    // copy the plain characters up to the next escape or quote at once
+                    const char* run = head;
+
+                    while( head<limit && *head != '\\' && *head != '"' )
+                        ++head;
+
+                    curText.append( run, head );
+                }
 
             }   // while
 
@@ -746,11 +754,11 @@ L_read:
     }           // specctraMode
 
     // non-quoted token, read it into curText.
-    curText.clear();
-
     head = cur;
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
+
+    curText.assign( cur, head );
 
     if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
     {
@@ -776,6 +784,75 @@ exit:   // single point of exit, no returns elsewhere please.
 }
 
 
+void DSNLEXER::ReadSexprText( std::string& aText )
+{
+    const char* cur = next;
+    const char* from = next;
+    int         depth = 1;
+    bool        inString = false;
+
+    while( depth > 0 )
+    {
+        if( cur >= limit )
+        {
+            aText.append( from, limit );
+
+            if( readLine() == 0 )
+            {
+                curTok = DSN_EOF;
+                curText.clear();
+                curOffset = 0;
+                next = start;
+                return;
+            }
+
+            cur = from = start;
+
+            // Neither a string nor a comment can go on past the end of its line
+            inString = false;
+
+            while( cur<limit && isSpace( *cur ) )
+                ++cur;
+
+            if( cur<limit && *cur=='#' )
+                cur = limit;
+
+            continue;
+        }
+
+        char cc = *cur++;
+
+        if( inString )
+        {
+            if( cc == '\\' && cur<limit )
+                ++cur;      // the escaped character, maybe a quote
+            else if( cc == stringDelimiter )
+                inString = false;
+        }
+        else if( cc == stringDelimiter && ( cur - 1 == start || isSep( cur[-2] ) ) )
+        {
+            inString = true;    // a quote within a symbol does not begin a string
+        }
+        else if( cc == '(' )
+        {
+            ++depth;
+        }
+        else if( cc == ')' )
+        {
+            --depth;
+        }
+    }
+
+    aText.append( from, cur );
+
+    prevTok = curTok;
+    curTok = DSN_RIGHT;
+    curText = ')';
+    curOffset = cur - 1 - start;
+    next = cur;
+}
+
+
 wxArrayString* DSNLEXER::ReadCommentLines()
 {
     wxArrayString*  ret = 0;
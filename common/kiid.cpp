@@ -30,9 +30,22 @@
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/functional/hash.hpp>
 
+#include <mutex>
+
 // Create only once, as seeding is *very* expensive
 static boost::uuids::random_generator randomGenerator;
 
+// Items can be created on several threads at once, e.g. when loading a board
+static std::mutex randomGeneratorLock;
+
+
+static boost::uuids::uuid randomUuid()
+{
+    std::lock_guard<std::mutex> lock( randomGeneratorLock );
+
+    return randomGenerator();
+}
+
 // These don't have the same performance penalty, but might as well be consistent
 static boost::uuids::string_generator stringGenerator;
 static boost::uuids::nil_generator    nilGenerator;
@@ -48,7 +61,7 @@ KIID& NilUuid()
 }
 
 
-KIID::KIID() : m_uuid( randomGenerator() ), m_cached_timestamp( 0 )
+KIID::KIID() : m_uuid( randomUuid() ), m_cached_timestamp( 0 )
 {
 }
 
@@ -87,7 +100,7 @@ KIID::KIID( const wxString& aString ) : m_uuid(), m_cached_timestamp( 0 )
         {
             // Failed to parse string representation; best we can do is assign a new
             // random one.
-            m_uuid = randomGenerator();
+            m_uuid = randomUuid();
         }
     }
 }
@@ -189,7 +202,7 @@ void KIID::ConvertTimestampToUuid()
         return;
 
     m_cached_timestamp = 0;
-    m_uuid             = randomGenerator();
+    m_uuid             = randomUuid();
 }
 
 
@@ -23,7 +23,10 @@
  */
 
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstdint>
+#include <cstring>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
 #include <richio.h>
@@ -32,6 +35,19 @@
 #include <wx/file.h>
 #include <wx/translation.h>
 
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN 1
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 
 // Fall back to getc() when getc_unlocked() is not available on the target platform.
 #if !defined( HAVE_FGETC_NOLOCK )
@@ -282,6 +298,188 @@ char* STRING_LINE_READER::ReadLine()
 }
 
 
+const char* STRING_LINE_READER::ReadLineInPlace()
+{
+    size_t  nlOffset = m_lines.find( '\n', m_ndx );
+
+    if( nlOffset == std::string::npos )
+        m_length = m_lines.length() - m_ndx;
+    else
+        m_length = nlOffset - m_ndx + 1;     // include the newline, so +1
+
+    ++m_lineNum;      // this gets incremented even if no bytes were read
+
+    if( !m_length )
+    {
+        m_line[0] = 0;
+        return NULL;
+    }
+
+    if( m_length >= m_maxLineLength )
+        THROW_IO_ERROR( _("Line length exceeded") );
+
+    const char* line = m_lines.data() + m_ndx;
+
+    m_ndx += m_length;
+
+    return line;
+}
+
+
+MAPPED_FILE_LINE_READER::MAPPED_FILE_LINE_READER( const wxString& aFileName,
+            unsigned aStartingLineNumber, unsigned aMaxLineLength ) :
+    LINE_READER( aMaxLineLength ),
+    m_text( NULL ), m_size( 0 ), m_ndx( 0 ), m_mapped( false )
+{
+    m_source  = aFileName;
+    m_lineNum = aStartingLineNumber;
+
+#if defined( _WIN32 )
+    HANDLE file = CreateFileW( aFileName.wc_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+
+    if( file != INVALID_HANDLE_VALUE )
+    {
+        LARGE_INTEGER size;
+
+        if( GetFileSizeEx( file, &size ) && size.QuadPart > 0
+                && (unsigned long long) size.QuadPart <= SIZE_MAX )
+        {
+            HANDLE mapping = CreateFileMappingW( file, NULL, PAGE_READONLY, 0, 0, NULL );
+
+            if( mapping )
+            {
+                m_text = (const char*) MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+                m_size = (size_t) size.QuadPart;
+
+                // The view keeps the mapping open
+                CloseHandle( mapping );
+            }
+        }
+
+        CloseHandle( file );
+    }
+#else
+    int fd = open( aFileName.fn_str(), O_RDONLY );
+
+    if( fd >= 0 )
+    {
+        struct stat st;
+
+        if( fstat( fd, &st ) == 0 && st.st_size > 0
+                && (unsigned long long) st.st_size <= SIZE_MAX )
+        {
+            void* text = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+            if( text != MAP_FAILED )
+            {
+                madvise( text, st.st_size, MADV_SEQUENTIAL );
+
+                m_text = (const char*) text;
+                m_size = st.st_size;
+            }
+        }
+
+        close( fd );
+    }
+#endif
+
+    m_mapped = m_text != NULL;
+
+    if( !m_mapped )
+    {
+        // Empty files cannot be mapped, and neither can some special files: read them.
+        FILE* fp = wxFopen( aFileName, wxT( "rb" ) );
+
+        if( !fp )
+        {
+            wxString msg = wxString::Format(
+                _( "Unable to open filename \"%s\" for reading" ), aFileName.GetData() );
+            THROW_IO_ERROR( msg );
+        }
+
+        char   buf[8192];
+        size_t count;
+
+        while( ( count = fread( buf, 1, sizeof( buf ), fp ) ) > 0 )
+            m_contents.append( buf, count );
+
+        fclose( fp );
+
+        m_text = m_contents.data();
+        m_size = m_contents.size();
+    }
+}
+
+
+MAPPED_FILE_LINE_READER::~MAPPED_FILE_LINE_READER()
+{
+    if( m_mapped )
+    {
+#if defined( _WIN32 )
+        UnmapViewOfFile( m_text );
+#else
+        munmap( (void*) m_text, m_size );
+#endif
+    }
+}
+
+
+size_t MAPPED_FILE_LINE_READER::nextLine()
+{
+    size_t      offset = m_ndx;
+    const char* nl = (const char*) memchr( m_text + offset, '\n', m_size - offset );
+
+    // include the newline
+    size_t      end = nl ? nl - m_text + 1 : m_size;
+
+    if( end - offset >= m_maxLineLength )
+        THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+    m_length = end - offset;
+    m_ndx = end;
+
+    // m_lineNum is incremented even if there was no line read, because this
+    // leads to better error reporting when we hit an end of file.
+    ++m_lineNum;
+
+    return offset;
+}
+
+
+char* MAPPED_FILE_LINE_READER::ReadLine()
+{
+    size_t   offset = nextLine();
+    unsigned length = m_length;
+
+    if( length + 1 > m_capacity )   // +1 for terminating nul
+    {
+        m_length = 0;               // nothing to keep from the last line
+        expandCapacity( length + 1 );
+        m_length = length;
+    }
+
+    memcpy( m_line, m_text + offset, m_length );
+    m_line[m_length] = 0;
+
+    return m_length ? m_line : NULL;
+}
+
+
+const char* MAPPED_FILE_LINE_READER::ReadLineInPlace()
+{
+    size_t offset = nextLine();
+
+    if( !m_length )
+    {
+        m_line[0] = 0;
+        return NULL;
+    }
+
+    return m_text + offset;
+}
+
+
 INPUTSTREAM_LINE_READER::INPUTSTREAM_LINE_READER( wxInputStream* aStream, const wxString& aSource ) :
     LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
     m_stream( aStream )
@@ -367,70 +565,189 @@ const char* OUTPUTFORMATTER::GetQuoteChar( const char* wrapee )
     return GetQuoteChar( wrapee, quoteChar );
 }
 
-int OUTPUTFORMATTER::vprint( const char* fmt,  va_list ap )
+/**
+ * Tells whether a format only has the conversions OUTPUTFORMATTER::vprint() expands itself:
+ * %s, %c, %d, %i, %u, %ld, %li, %lu and %%, without flags, width or precision.
+ */
+static bool isSimpleFormat( const char* fmt )
 {
-    // This function can call vsnprintf twice.
-    // But internally, vsnprintf retrieves arguments from the va_list identified by arg as if
-    // va_arg was used on it, and thus the state of the va_list is likely to be altered by the call.
-    // see: www.cplusplus.com/reference/cstdio/vsnprintf
-    // we make a copy of va_list ap for the second call, if happens
-    va_list tmp;
-    va_copy( tmp, ap );
-    int ret = vsnprintf( &m_buffer[0], m_buffer.size(), fmt, ap );
-
-    if( ret >= (int) m_buffer.size() )
+    for( const char* p = strchr( fmt, '%' ); p; p = strchr( p + 1, '%' ) )
     {
-        m_buffer.resize( ret + 1000 );
-        ret = vsnprintf( &m_buffer[0], m_buffer.size(), fmt, tmp );
-    }
+        ++p;
 
-    va_end( tmp );      // Release the temporary va_list, initialised from ap
+        if( *p == 'l' )
+        {
+            ++p;
 
-    if( ret > 0 )
-        write( &m_buffer[0], ret );
+            if( *p != 'd' && *p != 'i' && *p != 'u' )
+                return false;
+        }
+        else if( !*p || !strchr( "scdiu%", *p ) )
+        {
+            return false;
+        }
+    }
 
-    return ret;
+    return true;
 }
 
 
-int OUTPUTFORMATTER::sprint( const char* fmt, ... )
+static int formatUnsigned( char* aBuf, unsigned long aValue )
 {
-    va_list     args;
+    char digits[24];
+    int  count = 0;
 
-    va_start( args, fmt );
-    int ret = vprint( fmt, args);
-    va_end( args );
+    do
+    {
+        digits[count++] = '0' + aValue % 10;
+        aValue /= 10;
+    } while( aValue );
 
-    return ret;
+    for( int ii = 0; ii < count; ++ii )
+        aBuf[ii] = digits[count - 1 - ii];
+
+    return count;
 }
 
 
-int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
+static int formatSigned( char* aBuf, long aValue )
 {
-#define NESTWIDTH           2   ///< how many spaces per nestLevel
+    if( aValue >= 0 )
+        return formatUnsigned( aBuf, aValue );
 
-    va_list     args;
+    aBuf[0] = '-';
+    return 1 + formatUnsigned( aBuf + 1, 0UL - (unsigned long) aValue );
+}
 
-    va_start( args, fmt );
 
-    int result = 0;
-    int total  = 0;
+int OUTPUTFORMATTER::vprint( const char* fmt,  va_list ap, int aIndent )
+{
+    if( (int) m_buffer.size() <= aIndent )
+        m_buffer.resize( aIndent + OUTPUTFMTBUFZ );
+
+    memset( &m_buffer[0], ' ', aIndent );
+
+    if( !isSimpleFormat( fmt ) )
+    {
+        // This function can call vsnprintf twice.
+        // But internally, vsnprintf retrieves arguments from the va_list identified by arg as
+        // if va_arg was used on it, and thus the state of the va_list is likely to be altered
+        // by the call.
+        // see: www.cplusplus.com/reference/cstdio/vsnprintf
+        // we make a copy of va_list ap for the second call, if happens
+        va_list tmp;
+        va_copy( tmp, ap );
+        int ret = vsnprintf( &m_buffer[aIndent], m_buffer.size() - aIndent, fmt, ap );
+
+        if( ret >= (int) m_buffer.size() - aIndent )
+        {
+            m_buffer.resize( aIndent + ret + 1000 );
+            ret = vsnprintf( &m_buffer[aIndent], m_buffer.size() - aIndent, fmt, tmp );
+        }
+
+        va_end( tmp );      // Release the temporary va_list, initialised from ap
+
+        if( ret < 0 )
+            return ret;
+
+        if( aIndent + ret > 0 )
+            write( &m_buffer[0], aIndent + ret );
+
+        return aIndent + ret;
+    }
 
-    for( int i=0; i<nestLevel;  ++i )
+    // The s-expression writers print mostly strings and integers: expand those here, which is
+    // several times faster than vsnprintf() parsing the format.
+    size_t len = aIndent;
+
+    auto reserve =
+            [&]( size_t aCount )
+            {
+                if( len + aCount > m_buffer.size() )
+                    m_buffer.resize( std::max( 2 * m_buffer.size(), len + aCount ) );
+            };
+
+    for( const char* p = fmt; *p; ++p )
     {
-        // no error checking needed, an exception indicates an error.
-        result = sprint( "%*c", NESTWIDTH, ' ' );
+        if( *p != '%' )
+        {
+            const char* next = strchr( p, '%' );
+            size_t      count = next ? next - p : strlen( p );
+
+            reserve( count );
+            memcpy( &m_buffer[len], p, count );
+            len += count;
+            p += count - 1;
+            continue;
+        }
+
+        reserve( 24 );
 
-        total += result;
+        switch( *++p )
+        {
+        case 's':
+        {
+            const char* str = va_arg( ap, const char* );
+
+            if( !str )
+                str = "(null)";
+
+            size_t count = strlen( str );
+
+            reserve( count );
+            memcpy( &m_buffer[len], str, count );
+            len += count;
+            break;
+        }
+
+        case 'c':
+            m_buffer[len++] = (char) va_arg( ap, int );
+            break;
+
+        case 'd':
+        case 'i':
+            len += formatSigned( &m_buffer[len], va_arg( ap, int ) );
+            break;
+
+        case 'u':
+            len += formatUnsigned( &m_buffer[len], va_arg( ap, unsigned ) );
+            break;
+
+        case 'l':
+            if( *++p == 'u' )
+                len += formatUnsigned( &m_buffer[len], va_arg( ap, unsigned long ) );
+            else
+                len += formatSigned( &m_buffer[len], va_arg( ap, long ) );
+
+            break;
+
+        default:    // '%'
+            m_buffer[len++] = '%';
+            break;
+        }
     }
 
-    // no error checking needed, an exception indicates an error.
-    result = vprint( fmt, args );
+    if( len > 0 )
+        write( &m_buffer[0], len );
+
+    return len;
+}
+
+
+int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
+{
+#define NESTWIDTH           2   ///< how many spaces per nestLevel
+
+    va_list     args;
+
+    va_start( args, fmt );
+
+    // The indentation goes out in the same write() as the text
+    int result = vprint( fmt, args, std::max( nestLevel, 0 ) * NESTWIDTH );
 
     va_end( args );
 
-    total += result;
-    return total;
+    return result;
 }
 
 
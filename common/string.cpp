@@ -26,7 +26,13 @@
  * @brief Some useful functions to handle strings.
  */
 
+#include <cerrno>
+#include <climits>
 #include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <locale>
+#include <sstream>
 #include <macros.h>
 #include <richio.h>                        // StrPrintf
 #include <kicad_string.h>
@@ -381,6 +387,203 @@ char* StrPurge( char* text )
 }
 
 
+// The "C" locale character classes, whatever the current locale is
+static bool isSpaceC( char c )
+{
+    return c == ' ' || ( c >= '\t' && c <= '\r' );
+}
+
+
+static bool isHexDigitC( char c )
+{
+    return ( c >= '0' && c <= '9' ) || ( c >= 'a' && c <= 'f' ) || ( c >= 'A' && c <= 'F' );
+}
+
+
+double StrToDouble( const char* aText, const char** aEnd )
+{
+    // Powers of ten that are exact in a double
+    static const double pow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    const char* p = aText;
+    bool        negative = false;
+    uint64_t    mantissa = 0;
+    int         digits = 0;         // significant digits in the mantissa
+    int         exponent = 0;
+    bool        truncated = false;
+    bool        haveDigits = false;
+
+    if( aEnd )
+        *aEnd = aText;
+
+    while( isSpaceC( *p ) )
+        ++p;
+
+    if( *p == '-' || *p == '+' )
+        negative = *p++ == '-';
+
+    for( ; *p >= '0' && *p <= '9'; ++p )
+    {
+        haveDigits = true;
+
+        if( digits < 19 )
+        {
+            mantissa = mantissa * 10 + ( *p - '0' );
+            digits += mantissa > 0;
+        }
+        else
+        {
+            truncated |= *p != '0';
+            exponent++;
+        }
+    }
+
+    if( *p == '.' )
+    {
+        for( ++p; *p >= '0' && *p <= '9'; ++p )
+        {
+            haveDigits = true;
+
+            if( digits < 19 )
+            {
+                mantissa = mantissa * 10 + ( *p - '0' );
+                digits += mantissa > 0;
+                exponent--;
+            }
+            else
+            {
+                truncated |= *p != '0';
+            }
+        }
+    }
+
+    if( !haveDigits )
+        return 0.0;
+
+    if( *p == 'e' || *p == 'E' )
+    {
+        const char* q = p + 1;
+        bool        negativeExp = false;
+        int         exp = 0;
+
+        if( *q == '-' || *q == '+' )
+            negativeExp = *q++ == '-';
+
+        if( *q >= '0' && *q <= '9' )
+        {
+            for( ; *q >= '0' && *q <= '9'; ++q )
+            {
+                if( exp < 100000 )
+                    exp = exp * 10 + ( *q - '0' );
+            }
+
+            exponent += negativeExp ? -exp : exp;
+            p = q;
+        }
+    }
+
+    if( aEnd )
+        *aEnd = p;
+
+    double value;
+
+    if( mantissa == 0 && !truncated )
+    {
+        value = 0.0;
+    }
+    else if( !truncated && mantissa <= ( uint64_t( 1 ) << 53 ) && exponent >= -22
+             && exponent <= 22 )
+    {
+        // Both operands are exact, so the result is correctly rounded (Clinger's fast path)
+        value = (double) mantissa;
+        value = exponent < 0 ? value / pow10[-exponent] : value * pow10[exponent];
+    }
+    else
+    {
+        // Rare: too many digits or a large exponent.  Let the classic locale round it.
+        std::istringstream stream( std::string( aText, p ) );
+        stream.imbue( std::locale::classic() );
+        stream >> value;
+
+        if( stream.fail() )
+        {
+            errno = ERANGE;
+            value = negative ? -HUGE_VAL : HUGE_VAL;
+        }
+        else if( value == 0.0 )
+        {
+            errno = ERANGE;
+        }
+
+        return value;
+    }
+
+    return negative ? -value : value;
+}
+
+
+long StrToLong( const char* aText, const char** aEnd, int aBase )
+{
+    const char* p = aText;
+    bool        negative = false;
+
+    if( aEnd )
+        *aEnd = aText;
+
+    while( isSpaceC( *p ) )
+        ++p;
+
+    if( *p == '-' || *p == '+' )
+        negative = *p++ == '-';
+
+    if( aBase == 16 && p[0] == '0' && ( p[1] == 'x' || p[1] == 'X' ) && isHexDigitC( p[2] ) )
+        p += 2;
+
+    const char*   firstDigit = p;
+    unsigned long limit = negative ? (unsigned long) LONG_MAX + 1 : LONG_MAX;
+    unsigned long value = 0;
+    bool          overflow = false;
+
+    for( ; ; ++p )
+    {
+        int digit;
+
+        if( *p >= '0' && *p <= '9' )
+            digit = *p - '0';
+        else if( *p >= 'a' && *p <= 'z' )
+            digit = *p - 'a' + 10;
+        else if( *p >= 'A' && *p <= 'Z' )
+            digit = *p - 'A' + 10;
+        else
+            break;
+
+        if( digit >= aBase )
+            break;
+
+        if( value > ( limit - digit ) / aBase )
+            overflow = true;
+        else
+            value = value * aBase + digit;
+    }
+
+    if( p == firstDigit )
+        return 0;
+
+    if( aEnd )
+        *aEnd = p;
+
+    if( overflow )
+    {
+        errno = ERANGE;
+        return negative ? LONG_MIN : LONG_MAX;
+    }
+
+    return negative ? -(long) ( value - 1 ) - 1 : (long) value;
+}
+
+
 char* GetLine( FILE* File, char* Line, int* LineNum, int SizeLine )
 {
     do {
@@ -266,7 +266,7 @@ LIB_PART* SCH_SEXPR_PARSER::ParseSymbol( LIB_PART_MAP& aSymbolLibMap, int aFileV
                 THROW_IO_ERROR( error );
             }
 
-            if( !tokenizer.GetNextToken().ToLong( &tmp ) )
+            if( !tokenizer.GetNextToken().ToCLong( &tmp ) )
             {
                 error.Printf(
                     _( "Invalid symbol unit number %s in\nfile: \"%s\"\nline: %d\noffset: %d" ),
@@ -276,7 +276,7 @@ LIB_PART* SCH_SEXPR_PARSER::ParseSymbol( LIB_PART_MAP& aSymbolLibMap, int aFileV
 
             m_unit = static_cast<int>( tmp );
 
-            if( !tokenizer.GetNextToken().ToLong( &tmp ) )
+            if( !tokenizer.GetNextToken().ToCLong( &tmp ) )
             {
                 error.Printf(
                     _( "Invalid symbol convert number %s in\nfile: \"%s\"\nline: %d\noffset: %d" ),
@@ -395,11 +395,12 @@ LIB_ITEM* SCH_SEXPR_PARSER::ParseDrawItem()
 
 double SCH_SEXPR_PARSER::parseDouble()
 {
-    char* tmp;
+    const char* tmp;
 
     errno = 0;
 
-    double fval = strtod( CurText(), &tmp );
+    // Not strtod(): the files are in the "C" locale, whatever the locale of the process is
+    double fval = StrToDouble( CurText(), &tmp );
 
     if( errno )
     {
@@ -32,6 +32,7 @@
 #define __SCH_SEXPR_PARSER_H__
 
 #include <convert_to_biu.h>                      // IU_PER_MM
+#include <kicad_string.h>                        // StrToDouble, StrToLong
 #include <math/util.h>                           // KiROUND, Clamp
 
 #include <class_library.h>
@@ -89,12 +90,12 @@ class SCH_SEXPR_PARSER : public SCHEMATIC_LEXER
     inline long parseHex()
     {
         NextTok();
-        return strtol( CurText(), NULL, 16 );
+        return StrToLong( CurText(), NULL, 16 );
     }
 
     inline int parseInt()
     {
-        return (int)strtol( CurText(), NULL, 10 );
+        return (int) StrToLong( CurText(), NULL, 10 );
     }
 
     inline int parseInt( const char* aExpected )
@@ -147,6 +147,16 @@ public:
      */
     bool m_SkipBoundingBoxOnFpLoad;
 
+    /**
+     * Parse the filled polygons of zones when they are first used, not when loading boards
+     */
+    bool m_DeferZoneFillLoad;
+
+    /**
+     * Update the DRC markers after each change to the board, once DRC has been run
+     */
+    bool m_IncrementalDrc;
+
 private:
     ADVANCED_CFG();
 
@@ -211,6 +211,31 @@ std::string FormatInternalUnits( int aValue );
  */
 std::string FormatAngle( double aAngle );
 
+///< Size of a buffer large enough for any value written by the buffer versions of
+///< FormatInternalUnits() and FormatAngle(), including the terminating nul.
+#define FMT_IU_BUFZ 32
+
+/**
+ * Writes the same text as FormatInternalUnits( int ) to \a aBuf, without allocating.
+ * @param aBuf must hold at least FMT_IU_BUFZ characters.
+ * @return the number of characters written, not counting the terminating nul.
+ */
+int FormatInternalUnits( int aValue, char* aBuf );
+
+/**
+ * Writes the same text as FormatAngle( double ) to \a aBuf, without allocating.
+ * @param aBuf must hold at least FMT_IU_BUFZ characters.
+ * @return the number of characters written, not counting the terminating nul.
+ */
+int FormatAngle( double aAngle, char* aBuf );
+
+/**
+ * Writes the same text as FormatInternalUnits( const VECTOR2I& ) to \a aBuf, without allocating.
+ * @param aBuf must hold at least 2 * FMT_IU_BUFZ characters.
+ * @return the number of characters written, not counting the terminating nul.
+ */
+int FormatInternalUnits( const VECTOR2I& aPoint, char* aBuf );
+
 std::string FormatInternalUnits( const wxPoint& aPoint );
 
 std::string FormatInternalUnits( const wxSize& aSize );
@@ -107,6 +107,7 @@ protected:
 
     int                 curTok;                 ///< the current token obtained on last NextTok()
     std::string         curText;                ///< the text of the current token
+    std::string         curLine;                ///< CurLine() of a line read in place
 
     const KEYWORD*      keywords;               ///< table sorted by CMake for bsearch()
     unsigned            keywordCount;           ///< count of keywords table
@@ -118,13 +119,15 @@ protected:
     {
         if( reader )
         {
-            reader->ReadLine();
+            // Readers holding their text in memory give the line without copying it,
+            // so it is not nul terminated: the lexer only goes up to limit.
+            const char* line = reader->ReadLineInPlace();
 
             unsigned len = reader->Length();
 
             // start may have changed in ReadLine(), which can resize and
             // relocate reader's line buffer.
-            start = reader->Line();
+            start = line ? line : reader->Line();
 
             next  = start;
             limit = next + len;
@@ -398,6 +401,16 @@ public:
      */
     wxArrayString* ReadCommentLines();
 
+    /**
+     * Function ReadSexprText
+     * appends the rest of the current s-expression, up to and including the parenthesis
+     * which closes it, to @a aText as it is in the input, without breaking it into tokens.
+     * This is much faster than lexing it, e.g. to parse the text later on another thread.
+     * The lexer then goes on as if it had just returned that closing parenthesis, or the
+     * end of the input if it came first.  Only for the KiCad syntax, not specctraMode.
+     */
+    void ReadSexprText( std::string& aText );
+
     /**
      * Function IsSymbol
      * tests a token to see if it is a symbol.  This means it cannot be a
@@ -525,6 +538,13 @@ public:
      */
     const char* CurLine()
     {
+        // A line read in place has no terminating nul
+        if( start != reader->Line() )
+        {
+            curLine.assign( start, reader->Length() );
+            return curLine.c_str();
+        }
+
         return (const char*)(*reader);
     }
 
@@ -122,6 +122,29 @@ char* GetLine( FILE* aFile, char* Line, int* LineNum = NULL, int SizeLine = 255
  */
 char* StrPurge( char* text );
 
+/**
+ * Convert the decimal floating point number at the start of \a aText, like strtod() does in
+ * the "C" locale whatever the current locale is.  Nothing is allocated unless the number has
+ * more significant digits or a larger exponent than a double holds exactly.  Infinities, NaNs
+ * and hexadecimal numbers are not recognized.
+ *
+ * @param aText is the text to convert.
+ * @param aEnd if not NULL, receives a pointer past the number, or \a aText if there is none.
+ * @return the number, or 0.0 if there is none.  errno is set to ERANGE on overflow or
+ *         underflow.
+ */
+double StrToDouble( const char* aText, const char** aEnd );
+
+/**
+ * Convert the integer at the start of \a aText, like strtol() does in the "C" locale.
+ *
+ * @param aText is the text to convert.
+ * @param aEnd if not NULL, receives a pointer past the number, or \a aText if there is none.
+ * @param aBase is the radix, from 2 to 36.  A "0x" prefix is accepted for base 16.
+ * @return the number, or 0 if there is none.  errno is set to ERANGE on overflow.
+ */
+long StrToLong( const char* aText, const char** aEnd, int aBase = 10 );
+
 /**
  * @return a string giving the current date and time.
  */
@@ -29,6 +29,8 @@
 #include <boost/uuid/uuid.hpp>
 #include <macros_swig.h>
 
+#include <functional>
+
 class wxString;
 
 /**
@@ -141,4 +143,18 @@ public:
     }
 };
 
+#ifndef SWIG
+///> Template specialization to enable KIIDs as keys of unordered containers
+namespace std
+{
+    template <> struct hash<KIID>
+    {
+        size_t operator()( const KIID& aId ) const
+        {
+            return aId.Hash();
+        }
+    };
+}
+#endif
+
 #endif // KIID_H
\ No newline at end of file
@@ -121,6 +121,20 @@ public:
      */
     virtual char* ReadLine() = 0;
 
+    /**
+     * Function ReadLineInPlace
+     * reads a line of text like ReadLine(), but lets a reader which holds all of its text
+     * in memory return the line from there rather than copying it into the line buffer.
+     * Such a line is not nul terminated, it ends after Length() bytes, and it lives as
+     * long as the reader.  Line() is then not updated.
+     * @return const char* - The beginning of the read line, or NULL if EOF.
+     * @throw IO_ERROR when a line is too long.
+     */
+    virtual const char* ReadLineInPlace()
+    {
+        return ReadLine();
+    }
+
     /**
      * Function GetSource
      * returns the name of the source of the lines in an abstract sense.
@@ -281,6 +295,64 @@ public:
     STRING_LINE_READER( const STRING_LINE_READER& aStartingPoint );
 
     char* ReadLine() override;
+
+    const char* ReadLineInPlace() override;
+};
+
+
+/**
+ * MAPPED_FILE_LINE_READER
+ * is a LINE_READER that maps a whole file into memory, for reading large board and
+ * library files.  ReadLineInPlace() returns the lines straight from the mapping, without
+ * copying them.  When the file cannot be mapped, it is read into memory instead.
+ */
+class MAPPED_FILE_LINE_READER : public LINE_READER
+{
+protected:
+    const char*     m_text;         ///< the text of the file
+    size_t          m_size;         ///< no. bytes in the file
+    size_t          m_ndx;          ///< offset of the next line in m_text
+    bool            m_mapped;       ///< if true m_text is mapped, else it is m_contents
+    std::string     m_contents;     ///< the file text, when it could not be mapped
+
+    /**
+     * Function nextLine
+     * finds the line at m_ndx, sets m_length and moves m_ndx past it.
+     * @return the offset of the line in m_text.
+     */
+    size_t nextLine();
+
+public:
+
+    /**
+     * Constructor MAPPED_FILE_LINE_READER
+     * maps the file @a aFileName.
+     *
+     * @param aFileName is the name of the file to open and to use for error reporting purposes.
+     * @param aStartingLineNumber is the initial line number to report on error.
+     * @param aMaxLineLength is the maximum length of a line.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened.
+     */
+    MAPPED_FILE_LINE_READER( const wxString& aFileName,
+            unsigned aStartingLineNumber = 0,
+            unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~MAPPED_FILE_LINE_READER();
+
+    char* ReadLine() override;
+
+    const char* ReadLineInPlace() override;
+
+    /**
+     * Function Rewind
+     * goes back to the start of the file and resets the line number back to zero.
+     */
+    void Rewind()
+    {
+        m_ndx = 0;
+        m_lineNum = 0;
+    }
 };
 
 
@@ -330,8 +402,10 @@ class OUTPUTFORMATTER
     std::vector<char>   m_buffer;
     char                quoteChar[2];
 
-    int sprint( const char* fmt, ... );
-    int vprint( const char* fmt,  va_list ap );
+    /**
+     * Formats and writes text, preceded by \a aIndent spaces, in a single write().
+     */
+    int vprint( const char* fmt,  va_list ap, int aIndent = 0 );
 
 
 protected:
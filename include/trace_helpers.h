@@ -182,6 +182,14 @@ extern const wxChar* const traceSchSheetPaths;
  */
 extern const wxChar* const traceEnvVars;
 
+/**
+ * Flag to enable debug output of zone filling.
+ *
+ * Use "KICAD_ZONE_FILLER" to enable.
+ *
+ */
+extern const wxChar* const traceZoneFiller;
+
 ///@}
 
 /**
@@ -0,0 +1,379 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __PACKED_RTREE_H
+#define __PACKED_RTREE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+/**
+ * Class PACKED_RTREE
+ *
+ * A static R-tree, built in one go from a set of entries sorted in Sort-Tile-Recursive order.
+ * All the levels of the tree are stored in flat arrays (one array per box coordinate), so a
+ * search walks contiguous memory and the boxes of a node's children are tested in a single
+ * loop which the compiler can vectorize.
+ *
+ * Entries can't be added after Build(), but they can be removed (they're only marked as such).
+ * Searches don't modify the tree, so they can be run from several threads at once.
+ */
+template <class DATATYPE, int NUMDIMS, int NODESIZE = 16>
+class PACKED_RTREE
+{
+public:
+    struct ENTRY
+    {
+        int      min[NUMDIMS];
+        int      max[NUMDIMS];
+        DATATYPE data;
+    };
+
+    PACKED_RTREE() :
+            m_liveCount( 0 )
+    {
+    }
+
+    /**
+     * Replaces the contents of the tree with aEntries.  The entries are reordered in the process.
+     */
+    void Build( std::vector<ENTRY>& aEntries )
+    {
+        Clear();
+
+        if( aEntries.empty() )
+            return;
+
+        sortTileRecursive( aEntries.begin(), aEntries.end(), 0 );
+
+        size_t count = aEntries.size();
+        size_t total = count;
+
+        for( size_t level = count; level > 1; )
+        {
+            level = ( level + NODESIZE - 1 ) / NODESIZE;
+            total += level;
+        }
+
+        for( int dim = 0; dim < NUMDIMS; ++dim )
+        {
+            m_min[dim].reserve( total );
+            m_max[dim].reserve( total );
+        }
+
+        m_data.reserve( count );
+        m_removed.assign( count, 0 );
+        m_liveCount = count;
+
+        for( const ENTRY& entry : aEntries )
+        {
+            for( int dim = 0; dim < NUMDIMS; ++dim )
+            {
+                m_min[dim].push_back( entry.min[dim] );
+                m_max[dim].push_back( entry.max[dim] );
+            }
+
+            m_data.push_back( entry.data );
+        }
+
+        m_levels.emplace_back( 0, count );
+
+        while( m_levels.back().second > 1 )
+        {
+            size_t childStart = m_levels.back().first;
+            size_t childCount = m_levels.back().second;
+            size_t start = m_min[0].size();
+
+            for( size_t first = 0; first < childCount; first += NODESIZE )
+            {
+                size_t last = std::min( first + NODESIZE, childCount );
+
+                for( int dim = 0; dim < NUMDIMS; ++dim )
+                {
+                    const int* childMin = m_min[dim].data() + childStart;
+                    const int* childMax = m_max[dim].data() + childStart;
+
+                    m_min[dim].push_back( *std::min_element( childMin + first, childMin + last ) );
+                    m_max[dim].push_back( *std::max_element( childMax + first, childMax + last ) );
+                }
+            }
+
+            m_levels.emplace_back( start, m_min[0].size() - start );
+        }
+    }
+
+    void Clear()
+    {
+        for( int dim = 0; dim < NUMDIMS; ++dim )
+        {
+            m_min[dim].clear();
+            m_max[dim].clear();
+        }
+
+        m_data.clear();
+        m_removed.clear();
+        m_levels.clear();
+        m_liveCount = 0;
+    }
+
+    /**
+     * Calls aVisitor for the data of each (not removed) entry whose box intersects the
+     * given one, until it returns false.
+     * @return the number of entries visited.
+     */
+    template <class VISITOR>
+    int Search( const int aMin[NUMDIMS], const int aMax[NUMDIMS], VISITOR& aVisitor ) const
+    {
+        int found = 0;
+
+        searchLeaves( aMin, aMax,
+                      [&]( size_t aLeaf ) -> bool
+                      {
+                          if( m_removed[aLeaf] )
+                              return true;
+
+                          found++;
+                          return aVisitor( m_data[aLeaf] );
+                      } );
+
+        return found;
+    }
+
+    /**
+     * Marks the entry holding aData as removed, looking for it within the given box.
+     * @return true if it was found.
+     */
+    bool Remove( const int aMin[NUMDIMS], const int aMax[NUMDIMS], const DATATYPE& aData )
+    {
+        bool removed = false;
+
+        searchLeaves( aMin, aMax,
+                      [&]( size_t aLeaf ) -> bool
+                      {
+                          if( m_removed[aLeaf] || !( m_data[aLeaf] == aData ) )
+                              return true;
+
+                          m_removed[aLeaf] = 1;
+                          removed = true;
+                          return false;
+                      } );
+
+        if( removed )
+            m_liveCount--;
+
+        return removed;
+    }
+
+    /**
+     * Marks the entry holding aData as removed, wherever it is (for instance because the item
+     * has been moved since the tree was built).
+     * @return true if it was found.
+     */
+    bool Remove( const DATATYPE& aData )
+    {
+        for( size_t leaf = 0; leaf < m_data.size(); ++leaf )
+        {
+            if( !m_removed[leaf] && m_data[leaf] == aData )
+            {
+                m_removed[leaf] = 1;
+                m_liveCount--;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Appends the (not removed) entries to aEntries, e.g.\ to rebuild the tree with more.
+     */
+    void GetEntries( std::vector<ENTRY>& aEntries ) const
+    {
+        aEntries.reserve( aEntries.size() + m_liveCount );
+
+        for( size_t leaf = 0; leaf < m_data.size(); ++leaf )
+        {
+            if( m_removed[leaf] )
+                continue;
+
+            ENTRY entry;
+
+            for( int dim = 0; dim < NUMDIMS; ++dim )
+            {
+                entry.min[dim] = m_min[dim][leaf];
+                entry.max[dim] = m_max[dim][leaf];
+            }
+
+            entry.data = m_data[leaf];
+            aEntries.push_back( entry );
+        }
+    }
+
+    /// Number of entries, not counting removed ones.
+    size_t Size() const { return m_liveCount; }
+
+    /// Number of entries which have been removed since the tree was built.
+    size_t RemovedCount() const { return m_data.size() - m_liveCount; }
+
+    bool Empty() const { return m_liveCount == 0; }
+
+private:
+    /**
+     * Calls aVisitor with the index of each leaf whose box intersects the given one, until it
+     * returns false.
+     */
+    template <class VISITOR>
+    void searchLeaves( const int aMin[NUMDIMS], const int aMax[NUMDIMS], VISITOR aVisitor ) const
+    {
+        if( m_levels.empty() )
+            return;
+
+        // The tree can't be deeper than 32 levels and each node pushes at most NODESIZE children
+        std::pair<int, size_t> stack[32 * NODESIZE];
+        int                    top = 0;
+        unsigned char          hits[NODESIZE];
+
+        if( !testBoxes( m_levels.back().first, 1, aMin, aMax, hits ) )
+            return;
+
+        // A single entry is its own root
+        if( m_levels.size() == 1 )
+        {
+            aVisitor( 0 );
+            return;
+        }
+
+        stack[top++] = { (int) m_levels.size() - 1, 0 };
+
+        while( top > 0 )
+        {
+            const int    level = stack[top - 1].first;
+            const size_t node = stack[--top].second;
+
+            const size_t childStart = m_levels[level - 1].first;
+            const size_t first = node * NODESIZE;
+            const size_t count = std::min<size_t>( NODESIZE, m_levels[level - 1].second - first );
+
+            testBoxes( childStart + first, count, aMin, aMax, hits );
+
+            if( level == 1 )
+            {
+                for( size_t ii = 0; ii < count; ++ii )
+                {
+                    if( hits[ii] && !aVisitor( first + ii ) )
+                        return;
+                }
+            }
+            else
+            {
+                // Push in reverse so that children are visited in order
+                for( size_t ii = count; ii > 0; --ii )
+                {
+                    if( hits[ii - 1] )
+                        stack[top++] = { level - 1, first + ii - 1 };
+                }
+            }
+        }
+    }
+
+    /**
+     * Tests aCount consecutive boxes starting at aFirst against the query box.
+     * @return true if any of them intersects it.
+     */
+    bool testBoxes( size_t aFirst, size_t aCount, const int aMin[NUMDIMS],
+                    const int aMax[NUMDIMS], unsigned char* aHits ) const
+    {
+        for( size_t ii = 0; ii < aCount; ++ii )
+            aHits[ii] = 1;
+
+        for( int dim = 0; dim < NUMDIMS; ++dim )
+        {
+            const int* boxMin = m_min[dim].data() + aFirst;
+            const int* boxMax = m_max[dim].data() + aFirst;
+            const int  queryMin = aMin[dim];
+            const int  queryMax = aMax[dim];
+
+            // Branchless, so that it can be vectorized
+            for( size_t ii = 0; ii < aCount; ++ii )
+                aHits[ii] &= ( boxMin[ii] <= queryMax ) & ( boxMax[ii] >= queryMin );
+        }
+
+        unsigned char any = 0;
+
+        for( size_t ii = 0; ii < aCount; ++ii )
+            any |= aHits[ii];
+
+        return any != 0;
+    }
+
+    /**
+     * Sorts the entries by the centre of dimension aDim, cuts them into slices which will
+     * fill a whole number of leaves and sorts each slice along the next dimension.
+     */
+    static void sortTileRecursive( typename std::vector<ENTRY>::iterator aBegin,
+                                   typename std::vector<ENTRY>::iterator aEnd, int aDim )
+    {
+        const size_t count = aEnd - aBegin;
+
+        if( count <= (size_t) NODESIZE )
+            return;
+
+        std::sort( aBegin, aEnd,
+                   [aDim]( const ENTRY& a, const ENTRY& b )
+                   {
+                       return (int64_t) a.min[aDim] + a.max[aDim]
+                                    < (int64_t) b.min[aDim] + b.max[aDim];
+                   } );
+
+        if( aDim == NUMDIMS - 1 )
+            return;
+
+        const size_t leafCount = ( count + NODESIZE - 1 ) / NODESIZE;
+        const size_t sliceCount = (size_t) std::ceil( std::pow( (double) leafCount,
+                                                                1.0 / ( NUMDIMS - aDim ) ) );
+        const size_t sliceSize = NODESIZE * ( ( leafCount + sliceCount - 1 ) / sliceCount );
+
+        for( size_t start = 0; start < count; start += sliceSize )
+        {
+            sortTileRecursive( aBegin + start, aBegin + std::min( start + sliceSize, count ),
+                               aDim + 1 );
+        }
+    }
+
+    // Box coordinates of all the nodes, leaves first and the root last
+    std::vector<int>                        m_min[NUMDIMS];
+    std::vector<int>                        m_max[NUMDIMS];
+
+    // (first node, node count) of each level, leaves first
+    std::vector<std::pair<size_t, size_t>>  m_levels;
+
+    std::vector<DATATYPE>                   m_data;
+    std::vector<unsigned char>              m_removed;
+    size_t                                  m_liveCount;
+};
+
+#endif // __PACKED_RTREE_H
@@ -928,6 +928,20 @@ class SHAPE_POLY_SET : public SHAPE
         void BooleanIntersection( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
                                   POLYGON_MODE aFastMode );
 
+        /**
+         * Performs boolean polyset union like BooleanAdd(), but splits the bounding box into a
+         * grid of tiles which are computed in parallel, then merges them back together.  Only
+         * worth it for large sets (like a zone fill and its knockouts); small ones are handed
+         * to BooleanAdd() directly.
+         * @param aThreads is the maximum number of threads to use (0 for one per core).
+         */
+        void BooleanAddTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode, int aThreads = 0 );
+
+        ///> Performs boolean polyset difference, tiled and in parallel.
+        ///> See BooleanAddTiled()
+        void BooleanSubtractTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode,
+                                   int aThreads = 0 );
+
         enum CORNER_STRATEGY    ///< define how inflate transform build inflated polygon
         {
             ALLOW_ACUTE_CORNERS,    ///< just inflate the polygon. Acute angles create spikes
@@ -1329,6 +1343,13 @@ class SHAPE_POLY_SET : public SHAPE
         void booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aShape,
                         const SHAPE_POLY_SET& aOtherShape, POLYGON_MODE aFastMode );
 
+        /**
+         * Same as booleanOp( aType, aOtherShape, aFastMode ), split into tiles processed in
+         * parallel.  Only ctUnion and ctDifference are supported.
+         */
+        void booleanOpTiled( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aOtherShape,
+                             POLYGON_MODE aFastMode, int aThreads );
+
         /**
          * containsSingle function
          * Checks whether the point aP is inside the aSubpolyIndex-th polygon of the polyset. If
@@ -28,13 +28,17 @@
 
 #include <algorithm>
 #include <assert.h>                          // for assert
+#include <atomic>
 #include <cmath>                             // for sqrt, cos, hypot, isinf
 #include <cstdio>
+#include <functional>
+#include <future>
 #include <istream>                           // for operator<<, operator>>
 #include <limits>                            // for numeric_limits
 #include <memory>
 #include <set>
 #include <string>                            // for char_traits, operator!=
+#include <thread>
 #include <type_traits>                       // for swap, move
 #include <unordered_set>
 #include <vector>
@@ -533,6 +537,183 @@ void SHAPE_POLY_SET::BooleanIntersection( const SHAPE_POLY_SET& a,
 }
 
 
+void SHAPE_POLY_SET::BooleanAddTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode,
+                                      int aThreads )
+{
+    booleanOpTiled( ctUnion, b, aFastMode, aThreads );
+}
+
+
+void SHAPE_POLY_SET::BooleanSubtractTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode,
+                                           int aThreads )
+{
+    booleanOpTiled( ctDifference, b, aFastMode, aThreads );
+}
+
+
+/**
+ * Runs aWorker on aThreadCount threads (including the calling one) and waits for all of them.
+ */
+static void runOnThreads( size_t aThreadCount, const std::function<void()>& aWorker )
+{
+    std::vector<std::future<void>> returns;
+
+    for( size_t ii = 1; ii < aThreadCount; ++ii )
+        returns.push_back( std::async( std::launch::async, aWorker ) );
+
+    aWorker();
+
+    for( std::future<void>& ret : returns )
+        ret.wait();
+}
+
+
+void SHAPE_POLY_SET::booleanOpTiled( ClipperLib::ClipType aType,
+        const SHAPE_POLY_SET& aOtherShape,
+        POLYGON_MODE aFastMode,
+        int aThreads )
+{
+    assert( aType == ctUnion || aType == ctDifference );
+
+    // Below this, starting threads and merging the tiles costs more than it saves
+    const int minTiledVertices = 20000;
+
+    if( aThreads <= 0 )
+        aThreads = std::max( 1U, std::thread::hardware_concurrency() );
+
+    if( aThreads == 1 || m_polys.empty() || aOtherShape.m_polys.empty()
+            || TotalVertices() + aOtherShape.TotalVertices() < minTiledVertices )
+    {
+        booleanOp( aType, aOtherShape, aFastMode );
+        return;
+    }
+
+    BOX2I bbox = BBox();
+
+    if( aType == ctUnion )
+        bbox.Merge( aOtherShape.BBox() );
+
+    bbox.Inflate( 1 );
+
+    // A few tiles per thread, as their workloads can be very uneven
+    const int tilesPerSide = (int) std::ceil( std::sqrt( 4.0 * aThreads ) );
+    const int cols = tilesPerSide;
+    const int rows = tilesPerSide;
+
+    auto tileEdge =
+            []( int aStart, int aSize, int aIndex, int aCount ) -> int
+            {
+                return aStart + (int) ( (int64_t) aSize * aIndex / aCount );
+            };
+
+    std::vector<BOX2I> tiles;
+
+    for( int row = 0; row < rows; ++row )
+    {
+        int y0 = tileEdge( bbox.GetY(), bbox.GetHeight(), row, rows );
+        int y1 = tileEdge( bbox.GetY(), bbox.GetHeight(), row + 1, rows );
+
+        for( int col = 0; col < cols; ++col )
+        {
+            int x0 = tileEdge( bbox.GetX(), bbox.GetWidth(), col, cols );
+            int x1 = tileEdge( bbox.GetX(), bbox.GetWidth(), col + 1, cols );
+
+            tiles.emplace_back( VECTOR2I( x0, y0 ), VECTOR2I( x1 - x0, y1 - y0 ) );
+        }
+    }
+
+    auto outlineBoxes =
+            []( const SHAPE_POLY_SET& aSet )
+            {
+                std::vector<BOX2I> boxes;
+                boxes.reserve( aSet.m_polys.size() );
+
+                for( const POLYGON& poly : aSet.m_polys )
+                    boxes.push_back( poly[0].BBox() );
+
+                return boxes;
+            };
+
+    const std::vector<BOX2I> boxes = outlineBoxes( *this );
+    const std::vector<BOX2I> otherBoxes = outlineBoxes( aOtherShape );
+
+    std::vector<SHAPE_POLY_SET> pieces( tiles.size() );
+    std::atomic<size_t>         nextTile( 0 );
+
+    // Each tile only sees the polygons which reach it, clipped to the tile's rectangle
+    auto tileWorker =
+            [&]()
+            {
+                for( size_t ii = nextTile++; ii < tiles.size(); ii = nextTile++ )
+                {
+                    const BOX2I&   tileBox = tiles[ii];
+                    SHAPE_POLY_SET tile;
+                    SHAPE_POLY_SET subject;
+                    SHAPE_POLY_SET clip;
+
+                    tile.NewOutline();
+                    tile.Append( tileBox.GetOrigin() );
+                    tile.Append( tileBox.GetRight(), tileBox.GetY() );
+                    tile.Append( tileBox.GetEnd() );
+                    tile.Append( tileBox.GetX(), tileBox.GetBottom() );
+
+                    for( size_t jj = 0; jj < m_polys.size(); ++jj )
+                    {
+                        if( boxes[jj].Intersects( tileBox ) )
+                            subject.m_polys.push_back( m_polys[jj] );
+                    }
+
+                    for( size_t jj = 0; jj < aOtherShape.m_polys.size(); ++jj )
+                    {
+                        if( otherBoxes[jj].Intersects( tileBox ) )
+                            clip.m_polys.push_back( aOtherShape.m_polys[jj] );
+                    }
+
+                    if( aType == ctDifference )
+                    {
+                        if( subject.m_polys.empty() )
+                            continue;
+
+                        subject.booleanOp( ctIntersection, tile, PM_FAST );
+                        pieces[ii].booleanOp( ctDifference, subject, clip, PM_FAST );
+                    }
+                    else
+                    {
+                        subject.booleanOp( ctUnion, clip, PM_FAST );
+                        pieces[ii].booleanOp( ctIntersection, subject, tile, PM_FAST );
+                    }
+                }
+            };
+
+    runOnThreads( std::min<size_t>( aThreads, tiles.size() ), tileWorker );
+
+    // Merge the seams: first each row of tiles, then the rows together
+    std::vector<SHAPE_POLY_SET> strips( rows );
+    std::atomic<size_t>         nextStrip( 0 );
+
+    auto stripWorker =
+            [&]()
+            {
+                for( size_t row = nextStrip++; row < strips.size(); row = nextStrip++ )
+                {
+                    for( int col = 0; col < cols; ++col )
+                        strips[row].Append( pieces[row * cols + col] );
+
+                    strips[row].Simplify( PM_FAST );
+                }
+            };
+
+    runOnThreads( std::min<size_t>( aThreads, strips.size() ), stripWorker );
+
+    RemoveAllContours();
+
+    for( const SHAPE_POLY_SET& strip : strips )
+        Append( strip );
+
+    Simplify( aFastMode );
+}
+
+
 void SHAPE_POLY_SET::InflateWithLinkedHoles( int aFactor, int aCircleSegmentsCount,
                                              POLYGON_MODE aFastMode )
 {
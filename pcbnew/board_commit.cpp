@@ -24,6 +24,7 @@
 
 #include <class_board.h>
 #include <class_module.h>
+#include <class_zone.h>
 #include <pcb_edit_frame.h>
 #include <tool/tool_manager.h>
 #include <tools/selection_tool.h>
@@ -31,7 +32,10 @@
 #include <board_commit.h>
 #include <tools/pcb_tool_base.h>
 #include <tools/pcb_actions.h>
+#include <tools/drc_tool.h>
 #include <connectivity/connectivity_data.h>
+#include <drc/drc_engine.h>
+#include <advanced_config.h>
 
 #include <functional>
 using namespace std::placeholders;
@@ -56,6 +60,19 @@ BOARD_COMMIT::~BOARD_COMMIT()
 {
 }
 
+
+/**
+ * @return true if aItem is a zone of which only the fill has changed (i.e. the zone filler's
+ * own commit), which doesn't invalidate any fill.
+ */
+static bool isZoneRefill( EDA_ITEM* aItem, EDA_ITEM* aCopy )
+{
+    if( !aCopy || aItem->Type() != PCB_ZONE_AREA_T || aCopy->Type() != PCB_ZONE_AREA_T )
+        return false;
+
+    return static_cast<ZONE_CONTAINER*>( aItem )->IsSame( *static_cast<ZONE_CONTAINER*>( aCopy ) );
+}
+
 COMMIT& BOARD_COMMIT::Stage( EDA_ITEM* aItem, CHANGE_TYPE aChangeType )
 {
     // if aItem belongs a footprint, the full footprint will be saved
@@ -89,6 +106,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
     BOARD*              board = (BOARD*) m_toolMgr->GetModel();
     PCB_BASE_FRAME*     frame = (PCB_BASE_FRAME*) m_toolMgr->GetToolHolder();
     auto                connectivity = board->GetConnectivity();
+    std::shared_ptr<DRC_ENGINE> drcEngine;
     std::set<EDA_ITEM*> savedModules;
     SELECTION_TOOL*     selTool = m_toolMgr->GetTool<SELECTION_TOOL>();
     bool                itemsDeselected = false;
@@ -96,12 +114,34 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
     if( Empty() )
         return;
 
+    // The footprint editor's board isn't checked, and its items aren't the edited board's
+    if( !m_editModules )
+        drcEngine = board->GetDesignSettings().m_DRCEngine;
+
     for( COMMIT_LINE& ent : m_changes )
     {
         int changeType = ent.m_type & CHT_TYPE;
         int changeFlags = ent.m_type & CHT_FLAGS;
         BOARD_ITEM* boardItem = static_cast<BOARD_ITEM*>( ent.m_item );
 
+        // Let the DRC engine know what to re-test (in both the old and the new state)
+        if( drcEngine )
+        {
+            drcEngine->MarkItemDirty( boardItem );
+
+            if( ent.m_copy )
+                drcEngine->MarkItemDirty( static_cast<BOARD_ITEM*>( ent.m_copy ) );
+        }
+
+        // Likewise for the zone fills which will need to be updated
+        if( !m_editModules && !isZoneRefill( ent.m_item, ent.m_copy ) )
+        {
+            board->MarkZoneFillsDirty( boardItem );
+
+            if( ent.m_copy )
+                board->MarkZoneFillsDirty( static_cast<BOARD_ITEM*>( ent.m_copy ) );
+        }
+
         // Module items need to be saved in the undo buffer before modification
         if( m_editModules )
         {
@@ -326,6 +366,11 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
 
                 auto boardItem = static_cast<BOARD_ITEM*>( ent.m_item );
 
+                if( drcEngine )
+                    drcEngine->MarkItemDirty( boardItem );
+
+                board->MarkZoneFillsDirty( boardItem );
+
                 if( aCreateUndoEntry )
                 {
                     ITEM_PICKER itemWrapper( nullptr, boardItem, UNDO_REDO::CHANGED );
@@ -339,6 +384,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
                 }
 
                 view->Update( boardItem );
+                board->OnItemChanged( boardItem );
             }
         }
     }
@@ -357,6 +403,12 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
     frame->UpdateMsgPanel();
 
     clear();
+
+    if( !m_editModules && ADVANCED_CFG::GetCfg().m_IncrementalDrc )
+    {
+        if( DRC_TOOL* drcTool = m_toolMgr->GetTool<DRC_TOOL>() )
+            drcTool->ScheduleIncrementalTests();
+    }
 }
 
 
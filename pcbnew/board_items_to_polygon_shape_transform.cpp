@@ -287,6 +287,8 @@ void ZONE_CONTAINER::TransformSolidAreasShapesToPolygon( PCB_LAYER_ID aLayer,
                                                          SHAPE_POLY_SET& aCornerBuffer,
                                                          int aError ) const
 {
+    loadFilledPolys();
+
     if( !m_FilledPolysList.count( aLayer ) || m_FilledPolysList.at( aLayer ).IsEmpty() )
         return;
 
@@ -714,6 +716,8 @@ void ZONE_CONTAINER::TransformShapeWithClearanceToPolygon( SHAPE_POLY_SET& aCorn
 {
     wxASSERT_MSG( !ignoreLineWidth, "IgnoreLineWidth has no meaning for zones." );
 
+    loadFilledPolys();
+
     if( !m_FilledPolysList.count( aLayer ) )
         return;
 
@@ -39,7 +39,9 @@
 #include <class_pcb_target.h>
 #include <core/kicad_algo.h>
 #include <connectivity/connectivity_data.h>
+#include <drc/drc_engine.h>
 #include <kicad_string.h>
+#include <macros.h>
 #include <pgm_base.h>
 #include <pcbnew_settings.h>
 #include <project.h>
@@ -69,6 +71,7 @@ BOARD::BOARD() :
 {
     // we have not loaded a board yet, assume latest until then.
     m_fileFormatVersionAtLoad = LEGACY_BOARD_FILE_VERSION;
+    m_changeLogStart = 0;
 
     for( LAYER_NUM layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
     {
@@ -559,6 +562,11 @@ void BOARD::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode )
     {
     case PCB_NETINFO_T:
         m_NetInfo.AppendNet( (NETINFO_ITEM*) aBoardItem );
+
+        // Rule resolutions are memoized by net code
+        if( m_designSettings->m_DRCEngine )
+            m_designSettings->m_DRCEngine->ClearConstraintCache();
+
         break;
 
     // this one uses a vector
@@ -632,6 +640,11 @@ void BOARD::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode )
     aBoardItem->ClearEditFlags();
     m_connectivity->Add( aBoardItem );
 
+    if( aBoardItem->Type() != PCB_NETINFO_T )
+        CacheItemById( aBoardItem );
+
+    logChange( aBoardItem, true );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardItemAdded, *this, aBoardItem );
 }
 
@@ -647,6 +660,10 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem )
     {
         NETINFO_ITEM* item = (NETINFO_ITEM*) aBoardItem;
         m_NetInfo.RemoveNet( item );
+
+        if( m_designSettings->m_DRCEngine )
+            m_designSettings->m_DRCEngine->ClearConstraintCache();
+
         break;
     }
 
@@ -713,6 +730,11 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem )
 
     m_connectivity->Remove( aBoardItem );
 
+    if( aBoardItem->Type() != PCB_NETINFO_T )
+        UncacheItemById( aBoardItem );
+
+    logChange( aBoardItem, false );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardItemRemoved, *this, aBoardItem );
 }
 
@@ -727,7 +749,10 @@ void BOARD::DeleteMARKERs()
 {
     // the vector does not know how to delete the MARKER_PCB, it holds pointers
     for( MARKER_PCB* marker : m_markers )
+    {
+        UncacheItemById( marker );
         delete marker;
+    }
 
     m_markers.clear();
 }
@@ -743,6 +768,7 @@ void BOARD::DeleteMARKERs( bool aWarningsAndErrors, bool aExclusions )
         if( ( marker->IsExcluded() && aExclusions )
                 || ( !marker->IsExcluded() && aWarningsAndErrors ) )
         {
+            UncacheItemById( marker );
             delete marker;
         }
         else
@@ -760,6 +786,20 @@ BOARD_ITEM* BOARD::GetItem( const KIID& aID ) const
     if( aID == niluuid )
         return nullptr;
 
+    auto cached = m_itemByIdCache.find( aID );
+
+    // Items leave the index when they leave the board (Remove(), MODULE::Remove(), and
+    // UncacheItemById() for the paths which bypass them), and items given a new KIID on the
+    // board are indexed again.  An entry is therefore never stale, and mustn't be checked by
+    // dereferencing it: that is exactly what would break if an item were freed without
+    // being removed.
+    if( cached != m_itemByIdCache.end() )
+    {
+        wxASSERT_MSG( cached->second->m_Uuid == aID, "Stale entry in the board's KIID index" );
+        return cached->second;
+    }
+
+    // Not indexed; fall back to searching the whole board
     for( TRACK* track : Tracks() )
     {
         if( track->m_Uuid == aID )
@@ -834,39 +874,55 @@ BOARD_ITEM* BOARD::GetItem( const KIID& aID ) const
 }
 
 
-void BOARD::FillItemMap( std::map<KIID, EDA_ITEM*>& aMap )
+void BOARD::CacheItemById( BOARD_ITEM* aItem )
 {
-    // the board itself
-    aMap[ this->m_Uuid ] = this;
-
-    for( TRACK* track : Tracks() )
-        aMap[ track->m_Uuid ] = track;
+    m_itemByIdCache[ aItem->m_Uuid ] = aItem;
 
-    for( MODULE* footprint : Modules() )
+    if( aItem->Type() == PCB_MODULE_T )
     {
-        aMap[ footprint->m_Uuid ] = footprint;
+        static_cast<MODULE*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    m_itemByIdCache[ aChild->m_Uuid ] = aChild;
+                } );
+    }
+}
 
-        for( D_PAD* pad : footprint->Pads() )
-            aMap[ pad->m_Uuid ] = pad;
 
-        aMap[ footprint->Reference().m_Uuid ] = &footprint->Reference();
-        aMap[ footprint->Value().m_Uuid ] = &footprint->Value();
+void BOARD::UncacheItemById( const BOARD_ITEM* aItem )
+{
+    auto uncache =
+            [&]( const BOARD_ITEM* aEntry )
+            {
+                auto it = m_itemByIdCache.find( aEntry->m_Uuid );
 
-        for( BOARD_ITEM* drawing : footprint->GraphicalItems() )
-            aMap[ drawing->m_Uuid ] = drawing;
-    }
+                // Another item with the same KIID may have taken over the entry
+                if( it != m_itemByIdCache.end() && it->second == aEntry )
+                    m_itemByIdCache.erase( it );
+            };
 
-    for( ZONE_CONTAINER* zone : Zones() )
-        aMap[ zone->m_Uuid ] = zone;
+    uncache( aItem );
 
-    for( BOARD_ITEM* drawing : Drawings() )
-        aMap[ drawing->m_Uuid ] = drawing;
+    if( aItem->Type() == PCB_MODULE_T )
+        static_cast<const MODULE*>( aItem )->RunOnChildren( uncache );
+}
 
-    for( MARKER_PCB* marker : m_markers )
-        aMap[ marker->m_Uuid ] = marker;
 
-    for( PCB_GROUP* group : m_groups )
-        aMap[ group->m_Uuid ] = group;
+bool BOARD::IsCachedById( const BOARD_ITEM* aItem ) const
+{
+    auto it = m_itemByIdCache.find( aItem->m_Uuid );
+
+    return it != m_itemByIdCache.end() && it->second == aItem;
+}
+
+
+void BOARD::FillItemMap( std::map<KIID, EDA_ITEM*>& aMap )
+{
+    // the board itself
+    aMap[ this->m_Uuid ] = this;
+
+    for( const std::pair<const KIID, BOARD_ITEM*>& entry : m_itemByIdCache )
+        aMap[ entry.first ] = entry.second;
 }
 
 
@@ -1403,6 +1459,10 @@ void BOARD::SynchronizeNetsAndNetClasses()
     bds.SetCustomDiffPairGap( defaultNetClass->GetDiffPairGap() );
     bds.SetCustomDiffPairViaGap( defaultNetClass->GetDiffPairViaGap() );
 
+    // Netclass assignments are baked into the DRC engine's memoized rule resolutions
+    if( bds.m_DRCEngine )
+        bds.m_DRCEngine->ClearConstraintCache();
+
     InvokeListeners( &BOARD_LISTENER::OnBoardNetSettingsChanged, *this );
 }
 
@@ -1618,6 +1678,9 @@ void BOARD::PadDelete( D_PAD* aPad )
 
     InvokeListeners( &BOARD_LISTENER::OnBoardItemRemoved, *this, aPad );
 
+    // Logged as a change of the footprint
+    logChange( aPad, true );
+
     aPad->DeleteStructure();
 }
 
@@ -1749,6 +1812,90 @@ std::list<ZONE_CONTAINER*> BOARD::GetZoneList( bool aIncludeZonesInFootprints )
 }
 
 
+void BOARD::MarkZoneFillsDirty( BOARD_ITEM* aItem )
+{
+    // Beyond this many changes it's cheaper to just refill the whole zone
+    const size_t maxDirtyAreas = 1000;
+
+    // Markers are not part of the fill; nets and groups have no geometry of their own
+    if( !aItem || aItem->Type() == PCB_MARKER_T || aItem->Type() == PCB_NETINFO_T
+            || aItem->Type() == PCB_GROUP_T )
+    {
+        return;
+    }
+
+    LSET layers = aItem->GetLayerSet();
+    bool outlineChanged = layers.test( Edge_Cuts );
+
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+        static_cast<MODULE*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    outlineChanged |= aChild->IsOnLayer( Edge_Cuts );
+                } );
+
+        KI_FALLTHROUGH;
+
+    case PCB_PAD_T:
+    case PCB_VIA_T:
+        // Holes are knocked out of every copper layer
+        layers |= LSET::AllCuMask();
+        break;
+
+    case PCB_ZONE_AREA_T:
+        // The zone's own outline or settings have changed
+        static_cast<ZONE_CONTAINER*>( aItem )->SetNeedRefill( true );
+        break;
+
+    default:
+        break;
+    }
+
+    layers &= LSET::AllCuMask();
+
+    if( !outlineChanged && layers.none() )
+        return;
+
+    EDA_RECT area = aItem->GetBoundingBox();
+
+    for( ZONE_CONTAINER* zone : m_zones )
+    {
+        if( zone == aItem || zone->GetIsRuleArea() || zone->NeedRefill() )
+            continue;
+
+        if( outlineChanged || zone->GetFillDirtyAreas().size() >= maxDirtyAreas )
+        {
+            zone->SetNeedRefill( true );
+            zone->ClearFillDirtyAreas();
+        }
+        else if( ( zone->GetLayerSet() & layers ).any() )
+        {
+            zone->AddFillDirtyArea( area );
+        }
+    }
+}
+
+
+void BOARD::OnUntrackedChanges()
+{
+    // Nothing tells which parts of the zone fills are out of date
+    for( ZONE_CONTAINER* zone : m_zones )
+    {
+        zone->SetNeedRefill( true );
+        zone->ClearFillDirtyAreas();
+    }
+
+    // Nor which DRC markers
+    if( m_designSettings->m_DRCEngine )
+        m_designSettings->m_DRCEngine->DiscardBaseline();
+
+    // Nor which items the caches following the change log have to update
+    ResetChangeLog();
+}
+
+
 ZONE_CONTAINER* BOARD::AddArea( PICKED_ITEMS_LIST* aNewZonesList, int aNetcode, PCB_LAYER_ID aLayer,
                                 wxPoint aStartPointPosition, ZONE_BORDER_DISPLAY_STYLE aHatch )
 {
@@ -1951,10 +2098,55 @@ void BOARD::RemoveListener( BOARD_LISTENER* aListener )
 
 void BOARD::OnItemChanged( BOARD_ITEM* aItem )
 {
+    logChange( aItem, true );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardItemChanged, *this, aItem );
 }
 
 
+void BOARD::logChange( BOARD_ITEM* aItem, bool aOnBoard )
+{
+    // Keep the log bounded; whoever falls behind that far just rebuilds from scratch
+    static const size_t maxChangeLogSize = 65536;
+
+    // Markers and nets have no geometry of their own
+    if( aItem->Type() == PCB_MARKER_T || aItem->Type() == PCB_NETINFO_T )
+        return;
+
+    if( aItem->GetParent() && aItem->GetParent()->Type() == PCB_MODULE_T )
+    {
+        aItem = aItem->GetParent();
+        aOnBoard = true;
+    }
+
+    m_changeLog.push_back( { aItem, aOnBoard } );
+
+    if( m_changeLog.size() > maxChangeLogSize )
+    {
+        m_changeLog.pop_front();
+        m_changeLogStart++;
+    }
+}
+
+
+bool BOARD::GetChangesSince( uint64_t aSerial, std::vector<BOARD_ITEM_CHANGE>& aChanges ) const
+{
+    if( aSerial < m_changeLogStart || aSerial > GetChangeLogSerial() )
+        return false;
+
+    aChanges.insert( aChanges.end(), m_changeLog.begin() + ( aSerial - m_changeLogStart ),
+                     m_changeLog.end() );
+    return true;
+}
+
+
+void BOARD::ResetChangeLog()
+{
+    m_changeLogStart = GetChangeLogSerial() + 1;
+    m_changeLog.clear();
+}
+
+
 void BOARD::ResetNetHighLight()
 {
     m_highLight.Clear();
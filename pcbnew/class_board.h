@@ -36,6 +36,9 @@
 #include <title_block.h>
 #include <tools/pcbnew_selection.h>
 
+#include <deque>
+#include <unordered_map>
+
 class BOARD_COMMIT;
 class PCB_BASE_FRAME;
 class PCB_EDIT_FRAME;
@@ -164,6 +167,18 @@ public:
 };
 
 
+/**
+ * An entry of the board's change log (see BOARD::GetChangesSince()).  Footprint children are
+ * logged as their footprint.  m_item must not be dereferenced when m_onBoard is false: the
+ * item may have been deleted since.
+ */
+struct BOARD_ITEM_CHANGE
+{
+    BOARD_ITEM* m_item;
+    bool        m_onBoard;      ///< false if the item was removed from the board
+};
+
+
 DECL_VEC_FOR_SWIG( MARKERS, MARKER_PCB* )
 DECL_VEC_FOR_SWIG( ZONE_CONTAINERS, ZONE_CONTAINER* )
 DECL_DEQ_FOR_SWIG( TRACKS, TRACK* )
@@ -231,12 +246,23 @@ private:
 
     std::vector<BOARD_LISTENER*> m_listeners;
 
+    /// KIID index of the items (including footprint children) for GetItem().  Items leave it
+    /// when they leave the board, so entries are trusted without being dereferenced.
+    std::unordered_map<KIID, BOARD_ITEM*> m_itemByIdCache;
+
+    /// Items added, removed or changed, for the caches which patch themselves rather than
+    /// rebuild from scratch.  m_changeLogStart is the serial of the first entry.
+    std::deque<BOARD_ITEM_CHANGE> m_changeLog;
+    uint64_t                      m_changeLogStart;
+
     // The default copy constructor & operator= are inadequate,
     // either write one or do not use it at all
     BOARD( const BOARD& aOther ) = delete;
 
     BOARD& operator=( const BOARD& aOther ) = delete;
 
+    void logChange( BOARD_ITEM* aItem, bool aOnBoard );
+
     template <typename Func, typename... Args>
     void InvokeListeners( Func&& aFunc, Args&&... args )
     {
@@ -355,7 +381,11 @@ public:
     void DeleteAllModules()
     {
         for( MODULE* mod : m_modules )
+        {
+            UncacheItemById( mod );
+            logChange( mod, false );
             delete mod;
+        }
 
         m_modules.clear();
     }
@@ -366,8 +396,46 @@ public:
      */
     BOARD_ITEM* GetItem( const KIID& aID ) const;
 
+    /**
+     * Adds aItem (and the children of a footprint) to the KIID index used by GetItem().
+     * Add() already does this; only needed when the KIID of an item on the board changes or
+     * when a footprint on the board gets new children by other means than MODULE::Add().
+     */
+    void CacheItemById( BOARD_ITEM* aItem );
+
+    /**
+     * Removes aItem (and the children of a footprint) from the KIID index.  Must be called
+     * before deleting an item which didn't go through Remove().
+     */
+    void UncacheItemById( const BOARD_ITEM* aItem );
+
+    /**
+     * @return true if aItem itself is in the KIID index (not one of its copies).
+     */
+    bool IsCachedById( const BOARD_ITEM* aItem ) const;
+
     void FillItemMap( std::map<KIID, EDA_ITEM*>& aMap );
 
+    /**
+     * @return the serial of the next change log entry.  Store it to later get the changes made
+     * since with GetChangesSince().
+     */
+    uint64_t GetChangeLogSerial() const { return m_changeLogStart + m_changeLog.size(); }
+
+    /**
+     * Get the items added, removed or changed since aSerial, oldest first.  An item may appear
+     * several times.
+     * @return false if the log doesn't go back as far (or was reset since), in which case the
+     * caller has to rebuild its state from the whole board.
+     */
+    bool GetChangesSince( uint64_t aSerial, std::vector<BOARD_ITEM_CHANGE>& aChanges ) const;
+
+    /**
+     * Invalidate all the serials handed out so far.  Must be called when items are added to or
+     * removed from the board other than through Add() and Remove().
+     */
+    void ResetChangeLog();
+
     /**
      * Convert cross-references back and forth between ${refDes:field} and ${kiid:field}
      */
@@ -900,6 +968,24 @@ public:
         return static_cast<int>( m_zones.size() );
     }
 
+    /**
+     * Record that aItem has changed so that only the parts of the zone fills near it have to
+     * be recomputed (see ZONE_CONTAINER::AddFillDirtyArea()).  Call it for both the old and the
+     * new state of a modified item.  Zones which can't be partially refilled (e.g.\ because the
+     * board outline changed) are flagged as needing a full refill instead.
+     */
+    void MarkZoneFillsDirty( BOARD_ITEM* aItem );
+
+    /**
+     * Must be called after the board has been edited other than through BOARD_COMMIT or the
+     * undo and redo commands (e.g.\ by an action plugin or from the scripting console), which
+     * is to say without MarkZoneFillsDirty() having been called for the changed items.  All
+     * the zones are then refilled entirely the next time, and the DRC markers are left to the
+     * next full DRC run.  The change log is reset (see ResetChangeLog()), as property changes
+     * such as those made by scripts aren't logged.
+     */
+    void OnUntrackedChanges();
+
     /* Functions used in test, merge and cut outlines */
 
     /**
@@ -202,6 +202,13 @@ MODULE::~MODULE()
 
 MODULE& MODULE::operator=( MODULE&& aOther )
 {
+    // The children are replaced: drop the old ones from the board's KIID index
+    BOARD* board = GetBoard();
+    bool   cached = board && board->IsCachedById( this );
+
+    if( cached )
+        board->UncacheItemById( this );
+
     BOARD_ITEM::operator=( aOther );
 
     m_Pos           = aOther.m_Pos;
@@ -291,12 +298,22 @@ MODULE& MODULE::operator=( MODULE&& aOther )
     aOther.m_Reference        = nullptr;
     aOther.m_initial_comments = nullptr;
 
+    if( cached )
+        board->CacheItemById( this );
+
     return *this;
 }
 
 
 MODULE& MODULE::operator=( const MODULE& aOther )
 {
+    // The children are replaced: drop the old ones from the board's KIID index
+    BOARD* board = GetBoard();
+    bool   cached = board && board->IsCachedById( this );
+
+    if( cached )
+        board->UncacheItemById( this );
+
     BOARD_ITEM::operator=( aOther );
 
     m_Pos           = aOther.m_Pos;
@@ -390,6 +407,9 @@ MODULE& MODULE::operator=( const MODULE& aOther )
     m_initial_comments = aOther.m_initial_comments ?
                             new wxArrayString( *aOther.m_initial_comments ) : nullptr;
 
+    if( cached )
+        board->CacheItemById( this );
+
     return *this;
 }
 
@@ -488,6 +508,12 @@ void MODULE::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode )
 
     aBoardItem->ClearEditFlags();
     aBoardItem->SetParent( this );
+
+    // Only the footprints on the board are indexed, not their copies (undo images, etc.)
+    BOARD* board = GetBoard();
+
+    if( board && board->IsCachedById( this ) )
+        board->CacheItemById( aBoardItem );
 }
 
 
@@ -558,6 +584,9 @@ void MODULE::Remove( BOARD_ITEM* aBoardItem )
         wxFAIL_MSG( msg );
     }
     }
+
+    if( BOARD* board = GetBoard() )
+        board->UncacheItemById( aBoardItem );
 }
 
 
@@ -1746,7 +1775,17 @@ void MODULE::SwapData( BOARD_ITEM* aImage )
 {
     assert( aImage->Type() == PCB_MODULE_T );
 
+    // The children are swapped too, so they have to be re-indexed by the board
+    BOARD* board = GetBoard();
+    bool   cached = board && board->IsCachedById( this );
+
+    if( cached )
+        board->UncacheItemById( this );
+
     std::swap( *((MODULE*) this), *((MODULE*) aImage) );
+
+    if( cached )
+        board->CacheItemById( this );
 }
 
 
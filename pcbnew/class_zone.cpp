@@ -68,6 +68,7 @@ ZONE_CONTAINER::ZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent, bool aInFP )
     SetLocalFlags( 0 );                 // flags tempoarry used in zone calculations
     m_Poly = new SHAPE_POLY_SET();      // Outlines
     m_fillVersion = 5;                  // set the "old" way to build filled polygon areas (< 6.0.x)
+    m_fillSettingsHash = 0;
     m_islandRemovalMode = ISLAND_REMOVAL_MODE::ALWAYS;
     aParent->GetZoneSettings().ExportSetting( *this );
 
@@ -132,11 +133,13 @@ void ZONE_CONTAINER::InitDataFromSrcInCopyCtor( const ZONE_CONTAINER& aZone )
     m_ZoneClearance           = aZone.m_ZoneClearance;     // clearance value
     m_ZoneMinThickness        = aZone.m_ZoneMinThickness;
     m_fillVersion             = aZone.m_fillVersion;
+    m_fillSettingsHash        = aZone.m_fillSettingsHash;
     m_islandRemovalMode       = aZone.m_islandRemovalMode;
     m_minIslandArea           = aZone.m_minIslandArea;
 
     m_isFilled                = aZone.m_isFilled;
     m_needRefill              = aZone.m_needRefill;
+    m_fillDirtyAreas          = aZone.m_fillDirtyAreas;
 
     m_thermalReliefGap        = aZone.m_thermalReliefGap;
     m_thermalReliefSpokeWidth = aZone.m_thermalReliefSpokeWidth;
@@ -154,6 +157,10 @@ void ZONE_CONTAINER::InitDataFromSrcInCopyCtor( const ZONE_CONTAINER& aZone )
     delete m_CornerSelection;
     m_CornerSelection         = nullptr;
 
+    // Fills still to be loaded must be loaded before they are replaced or copied
+    loadFilledPolys();
+    aZone.loadFilledPolys();
+
     for( PCB_LAYER_ID layer : aZone.GetLayerSet().Seq() )
     {
         m_FilledPolysList[layer]  = aZone.m_FilledPolysList.at( layer );
@@ -186,6 +193,8 @@ bool ZONE_CONTAINER::UnFill()
 {
     bool change = false;
 
+    loadFilledPolys();
+
     for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
     {
         change |= !pair.second.IsEmpty();
@@ -486,6 +495,8 @@ bool ZONE_CONTAINER::HitTestFilledArea( PCB_LAYER_ID aLayer, const wxPoint &aRef
     if( GetIsRuleArea() )
         return m_Poly->Contains( VECTOR2I( aRefPos.x, aRefPos.y ), -1, aAccuracy );
 
+    loadFilledPolys();
+
     if( !m_FilledPolysList.count( aLayer ) )
         return false;
 
@@ -647,6 +658,8 @@ void ZONE_CONTAINER::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_PA
 
     if( !GetIsRuleArea() )
     {
+        loadFilledPolys();
+
         auto layer_it = m_FilledPolysList.find( layer );
 
         if( layer_it == m_FilledPolysList.end() )
@@ -670,6 +683,8 @@ void ZONE_CONTAINER::Move( const wxPoint& offset )
 
     HatchBorder();
 
+    loadFilledPolys();
+
     for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
         pair.second.Move( offset );
 
@@ -707,6 +722,8 @@ void ZONE_CONTAINER::Rotate( const wxPoint& aCentre, double aAngle )
     HatchBorder();
 
     /* rotate filled areas: */
+    loadFilledPolys();
+
     for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
         pair.second.Rotate( aAngle, VECTOR2I( aCentre ) );
 
@@ -744,6 +761,8 @@ void ZONE_CONTAINER::Mirror( const wxPoint& aMirrorRef, bool aMirrorLeftRight )
 
     HatchBorder();
 
+    loadFilledPolys();
+
     for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
         pair.second.Mirror( aMirrorLeftRight, !aMirrorLeftRight, VECTOR2I( aMirrorRef ) );
 
@@ -1105,6 +1124,8 @@ void ZONE_CONTAINER::SwapData( BOARD_ITEM* aImage )
 
 void ZONE_CONTAINER::CacheTriangulation( PCB_LAYER_ID aLayer )
 {
+    loadFilledPolys();
+
     if( aLayer == UNDEFINED_LAYER )
     {
         for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
@@ -1236,29 +1257,78 @@ bool ZONE_CONTAINER::BuildSmoothedPoly( SHAPE_POLY_SET& aSmoothedPoly, PCB_LAYER
 }
 
 
-double ZONE_CONTAINER::CalculateFilledArea()
+static double filledPolysArea( const std::map<PCB_LAYER_ID, SHAPE_POLY_SET>& aFilledPolys )
 {
-    m_area = 0.0;
+    double area = 0.0;
 
     // Iterate over each outline polygon in the zone and then iterate over
     // each hole it has to compute the total area.
-    for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
+    for( const std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : aFilledPolys )
     {
-        SHAPE_POLY_SET& poly = pair.second;
+        const SHAPE_POLY_SET& poly = pair.second;
 
         for( int i = 0; i < poly.OutlineCount(); i++ )
         {
-            m_area += poly.Outline( i ).Area();
+            area += poly.COutline( i ).Area();
 
             for( int j = 0; j < poly.HoleCount( i ); j++ )
-                m_area -= poly.Hole( i, j ).Area();
+                area -= poly.CHole( i, j ).Area();
         }
     }
 
+    return area;
+}
+
+
+double ZONE_CONTAINER::CalculateFilledArea()
+{
+    loadFilledPolys();
+
+    m_area = filledPolysArea( m_FilledPolysList );
+
     return m_area;
 }
 
 
+void ZONE_CONTAINER::SetFilledPolysLoader( FILLED_POLYS_LOADER aLoader )
+{
+    std::lock_guard<std::mutex> lock( m_filledPolysLoaderLock );
+
+    m_filledPolysLoader = std::move( aLoader );
+    m_hasFilledPolysLoader.store( true, std::memory_order_release );
+}
+
+
+void ZONE_CONTAINER::loadFilledPolys() const
+{
+    if( !m_hasFilledPolysLoader.load( std::memory_order_acquire ) )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_filledPolysLoaderLock );
+
+    // Another thread may have loaded them while this one waited for the lock
+    if( !m_filledPolysLoader )
+        return;
+
+    if( !m_filledPolysLoader( m_FilledPolysList ) )
+    {
+        // Rather than have the next save drop the fill without notice, ask for a refill
+        for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
+            pair.second.RemoveAllContours();
+
+        m_isFilled = false;
+        m_needRefill = true;
+    }
+
+    m_filledPolysLoader = nullptr;
+
+    // As it would have been when the filled polygons were set
+    m_area = filledPolysArea( m_FilledPolysList );
+
+    m_hasFilledPolysLoader.store( false, std::memory_order_release );
+}
+
+
 /**
  * Function TransformSmoothedOutlineToPolygon
  * Convert the smoothed outline to polygons (optionally inflated by \a aClearance) and copy them
@@ -1351,6 +1421,8 @@ std::shared_ptr<SHAPE> ZONE_CONTAINER::GetEffectiveShape( PCB_LAYER_ID aLayer )
 {
     std::shared_ptr<SHAPE> shape;
 
+    loadFilledPolys();
+
     if( m_FilledPolysList.find( aLayer ) == m_FilledPolysList.end() )
     {
         shape = std::make_shared<SHAPE_NULL>();
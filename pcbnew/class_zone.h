@@ -30,6 +30,8 @@
 #define CLASS_ZONE_H_
 
 
+#include <atomic>
+#include <functional>
 #include <mutex>
 #include <vector>
 #include <gr_basic.h>
@@ -49,6 +51,9 @@ class MSG_PANEL_ITEM;
 
 typedef std::vector<SEG> ZONE_SEGMENT_FILL;
 
+/// Gives the filled polygons of a zone, for each of its layers; false if they can't be read
+typedef std::function<bool( std::map<PCB_LAYER_ID, SHAPE_POLY_SET>& )> FILLED_POLYS_LOADER;
+
 /**
  * ZONE_CONTAINER
  * handles a list of polygons defining a copper zone.
@@ -197,6 +202,7 @@ public:
      */
     double GetFilledArea()
     {
+        loadFilledPolys();
         return m_area;
     }
 
@@ -211,12 +217,39 @@ public:
     }
     void SetFillFlag( PCB_LAYER_ID aLayer, bool aFlag ) { m_fillFlags[ aLayer ] = aFlag; }
 
-    bool IsFilled() const { return m_isFilled; }
+    /**
+     * These two give the filled polygons from the loader (see SetFilledPolysLoader()) first,
+     * as a fill which can't be read leaves the zone unfilled and in need of a refill.
+     */
+    bool IsFilled() const
+    {
+        loadFilledPolys();
+        return m_isFilled;
+    }
+
     void SetIsFilled( bool isFilled ) { m_isFilled = isFilled; }
 
-    bool NeedRefill() const { return m_needRefill; }
+    bool NeedRefill() const
+    {
+        loadFilledPolys();
+        return m_needRefill;
+    }
+
     void SetNeedRefill( bool aNeedRefill ) { m_needRefill = aNeedRefill; }
 
+    /**
+     * Records that the fill may be out of date in (and near) aArea, because some item there has
+     * changed since the zone was filled.  ZONE_FILLER then only needs to recompute that part.
+     */
+    void AddFillDirtyArea( const EDA_RECT& aArea ) { m_fillDirtyAreas.push_back( aArea ); }
+    const std::vector<EDA_RECT>& GetFillDirtyAreas() const { return m_fillDirtyAreas; }
+    void ClearFillDirtyAreas() { m_fillDirtyAreas.clear(); }
+
+    bool HasRawPolysForLayer( PCB_LAYER_ID aLayer ) const
+    {
+        return m_RawPolysList.count( aLayer ) > 0;
+    }
+
     ZONE_CONNECTION GetPadConnection( D_PAD* aPad, wxString* aSource = nullptr ) const;
     ZONE_CONNECTION GetPadConnection() const { return m_PadConnection; }
     void SetPadConnection( ZONE_CONNECTION aPadConnection ) { m_PadConnection = aPadConnection; }
@@ -609,6 +642,8 @@ public:
      */
     void ClearFilledPolysList()
     {
+        loadFilledPolys();
+
         for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
         {
             m_insulatedIslands[pair.first].clear();
@@ -618,6 +653,7 @@ public:
 
     bool HasFilledPolysForLayer( PCB_LAYER_ID aLayer ) const
     {
+        loadFilledPolys();
         return m_FilledPolysList.count( aLayer ) > 0;
     }
 
@@ -628,6 +664,7 @@ public:
      */
     const SHAPE_POLY_SET& GetFilledPolysList( PCB_LAYER_ID aLayer ) const
     {
+        loadFilledPolys();
         wxASSERT( m_FilledPolysList.count( aLayer ) );
         return m_FilledPolysList.at( aLayer );
     }
@@ -643,9 +680,18 @@ public:
      */
     void SetFilledPolysList( PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aPolysList )
     {
+        loadFilledPolys();
         m_FilledPolysList[aLayer] = aPolysList;
     }
 
+    /**
+     * Function SetFilledPolysLoader
+     * sets a function to give the filled polygons of all layers the first time they are
+     * needed, in place of SetFilledPolysList().  Filled polygons are most of a board file,
+     * so they can be left unparsed when a board is loaded until something uses them.
+     */
+    void SetFilledPolysLoader( FILLED_POLYS_LOADER aLoader );
+
     /**
       * Function SetFilledPolysList
       * sets the list of filled polygons.
@@ -688,6 +734,13 @@ public:
     int GetFillVersion() const { return m_fillVersion; }
     void SetFillVersion( int aVersion ) { m_fillVersion = aVersion; }
 
+    /**
+     * The hash of the rules and design settings the zone was last filled with (see
+     * ZONE_FILLER).  The fill can only be patched, rather than refilled, while it's the same.
+     */
+    size_t GetFillSettingsHash() const { return m_fillSettingsHash; }
+    void SetFillSettingsHash( size_t aHash ) { m_fillSettingsHash = aHash; }
+
     /**
      * Remove a cutout from the zone.
      *
@@ -815,6 +868,8 @@ public:
      */
     void BuildHashValue( PCB_LAYER_ID aLayer )
     {
+        loadFilledPolys();
+
         if( !m_FilledPolysList.count( aLayer ) )
             return;
 
@@ -830,6 +885,12 @@ public:
     virtual void SwapData( BOARD_ITEM* aImage ) override;
 
 protected:
+    /**
+     * Gives the filled polygons from the function set by SetFilledPolysLoader(), if it was not
+     * called yet.  Safe to call from several threads at once.
+     */
+    void loadFilledPolys() const;
+
     SHAPE_POLY_SET*       m_Poly;                ///< Outline of the zone.
     int                   m_cornerSmoothingType;
     unsigned int          m_cornerRadius;
@@ -864,6 +925,7 @@ protected:
     int                   m_ZoneMinThickness;        // Minimum thickness value in filled areas.
     int                   m_fillVersion;             // See BOARD_DESIGN_SETTINGS for version
                                                      // differences.
+    size_t                m_fillSettingsHash;        // Not saved: 0 until filled.
     ISLAND_REMOVAL_MODE   m_islandRemovalMode;
 
     /**
@@ -873,13 +935,16 @@ protected:
     long long int    m_minIslandArea;
 
     /** True when a zone was filled, false after deleting the filled areas. */
-    bool             m_isFilled;
+    mutable bool     m_isFilled;        // mutable: cleared by loadFilledPolys() on failure
 
     /** False when a zone was refilled, true after changes in zone params.
      * m_needRefill = false does not imply filled areas are up to date, just
      * the zone was refilled after edition, and does not need refilling
      */
-    bool             m_needRefill;
+    mutable bool     m_needRefill;      // mutable: set by loadFilledPolys() on failure
+
+    /// Areas changed since the last fill, see AddFillDirtyArea()
+    std::vector<EDA_RECT> m_fillDirtyAreas;
 
     int              m_thermalReliefGap;        // Width of the gap in thermal reliefs.
     int              m_thermalReliefSpokeWidth; // Width of the copper bridge in thermal reliefs.
@@ -919,8 +984,9 @@ protected:
      * a polygon equivalent to m_Poly, without holes but with extra outline segment
      * connecting "holes" with external main outline.  In complex cases an outline
      * described by m_Poly can have many filled areas
+     * Mutable to be set from the loader the first time it is read.
      */
-    std::map<PCB_LAYER_ID, SHAPE_POLY_SET> m_FilledPolysList;
+    mutable std::map<PCB_LAYER_ID, SHAPE_POLY_SET> m_FilledPolysList;
     std::map<PCB_LAYER_ID, SHAPE_POLY_SET> m_RawPolysList;
 
     /// Temp variables used while filling
@@ -939,10 +1005,15 @@ protected:
 
     bool                  m_hv45;           // constrain edges to horizontal, vertical or 45º
 
-    double                m_area;           // The filled zone area
+    mutable double        m_area;           // The filled zone area, set with m_FilledPolysList
 
     /// Lock used for multi-threaded filling on multi-layer zones
     std::mutex m_lock;
+
+    /// Gives m_FilledPolysList when it is first needed, see SetFilledPolysLoader()
+    mutable FILLED_POLYS_LOADER m_filledPolysLoader;
+    mutable std::atomic<bool>   m_hasFilledPolysLoader{ false };
+    mutable std::mutex          m_filledPolysLoaderLock;
 };
 
 
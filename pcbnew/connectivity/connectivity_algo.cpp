@@ -34,9 +34,7 @@
 #include <algorithm>
 #include <future>
 
-#ifdef PROFILE
 #include <profile.h>
-#endif
 
 
 bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
@@ -48,6 +46,7 @@ bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
     case PCB_MODULE_T:
         for( auto pad : static_cast<MODULE*>( aItem ) -> Pads() )
         {
+            markConnectedNetsAsDirty( m_itemMap[pad] );
             m_itemMap[pad].MarkItemsAsInvalid();
             m_itemMap.erase( pad );
         }
@@ -56,6 +55,7 @@ bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
         break;
 
     case PCB_PAD_T:
+        markConnectedNetsAsDirty( m_itemMap[aItem] );
         m_itemMap[aItem].MarkItemsAsInvalid();
         m_itemMap.erase( aItem );
         m_itemList.SetDirty( true );
@@ -63,12 +63,14 @@ bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
 
     case PCB_TRACE_T:
     case PCB_ARC_T:
+        markConnectedNetsAsDirty( m_itemMap[aItem] );
         m_itemMap[aItem].MarkItemsAsInvalid();
         m_itemMap.erase( aItem );
         m_itemList.SetDirty( true );
         break;
 
     case PCB_VIA_T:
+        markConnectedNetsAsDirty( m_itemMap[aItem] );
         m_itemMap[aItem].MarkItemsAsInvalid();
         m_itemMap.erase( aItem );
         m_itemList.SetDirty( true );
@@ -76,6 +78,7 @@ bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
 
     case PCB_ZONE_AREA_T:
     {
+        markConnectedNetsAsDirty( m_itemMap[aItem] );
         m_itemMap[aItem].MarkItemsAsInvalid();
         m_itemMap.erase ( aItem );
         m_itemList.SetDirty( true );
@@ -113,6 +116,19 @@ void CN_CONNECTIVITY_ALGO::markItemNetAsDirty( const BOARD_ITEM* aItem )
 }
 
 
+void CN_CONNECTIVITY_ALGO::markConnectedNetsAsDirty( const ITEM_MAP_ENTRY& aEntry )
+{
+    // Removing an item can split the clusters it was part of, and the pieces are not
+    // necessarily on the item's own net (conflicting or not yet propagated clusters).  The
+    // cluster searches only revisit dirty nets, so flag the nets of the neighbours too.
+    for( CN_ITEM* item : aEntry.m_items )
+    {
+        for( CN_ITEM* connected : item->ConnectedItems() )
+            MarkNetAsDirty( connected->Net() );
+    }
+}
+
+
 bool CN_CONNECTIVITY_ALGO::Add( BOARD_ITEM* aItem )
 {
     if( !aItem->IsOnCopperLayer() )
@@ -211,6 +227,8 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
     for( auto item : garbage )
         delete item;
 
+    m_itemList.PackIndex();
+
 #ifdef PROFILE
     garbage_collection.Show();
     PROF_COUNTER search_basic( "search-basic" );
@@ -239,13 +257,19 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
         std::atomic<size_t> nextItem( 0 );
         std::vector<std::future<size_t>> returns( parallelThreadCount );
 
+        // Each thread collects the connections it finds on its own, so that the items don't
+        // need locking.  They are linked once the search is over.
+        std::vector<CN_VISITOR::CONNECTIONS> connections( std::max<size_t>( 1,
+                                                                            parallelThreadCount ) );
+
         auto conn_lambda =
                 [&nextItem, &dirtyItems]( CN_LIST* aItemList,
+                                          CN_VISITOR::CONNECTIONS* aConnections,
                                           PROGRESS_REPORTER* aReporter) -> size_t
                 {
                     for( size_t i = nextItem++; i < dirtyItems.size(); i = nextItem++ )
                     {
-                        CN_VISITOR visitor( dirtyItems[i] );
+                        CN_VISITOR visitor( dirtyItems[i], aConnections );
                         aItemList->FindNearby( dirtyItems[i], visitor );
 
                         if( aReporter )
@@ -261,13 +285,13 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
                 };
 
         if( parallelThreadCount <= 1 )
-            conn_lambda( &m_itemList, m_progressReporter );
+            conn_lambda( &m_itemList, &connections[0], m_progressReporter );
         else
         {
             for( size_t ii = 0; ii < parallelThreadCount; ++ii )
             {
                 returns[ii] = std::async( std::launch::async, conn_lambda, &m_itemList,
-                                          m_progressReporter );
+                                          &connections[ii], m_progressReporter );
             }
 
             for( size_t ii = 0; ii < parallelThreadCount; ++ii )
@@ -284,6 +308,15 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
             }
         }
 
+        for( const CN_VISITOR::CONNECTIONS& threadConnections : connections )
+        {
+            for( const std::pair<CN_ITEM*, CN_ITEM*>& connection : threadConnections )
+            {
+                connection.first->Connect( connection.second );
+                connection.second->Connect( connection.first );
+            }
+        }
+
         if( m_progressReporter )
             m_progressReporter->KeepRefreshing();
     }
@@ -296,7 +329,8 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
 }
 
 
-const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode )
+const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
+                                                                           bool aDirtyNetsOnly )
 {
     constexpr KICAD_T types[] = { PCB_TRACE_T, PCB_ARC_T, PCB_PAD_T, PCB_VIA_T, PCB_ZONE_AREA_T,
                                   PCB_MODULE_T, EOT };
@@ -304,20 +338,21 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
                                      PCB_MODULE_T, EOT };
 
     if( aMode == CSM_PROPAGATE )
-        return SearchClusters( aMode, no_zones, -1 );
+        return SearchClusters( aMode, no_zones, -1, aDirtyNetsOnly );
     else
-        return SearchClusters( aMode, types, -1 );
+        return SearchClusters( aMode, types, -1, aDirtyNetsOnly );
 }
 
 
 const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
                                                                            const KICAD_T aTypes[],
-                                                                           int aSingleNet )
+                                                                           int aSingleNet,
+                                                                           bool aDirtyNetsOnly )
 {
     bool withinAnyNet = ( aMode != CSM_PROPAGATE );
 
     std::deque<CN_ITEM*> Q;
-    std::set<CN_ITEM*> item_set;
+    std::vector<CN_ITEM*> roots;
 
     CLUSTERS clusters;
 
@@ -325,7 +360,7 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
         searchConnections();
 
     auto addToSearchList =
-            [&item_set, withinAnyNet, aSingleNet, aTypes]( CN_ITEM *aItem )
+            [this, &roots, withinAnyNet, aSingleNet, aTypes, aDirtyNetsOnly]( CN_ITEM *aItem )
             {
                 if( withinAnyNet && aItem->Net() <= 0 )
                     return;
@@ -352,7 +387,13 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
 
                 aItem->SetVisited( false );
 
-                item_set.insert( aItem );
+                // Items of clean nets can still be reached from a dirty one (the propagation
+                // search crosses nets), so they are reset above but don't start a search
+                // themselves: their clusters haven't changed since the last search.
+                if( aDirtyNetsOnly && !IsNetDirty( aItem->Net() ) )
+                    return;
+
+                roots.push_back( aItem );
             };
 
     std::for_each( m_itemList.begin(), m_itemList.end(), addToSearchList );
@@ -360,19 +401,13 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return CLUSTERS();
 
-    while( !item_set.empty() )
+    for( CN_ITEM* root : roots )
     {
-        CN_CLUSTER_PTR cluster ( new CN_CLUSTER() );
-        CN_ITEM*       root;
-        auto           it = item_set.begin();
-
-        while( it != item_set.end() && (*it)->Visited() )
-            it = item_set.erase( item_set.begin() );
+        if( root->Visited() )
+            continue;
 
-        if( it == item_set.end() )
-            break;
+        CN_CLUSTER_PTR cluster ( new CN_CLUSTER() );
 
-        root = *it;
         root->SetVisited( true );
 
         Q.clear();
@@ -545,8 +580,14 @@ void CN_CONNECTIVITY_ALGO::propagateConnections( BOARD_COMMIT* aCommit )
 
 void CN_CONNECTIVITY_ALGO::PropagateNets( BOARD_COMMIT* aCommit )
 {
-    m_connClusters = SearchClusters( CSM_PROPAGATE );
+    PROF_COUNTER propagateTime;
+
+    // Only the clusters holding an item of a dirty net can have changed since the last pass
+    m_connClusters = SearchClusters( CSM_PROPAGATE, true );
     propagateConnections( aCommit );
+
+    reportTiming( _( "Propagated nets of %d clusters in %0.1f ms" ), m_connClusters.size(),
+                  propagateTime );
 }
 
 
@@ -619,11 +660,32 @@ void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLAT
 
 const CN_CONNECTIVITY_ALGO::CLUSTERS& CN_CONNECTIVITY_ALGO::GetClusters()
 {
-    m_ratsnestClusters = SearchClusters( CSM_RATSNEST );
+    PROF_COUNTER clusterTime;
+
+    // Ratsnest clusters never span nets, so those of clean nets are still valid
+    m_ratsnestClusters = SearchClusters( CSM_RATSNEST, true );
+
+    reportTiming( _( "Rebuilt %d ratsnest clusters in %0.1f ms" ), m_ratsnestClusters.size(),
+                  clusterTime );
+
     return m_ratsnestClusters;
 }
 
 
+void CN_CONNECTIVITY_ALGO::reportTiming( const wxString& aFormat, size_t aCount,
+                                         PROF_COUNTER& aCounter )
+{
+    aCounter.Stop();
+
+    wxString msg = wxString::Format( aFormat, (int) aCount, aCounter.msecs() );
+
+    wxLogTrace( "CN", "%s", msg );
+
+    if( m_progressReporter )
+        m_progressReporter->Report( msg );
+}
+
+
 void CN_CONNECTIVITY_ALGO::MarkNetAsDirty( int aNet )
 {
     if( aNet < 0 )
@@ -667,8 +729,7 @@ void CN_VISITOR::checkZoneItemConnection( CN_ZONE_LAYER* aZoneLayer, CN_ITEM* aI
     {
         if( aZoneLayer->ContainsPoint( aItem->GetAnchor( i ), accuracy ) )
         {
-            aZoneLayer->Connect( aItem );
-            aItem->Connect( aZoneLayer );
+            connect( aZoneLayer, aItem );
             return;
         }
     }
@@ -709,8 +770,7 @@ void CN_VISITOR::checkZoneZoneConnection( CN_ZONE_LAYER* aZoneLayerA, CN_ZONE_LA
 
         if( aZoneLayerB->ContainsPoint( outline.CPoint( i ), radiusA ) )
         {
-            aZoneLayerA->Connect( aZoneLayerB );
-            aZoneLayerB->Connect( aZoneLayerA );
+            connect( aZoneLayerA, aZoneLayerB );
             return;
         }
     }
@@ -725,8 +785,7 @@ void CN_VISITOR::checkZoneZoneConnection( CN_ZONE_LAYER* aZoneLayerA, CN_ZONE_LA
 
         if( aZoneLayerA->ContainsPoint( outline2.CPoint( i ), radiusB ) )
         {
-            aZoneLayerA->Connect( aZoneLayerB );
-            aZoneLayerB->Connect( aZoneLayerA );
+            connect( aZoneLayerA, aZoneLayerB );
             return;
         }
     }
@@ -792,8 +851,7 @@ bool CN_VISITOR::operator()( CN_ITEM* aCandidate )
     {
         if( parentB->HitTest( wxPoint( aCandidate->GetAnchor( i ) ), accuracyA ) )
         {
-            m_item->Connect( aCandidate );
-            aCandidate->Connect( m_item );
+            connect( m_item, aCandidate );
             return true;
         }
     }
@@ -802,8 +860,7 @@ bool CN_VISITOR::operator()( CN_ITEM* aCandidate )
     {
         if( parentA->HitTest( wxPoint( m_item->GetAnchor( i ) ), accuracyB ) )
         {
-            m_item->Connect( aCandidate );
-            aCandidate->Connect( m_item );
+            connect( m_item, aCandidate );
             return true;
         }
     }
@@ -55,6 +55,7 @@ class BOARD_CONNECTED_ITEM;
 class BOARD_ITEM;
 class ZONE_CONTAINER;
 class PROGRESS_REPORTER;
+class PROF_COUNTER;
 
 class CN_EDGE
 {
@@ -179,6 +180,10 @@ private:
 
     void markItemNetAsDirty( const BOARD_ITEM* aItem );
 
+    void markConnectedNetsAsDirty( const ITEM_MAP_ENTRY& aEntry );
+
+    void reportTiming( const wxString& aFormat, size_t aCount, PROF_COUNTER& aCounter );
+
 public:
 
     CN_CONNECTIVITY_ALGO() {}
@@ -196,7 +201,7 @@ public:
 
     bool IsNetDirty( int aNet ) const
     {
-        if( aNet < 0 )
+        if( aNet < 0 || aNet >= (int) m_dirtyNets.size() )
             return false;
 
         return m_dirtyNets[ aNet ];
@@ -232,8 +237,14 @@ public:
     bool    Remove( BOARD_ITEM* aItem );
     bool    Add( BOARD_ITEM* aItem );
 
-    const CLUSTERS  SearchClusters( CLUSTER_SEARCH_MODE aMode, const KICAD_T aTypes[], int aSingleNet );
-    const CLUSTERS  SearchClusters( CLUSTER_SEARCH_MODE aMode );
+    /**
+     * Groups the connected items into clusters.
+     * @param aDirtyNetsOnly limits the search to the clusters containing an item of a net
+     * marked as dirty since the last ClearDirtyFlags() call
+     */
+    const CLUSTERS  SearchClusters( CLUSTER_SEARCH_MODE aMode, const KICAD_T aTypes[],
+                                    int aSingleNet, bool aDirtyNetsOnly = false );
+    const CLUSTERS  SearchClusters( CLUSTER_SEARCH_MODE aMode, bool aDirtyNetsOnly = false );
 
     /**
      * Propagates nets from pads to other items in clusters
@@ -252,6 +263,10 @@ public:
      */
     void    FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLATED_ISLAND_LIST>& aZones );
 
+    /**
+     * @return the ratsnest clusters of the dirty nets.  Clusters of the other nets are
+     * unchanged since the previous call.
+     */
     const CLUSTERS& GetClusters();
 
     const CN_LIST& ItemList() const
@@ -287,21 +302,34 @@ public:
 class CN_VISITOR {
 
 public:
+    using CONNECTIONS = std::vector<std::pair<CN_ITEM*, CN_ITEM*>>;
 
-    CN_VISITOR( CN_ITEM* aItem ) :
-        m_item( aItem )
+    /**
+     * @param aConnections receives the pairs of items found to be connected.  The items
+     * themselves are left alone, as other threads may be visiting them.
+     */
+    CN_VISITOR( CN_ITEM* aItem, CONNECTIONS* aConnections ) :
+        m_item( aItem ),
+        m_connections( aConnections )
     {}
 
     bool operator()( CN_ITEM* aCandidate );
 
 protected:
 
+    void connect( CN_ITEM* aItemA, CN_ITEM* aItemB )
+    {
+        m_connections->emplace_back( aItemA, aItemB );
+    }
+
     void checkZoneItemConnection( CN_ZONE_LAYER* aZoneLayer, CN_ITEM* aItem );
 
     void checkZoneZoneConnection( CN_ZONE_LAYER* aZoneLayerA, CN_ZONE_LAYER* aZoneLayerB );
 
     ///> the item we are looking for connections to
     CN_ITEM* m_item;
+
+    CONNECTIONS* m_connections;
 };
 
 #endif
@@ -37,7 +37,25 @@
 
 #include <ratsnest/ratsnest_data.h>
 
-CONNECTIVITY_DATA::CONNECTIVITY_DATA()
+
+/**
+ * What the dynamic ratsnest worker needs to know about the moving items, copied when the
+ * request is made as the items keep moving.
+ */
+struct CONNECTIVITY_DATA::DYNAMIC_RATSNEST_REQUEST
+{
+    ///> Net codes and positions of the moving anchors
+    std::vector<std::pair<int, std::vector<VECTOR2I>>> m_nets;
+
+    ///> Ratsnest between the moving items themselves
+    std::vector<RN_DYNAMIC_LINE> m_internalLines;
+
+    std::function<void()> m_onDone;
+};
+
+
+CONNECTIVITY_DATA::CONNECTIVITY_DATA() :
+        m_dynamicRatsnestCancel( false )
 {
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO );
     m_progressReporter = nullptr;
@@ -46,7 +64,8 @@ CONNECTIVITY_DATA::CONNECTIVITY_DATA()
 
 
 CONNECTIVITY_DATA::CONNECTIVITY_DATA( const std::vector<BOARD_ITEM*>& aItems, bool aSkipRatsnest )
-    : m_skipRatsnest( aSkipRatsnest )
+    : m_skipRatsnest( aSkipRatsnest ),
+      m_dynamicRatsnestCancel( false )
 {
     Build( aItems );
     m_progressReporter = nullptr;
@@ -167,6 +186,9 @@ void CONNECTIVITY_DATA::addRatsnestCluster( const std::shared_ptr<CN_CLUSTER>& a
 
 void CONNECTIVITY_DATA::RecalculateRatsnest( BOARD_COMMIT* aCommit  )
 {
+    // The dynamic ratsnest worker reads the nets
+    stopDynamicRatsnest();
+
     m_connAlgo->PropagateNets( aCommit );
 
     int lastNet = m_connAlgo->NetCount();
@@ -221,6 +243,9 @@ void CONNECTIVITY_DATA::BlockRatsnestItems( const std::vector<BOARD_ITEM*>& aIte
 {
     std::vector<BOARD_CONNECTED_ITEM*> citems;
 
+    // The dynamic ratsnest worker reads the blocked flags
+    stopDynamicRatsnest();
+
     for( auto item : aItems )
     {
         if( item->Type() == PCB_MODULE_T )
@@ -273,34 +298,22 @@ void CONNECTIVITY_DATA::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLATED_
 
 
 void CONNECTIVITY_DATA::ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems,
-                                                const CONNECTIVITY_DATA* aDynamicData )
+                                                const CONNECTIVITY_DATA* aDynamicData,
+                                                std::function<void()> aOnDone )
 {
     if( !aDynamicData )
         return;
 
-    m_dynamicRatsnest.clear();
+    auto request = std::make_unique<DYNAMIC_RATSNEST_REQUEST>();
 
-    // This gets connections between the stationary board and the
-    // moving selection
+    // The connections between the stationary board and the moving selection are searched
+    // by the worker
     for( unsigned int nc = 1; nc < aDynamicData->m_nets.size(); nc++ )
     {
         auto dynNet = aDynamicData->m_nets[nc];
 
         if( dynNet->GetNodeCount() != 0 )
-        {
-            auto ourNet = m_nets[nc];
-            CN_ANCHOR_PTR nodeA, nodeB;
-
-            if( ourNet->NearestBicoloredPair( *dynNet, nodeA, nodeB ) )
-            {
-                RN_DYNAMIC_LINE l;
-                l.a = nodeA->Pos();
-                l.b = nodeB->Pos();
-                l.netCode = nc;
-
-                m_dynamicRatsnest.push_back( l );
-            }
-        }
+            request->m_nets.emplace_back( nc, dynNet->GetNodePositions() );
     }
 
     // This gets the ratsnest for internal connections in the moving set
@@ -316,24 +329,128 @@ void CONNECTIVITY_DATA::ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>&
         l.a = nodeA->Parent()->GetPosition();
         l.b = nodeB->Parent()->GetPosition();
         l.netCode = 0;
-        m_dynamicRatsnest.push_back( l );
+        request->m_internalLines.push_back( l );
+    }
+
+    request->m_onDone = std::move( aOnDone );
+
+    std::lock_guard<std::mutex> lock( m_dynamicRatsnestLock );
+
+    // Whatever the worker is busy with is stale now
+    m_dynamicRatsnestRequest = std::move( request );
+    m_dynamicRatsnestCancel = true;
+
+    if( !m_dynamicRatsnestBusy )
+    {
+        m_dynamicRatsnestBusy = true;
+        m_dynamicRatsnestTask = std::async( std::launch::async,
+                                            [this]() { dynamicRatsnestWorker(); } );
+    }
+}
+
+
+void CONNECTIVITY_DATA::dynamicRatsnestWorker()
+{
+    std::unique_ptr<DYNAMIC_RATSNEST_REQUEST> request;
+
+    while( true )
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_dynamicRatsnestLock );
+
+            if( !m_dynamicRatsnestRequest )
+            {
+                m_dynamicRatsnestBusy = false;
+                return;
+            }
+
+            request = std::move( m_dynamicRatsnestRequest );
+            m_dynamicRatsnestCancel = false;
+        }
+
+        std::vector<RN_DYNAMIC_LINE> lines;
+
+        for( const std::pair<int, std::vector<VECTOR2I>>& dynNet : request->m_nets )
+        {
+            if( m_dynamicRatsnestCancel )
+                break;
+
+            RN_DYNAMIC_LINE l;
+
+            if( m_nets[dynNet.first]->NearestBicoloredPair( dynNet.second, l.a, l.b ) )
+            {
+                l.netCode = dynNet.first;
+                lines.push_back( l );
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock( m_dynamicRatsnestLock );
+
+            if( m_dynamicRatsnestCancel )
+                continue;
+
+            lines.insert( lines.end(), request->m_internalLines.begin(),
+                          request->m_internalLines.end() );
+
+            m_dynamicRatsnestResult = std::move( lines );
+            m_dynamicRatsnestReady = true;
+        }
+
+        if( request->m_onDone )
+            request->m_onDone();
+    }
+}
+
+
+void CONNECTIVITY_DATA::stopDynamicRatsnest()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_dynamicRatsnestLock );
+
+        m_dynamicRatsnestRequest.reset();
+        m_dynamicRatsnestCancel = true;
+    }
+
+    if( m_dynamicRatsnestTask.valid() )
+        m_dynamicRatsnestTask.wait();
+}
+
+
+const std::vector<RN_DYNAMIC_LINE>& CONNECTIVITY_DATA::GetDynamicRatsnest()
+{
+    std::lock_guard<std::mutex> lock( m_dynamicRatsnestLock );
+
+    // Pick up the latest lines of the worker, if any
+    if( m_dynamicRatsnestReady )
+    {
+        m_dynamicRatsnest.swap( m_dynamicRatsnestResult );
+        m_dynamicRatsnestReady = false;
     }
+
+    return m_dynamicRatsnest;
 }
 
 
 void CONNECTIVITY_DATA::ClearDynamicRatsnest()
 {
+    // Stop the worker before it reads the flags
+    HideDynamicRatsnest();
+
     m_connAlgo->ForEachAnchor( []( CN_ANCHOR& anchor )
                                {
                                    anchor.SetNoLine( false );
                                } );
-    HideDynamicRatsnest();
 }
 
 
 void CONNECTIVITY_DATA::HideDynamicRatsnest()
 {
+    stopDynamicRatsnest();
+
     m_dynamicRatsnest.clear();
+    m_dynamicRatsnestResult.clear();
+    m_dynamicRatsnestReady = false;
 }
 
 
@@ -396,6 +513,8 @@ unsigned int CONNECTIVITY_DATA::GetUnconnectedCount() const
 
 void CONNECTIVITY_DATA::Clear()
 {
+    stopDynamicRatsnest();
+
     for( auto net : m_nets )
         delete net;
 
@@ -29,6 +29,9 @@
 
 #include <core/typeinfo.h>
 
+#include <atomic>
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -213,18 +216,26 @@ public:
      */
     void HideDynamicRatsnest();
 
+#ifndef SWIG
     /**
      * Function ComputeDynamicRatsnest()
      * Calculates the temporary dynamic ratsnest (i.e. the ratsnest lines that)
      * for the set of items aItems.
+     *
+     * The lines to the rest of the board are searched in a worker thread, on a copy of the
+     * positions of aDynamicData, so that moving a large selection doesn't stall the tool.  A
+     * new request cancels the one in progress.
+     * @param aOnDone is called (from the worker thread) when new lines are ready to be drawn.
      */
     void ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems,
-                                 const CONNECTIVITY_DATA* aDynamicData );
+                                 const CONNECTIVITY_DATA* aDynamicData,
+                                 std::function<void()> aOnDone = nullptr );
+#endif
 
-    const std::vector<RN_DYNAMIC_LINE>& GetDynamicRatsnest() const
-    {
-        return m_dynamicRatsnest;
-    }
+    /**
+     * Returns the most recent complete dynamic ratsnest.  To be called from the UI thread.
+     */
+    const std::vector<RN_DYNAMIC_LINE>& GetDynamicRatsnest();
 
     /**
      * Function GetConnectedItems()
@@ -279,6 +290,12 @@ private:
 
     void    updateRatsnest();
 
+    ///> Body of the dynamic ratsnest worker: handles requests until there are no more
+    void    dynamicRatsnestWorker();
+
+    ///> Cancels the dynamic ratsnest requests and waits for the worker to finish
+    void    stopDynamicRatsnest();
+
     /**
      * Updates the item positions without modifying the dirtyNet flag.  This is valid only when the
      * item list contains all elements in the connectivity database
@@ -292,6 +309,18 @@ private:
     std::vector<RN_DYNAMIC_LINE> m_dynamicRatsnest;
     std::vector<RN_NET*> m_nets;
 
+    struct DYNAMIC_RATSNEST_REQUEST;
+
+    /// Dynamic ratsnest worker state, guarded by m_dynamicRatsnestLock.  m_dynamicRatsnest
+    /// belongs to the UI thread; the worker leaves its results in m_dynamicRatsnestResult.
+    std::mutex                                m_dynamicRatsnestLock;
+    std::unique_ptr<DYNAMIC_RATSNEST_REQUEST> m_dynamicRatsnestRequest;
+    std::vector<RN_DYNAMIC_LINE>              m_dynamicRatsnestResult;
+    bool                                      m_dynamicRatsnestReady = false;
+    bool                                      m_dynamicRatsnestBusy = false;
+    std::atomic<bool>                         m_dynamicRatsnestCancel;
+    std::future<void>                         m_dynamicRatsnestTask;
+
     PROGRESS_REPORTER* m_progressReporter;
 
     bool m_skipRatsnest = false;
@@ -185,6 +185,23 @@ const VECTOR2I CN_ZONE_LAYER::GetAnchor( int n ) const
 }
 
 
+void CN_ITEM::growAnchorBlock()
+{
+    // Anchors are only added while the item is built, before anyone holds a handle to them,
+    // so they can still be moved to a larger block.
+    auto block = std::make_shared<std::vector<CN_ANCHOR>>();
+
+    block->reserve( std::max<size_t>( 2, 2 * m_anchorBlock->size() ) );
+    block->insert( block->end(), m_anchorBlock->begin(), m_anchorBlock->end() );
+
+    m_anchorBlock = block;
+    m_anchors.clear();
+
+    for( CN_ANCHOR& anchor : *m_anchorBlock )
+        m_anchors.emplace_back( m_anchorBlock, &anchor );
+}
+
+
 void CN_ITEM::RemoveInvalidRefs()
 {
     for( auto it = m_connected.begin(); it != m_connected.end(); )
@@ -178,6 +178,10 @@ private:
     ///> list of items physically connected (touching)
     CONNECTED_ITEMS m_connected;
 
+    ///> the anchors themselves, stored by value in a single block.  The handles in m_anchors
+    ///> point into it and share its ownership, so there's no allocation per anchor.
+    std::shared_ptr<std::vector<CN_ANCHOR>> m_anchorBlock;
+
     CN_ANCHORS m_anchors;
 
     ///> visited flag for the BFS scan
@@ -189,9 +193,6 @@ private:
     ///> valid flag, used to identify garbage items (we use lazy removal)
     bool m_valid;
 
-    ///> mutex protecting this item's connected_items set to allow parallel connection threads
-    std::mutex m_listLock;
-
 protected:
     ///> dirty flag, used to identify recently added item not yet scanned into the connectivity search
     bool m_dirty;
@@ -212,7 +213,9 @@ public:
         m_visited = false;
         m_valid = true;
         m_dirty = true;
-        m_anchors.reserve( std::max( 6, aAnchorCount ) );
+        m_anchorBlock = std::make_shared<std::vector<CN_ANCHOR>>();
+        m_anchorBlock->reserve( aAnchorCount );
+        m_anchors.reserve( aAnchorCount );
         m_layers = LAYER_RANGE( 0, PCB_LAYER_ID_COUNT );
         m_connected.reserve( 8 );
     }
@@ -221,7 +224,11 @@ public:
 
     void AddAnchor( const VECTOR2I& aPos )
     {
-        m_anchors.emplace_back( std::make_shared<CN_ANCHOR>( aPos, this ) );
+        if( m_anchorBlock->size() == m_anchorBlock->capacity() )
+            growAnchorBlock();
+
+        m_anchorBlock->emplace_back( aPos, this );
+        m_anchors.emplace_back( m_anchorBlock, &m_anchorBlock->back() );
     }
 
     CN_ANCHORS& Anchors()
@@ -329,10 +336,12 @@ public:
         return m_canChangeNet;
     }
 
+    /**
+     * Not thread safe: the parallel connection search collects the connections and adds
+     * them once all the threads are done.
+     */
     void Connect( CN_ITEM* b )
     {
-        std::lock_guard<std::mutex> lock( m_listLock );
-
         auto i = std::lower_bound( m_connected.begin(), m_connected.end(), b );
 
         if( i != m_connected.end() && *i == b )
@@ -350,6 +359,9 @@ public:
     {
         return ( !m_parent || !m_valid ) ? -1 : m_parent->GetNetCode();
     }
+
+private:
+    void growAnchorBlock();
 };
 
 typedef std::shared_ptr<CN_ITEM> CN_ITEM_PTR;
@@ -359,7 +371,8 @@ class CN_ZONE_LAYER : public CN_ITEM
 public:
     CN_ZONE_LAYER( ZONE_CONTAINER* aParent, PCB_LAYER_ID aLayer, bool aCanChangeNet,
                    int aSubpolyIndex ) :
-        CN_ITEM( aParent, aCanChangeNet ),
+        CN_ITEM( aParent, aCanChangeNet,
+                 aParent->GetFilledPolysList( aLayer ).COutline( aSubpolyIndex ).PointCount() ),
         m_subpolyIndex( aSubpolyIndex ),
         m_layer( aLayer )
     {
@@ -466,6 +479,15 @@ public:
         m_index.Query( aItem->BBox(), aItem->Layers(), aFunc );
     }
 
+    /**
+     * Rebuilds the spatial index if it has changed a lot.  FindNearby() can be called from
+     * several threads at once, but not while this is running.
+     */
+    void PackIndex()
+    {
+        m_index.Pack();
+    }
+
     void SetHasInvalid( bool aInvalid = true )
     {
         m_hasInvalid = aInvalid;
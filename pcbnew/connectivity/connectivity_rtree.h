@@ -27,13 +27,16 @@
 #include <math/box2.h>
 #include <router/pns_layerset.h>
 
-#include <geometry/rtree.h>
+#include <geometry/packed_rtree.h>
 
 
 /**
  * CN_RTREE -
  * Implements an R-tree for fast spatial indexing of connectivity items.
  * Non-owning.
+ *
+ * Items are held in a packed tree, plus a short list of the items inserted since it was last
+ * (re)built.  Pack() must be called before querying from several threads at once.
  */
 template< class T >
 class CN_RTREE
@@ -42,12 +45,6 @@ public:
 
     CN_RTREE()
     {
-        this->m_tree = new RTree<T, int, 3, double>();
-    }
-
-    ~CN_RTREE()
-    {
-        delete this->m_tree;
     }
 
     /**
@@ -56,13 +53,7 @@ public:
      */
     void Insert( T aItem )
     {
-        const BOX2I&        bbox    = aItem->BBox();
-        const LAYER_RANGE   layers  = aItem->Layers();
-
-        const int           mmin[3] = { layers.Start(), bbox.GetX(), bbox.GetY() };
-        const int           mmax[3] = { layers.End(), bbox.GetRight(), bbox.GetBottom() };
-
-        m_tree->Insert( mmin, mmax, aItem );
+        m_pending.push_back( makeEntry( aItem ) );
     }
 
     /**
@@ -72,23 +63,26 @@ public:
      */
     void Remove( T aItem )
     {
+        for( size_t ii = 0; ii < m_pending.size(); ++ii )
+        {
+            if( m_pending[ii].data == aItem )
+            {
+                m_pending[ii] = m_pending.back();
+                m_pending.pop_back();
+                return;
+            }
+        }
 
         // First, attempt to remove the item using its given BBox
-        const BOX2I&        bbox    = aItem->BBox();
-        const LAYER_RANGE   layers  = aItem->Layers();
-        const int           mmin[3] = { layers.Start(), bbox.GetX(), bbox.GetY() };
-        const int           mmax[3] = { layers.End(), bbox.GetRight(), bbox.GetBottom() };
+        const ENTRY entry = makeEntry( aItem );
 
-        // If we are not successful ( 1 == not found ), then we expand
-        // the search to the full tree
-        if( m_tree->Remove( mmin, mmax, aItem ) )
+        // If we are not successful, then we expand the search to the full tree
+        if( !m_tree.Remove( entry.min, entry.max, aItem ) )
         {
             // N.B. We must search the whole tree for the pointer to remove
             // because the item may have been moved before we have the chance to
             // delete it from the tree
-            const int       mmin2[3] = { INT_MIN, INT_MIN, INT_MIN };
-            const int       mmax2[3] = { INT_MAX, INT_MAX, INT_MAX };
-            m_tree->Remove( mmin2, mmax2, aItem );
+            m_tree.Remove( aItem );
         }
     }
 
@@ -98,7 +92,25 @@ public:
      */
     void RemoveAll( )
     {
-        m_tree->RemoveAll();
+        m_tree.Clear();
+        m_pending.clear();
+    }
+
+    /**
+     * Function Pack()
+     * Rebuilds the packed tree if enough items have been inserted or removed since it was
+     * last built for the linear search of the newer ones to become noticeable.
+     */
+    void Pack()
+    {
+        const size_t threshold = std::max<size_t>( 64, m_tree.Size() / 16 );
+
+        if( m_pending.size() < threshold && m_tree.RemovedCount() < threshold )
+            return;
+
+        m_tree.GetEntries( m_pending );
+        m_tree.Build( m_pending );
+        m_pending.clear();
     }
 
     /**
@@ -112,12 +124,45 @@ public:
         const int   mmin[3] = { aRange.Start(), aBounds.GetX(), aBounds.GetY() };
         const int   mmax[3] = { aRange.End(), aBounds.GetRight(), aBounds.GetBottom() };
 
-        m_tree->Search( mmin, mmax, aVisitor );
+        bool keepGoing = true;
+
+        auto visit =
+                [&]( T aItem ) -> bool
+                {
+                    keepGoing = aVisitor( aItem );
+                    return keepGoing;
+                };
+
+        m_tree.Search( mmin, mmax, visit );
+
+        for( size_t ii = 0; keepGoing && ii < m_pending.size(); ++ii )
+        {
+            const ENTRY& entry = m_pending[ii];
+
+            if( entry.min[0] <= mmax[0] && entry.max[0] >= mmin[0]
+                    && entry.min[1] <= mmax[1] && entry.max[1] >= mmin[1]
+                    && entry.min[2] <= mmax[2] && entry.max[2] >= mmin[2] )
+            {
+                keepGoing = aVisitor( entry.data );
+            }
+        }
     }
 
 private:
+    using ENTRY = typename PACKED_RTREE<T, 3>::ENTRY;
+
+    static ENTRY makeEntry( T aItem )
+    {
+        const BOX2I&        bbox    = aItem->BBox();
+        const LAYER_RANGE   layers  = aItem->Layers();
+
+        return { { layers.Start(), bbox.GetX(), bbox.GetY() },
+                 { layers.End(), bbox.GetRight(), bbox.GetBottom() },
+                 aItem };
+    }
 
-    RTree<T, int, 3, double>* m_tree;
+    PACKED_RTREE<T, 3>  m_tree;
+    std::vector<ENTRY>  m_pending;      // inserted since m_tree was last built
 };
 
 
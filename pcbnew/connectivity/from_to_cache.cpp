@@ -17,7 +17,9 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstdio>
+#include <map>
 #include <memory>
 #include <reporter.h>
 #include <class_board.h>
@@ -51,228 +53,376 @@ void FROM_TO_CACHE::buildEndpointList( )
 }
 
 
-enum PATH_STATUS {
-    PS_OK = 0,
-    PS_MULTIPLE_PATHS = -1,
-    PS_NO_PATH = -2
-};
+/**
+ * Builds the spanning forest of the items connected to a net's pads.  The bridges of the
+ * graph are found on a depth-first forest (Tarjan) and the paths are taken from a
+ * breadth-first one, so they are the shortest ones when there is a choice.
+ */
+static void buildSpanningForest( const std::vector<CN_ITEM*>& aPadItems,
+                                 std::vector<CN_ITEM*>& aNodes, std::vector<int>& aParent,
+                                 std::vector<int>& aDepth, std::vector<int>& aRoot,
+                                 std::vector<int>& aCycleEdges )
+{
+    std::unordered_map<CN_ITEM*, int> index;
+    std::vector<int>                  adjOffsets = { 0 };
+    std::vector<int>                  adj;
 
+    aNodes = aPadItems;
 
-static bool isVertexVisited( CN_ITEM* v, const std::vector<CN_ITEM*>& path )
-{
-    for( auto u : path )
+    for( int ii = 0; ii < (int) aNodes.size(); ++ii )
+        index[ aNodes[ii] ] = ii;
+
+    // Collect the connected items as adjacency lists; aNodes doubles as the search queue
+    for( int ii = 0; ii < (int) aNodes.size(); ++ii )
     {
-        if ( u == v )
-            return true;
-    }
+        for( CN_ITEM* citem : aNodes[ii]->ConnectedItems() )
+        {
+            if( !citem->Valid() )
+                continue;
 
-    return false;
-}
+            auto it = index.find( citem );
 
+            if( it == index.end() )
+            {
+                it = index.emplace( citem, (int) aNodes.size() ).first;
+                aNodes.push_back( citem );
+            }
 
-static PATH_STATUS uniquePathBetweenNodes( CN_ITEM* u, CN_ITEM* v, std::vector<CN_ITEM*>& outPath )
-{
-    using Path = std::vector<CN_ITEM*>;
-    std::deque<Path> Q;
+            adj.push_back( it->second );
+        }
+
+        adjOffsets.push_back( adj.size() );
+    }
+
+    int n = aNodes.size();
 
-    Path pInit;
-    int  pathFound = false;
-    pInit.push_back( u );
-    Q.push_back( pInit );
+    // Bridges: an edge to a depth-first child is one if no back edge from the child's
+    // subtree reaches above it.  CN_ITEM::Connect() keeps no duplicate connections.
+    std::vector<int>                 disc( n, -1 );
+    std::vector<int>                 low( n );
+    std::vector<int>                 dfsParent( n, -1 );
+    std::vector<char>                bridgeToParent( n, 0 );
+    std::vector<std::pair<int, int>> stack;
+    int                              time = 0;
 
-    while( Q.size() )
+    for( int start = 0; start < n; ++start )
     {
-        Path path = Q.front();
-        Q.pop_front();
-        CN_ITEM* last = path.back();
+        if( disc[start] >= 0 )
+            continue;
 
-        if( last == v )
-        {
-            outPath = path;
-            if( pathFound )
-                return PS_MULTIPLE_PATHS;
-            pathFound = true;
-        }
+        disc[start] = low[start] = time++;
+        stack.emplace_back( start, adjOffsets[start] );
 
-        for( auto ci : last->ConnectedItems() )
+        while( !stack.empty() )
         {
-            bool vertexVisited = isVertexVisited( ci, path );
+            int u = stack.back().first;
+            int& next = stack.back().second;
 
-            for( auto& p : Q )
-                if( isVertexVisited( ci, p ) )
+            if( next < adjOffsets[u + 1] )
+            {
+                int v = adj[next++];
+
+                if( disc[v] < 0 )
                 {
-                    vertexVisited = true;
-                    break;
+                    dfsParent[v] = u;
+                    disc[v] = low[v] = time++;
+                    stack.emplace_back( v, adjOffsets[v] );
                 }
-
-            if( !vertexVisited )
+                else if( v != dfsParent[u] )
+                {
+                    low[u] = std::min( low[u], disc[v] );
+                }
+            }
+            else
             {
-                Path newpath( path );
-                newpath.push_back( ci );
-                Q.push_back( newpath );
+                stack.pop_back();
+
+                int p = dfsParent[u];
+
+                if( p >= 0 )
+                {
+                    low[p] = std::min( low[p], low[u] );
+                    bridgeToParent[u] = low[u] > disc[p];
+                }
             }
         }
     }
 
-    return pathFound ? PS_OK : PS_NO_PATH;
-};
+    auto isBridge =
+            [&]( int u, int v )
+            {
+                return ( dfsParent[v] == u && bridgeToParent[v] )
+                        || ( dfsParent[u] == v && bridgeToParent[u] );
+            };
 
+    aParent.assign( n, -1 );
+    aDepth.assign( n, -1 );
+    aRoot.assign( n, -1 );
+    aCycleEdges.assign( n, 0 );
 
-int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo )
+    std::vector<int> queue;
+    queue.reserve( n );
+
+    for( int start = 0; start < n; ++start )
+    {
+        if( aDepth[start] >= 0 )
+            continue;
+
+        aDepth[start] = 0;
+        aRoot[start] = start;
+        queue.push_back( start );
+
+        for( size_t head = queue.size() - 1; head < queue.size(); ++head )
+        {
+            int u = queue[head];
+
+            for( int ii = adjOffsets[u]; ii < adjOffsets[u + 1]; ++ii )
+            {
+                int v = adj[ii];
+
+                if( aDepth[v] >= 0 )
+                    continue;
+
+                aParent[v] = u;
+                aDepth[v] = aDepth[u] + 1;
+                aRoot[v] = aRoot[u];
+                aCycleEdges[v] = aCycleEdges[u] + ( isBridge( u, v ) ? 0 : 1 );
+                queue.push_back( v );
+            }
+        }
+    }
+}
+
+
+void FROM_TO_CACHE::buildNets()
 {
-    std::vector<FT_PATH> paths;
-    auto connectivity = m_board->GetConnectivity();
-    auto cnAlgo = connectivity->GetConnectivityAlgo();
+    m_ftNets.clear();
+    m_padNodes.clear();
 
-    for( auto& endpoint : m_ftEndpoints )
+    auto                               cnAlgo = m_board->GetConnectivity()->GetConnectivityAlgo();
+    std::map<int, std::vector<D_PAD*>> netPads;
+
+    for( MODULE* mod : m_board->Modules() )
     {
-        if( WildCompareString( aFrom, endpoint.name, false ) )
+        for( D_PAD* pad : mod->Pads() )
         {
-            FT_PATH p;
-            p.net = endpoint.parent->GetNetCode();
-            p.from = endpoint.parent;
-            p.to = nullptr;
-            paths.push_back(p);
+            if( pad->GetNetCode() > 0 && cnAlgo->ItemExists( pad )
+                    && !cnAlgo->ItemEntry( pad ).GetItems().empty() )
+            {
+                netPads[ pad->GetNetCode() ].push_back( pad );
+            }
         }
     }
 
-    for( auto &path : paths )
+    for( auto& entry : netPads )
     {
-        int count = 0;
-        auto netName = path.from->GetNetname();
+        // A path needs two ends
+        if( entry.second.size() < 2 )
+            continue;
 
-        wxString fromName = path.from->GetParent()->GetReference() + "-" + path.from->GetName();
+        FT_NET net;
+        net.pads = entry.second;
 
-        const KICAD_T onlyRouting[] = { PCB_PAD_T, PCB_ARC_T, PCB_VIA_T, PCB_TRACE_T, EOT };
+        for( D_PAD* pad : net.pads )
+        {
+            m_padNodes[pad] = { (int) m_ftNets.size(), (int) net.padItems.size() };
+            net.padItems.push_back( cnAlgo->ItemEntry( pad ).GetItems().front() );
+        }
 
-        auto padCandidates = connectivity->GetConnectedItems( path.from, onlyRouting );
-        D_PAD* toPad = nullptr;
+        m_ftNets.push_back( std::move( net ) );
+    }
+}
 
-        for( auto pitem : padCandidates )
-        {
-            if( pitem == path.from )
-                continue;
 
-            if( pitem->Type() != PCB_PAD_T )
-                continue;
+const FROM_TO_CACHE::FT_NET& FROM_TO_CACHE::getNet( int aIndex )
+{
+    FT_NET& net = m_ftNets[ aIndex ];
 
-            D_PAD *pad = static_cast<D_PAD*>( pitem );
+    if( !net.built )
+    {
+        buildSpanningForest( net.padItems, net.nodes, net.parent, net.depth, net.root,
+                             net.cycleEdges );
+        net.built = true;
+    }
 
-            wxString toName = pad->GetParent()->GetReference() + "-" + pad->GetName();
+    return net;
+}
 
 
-            for ( auto& endpoint : m_ftEndpoints )
-            {
-                if( pad == endpoint.parent )
-                {
-                        if( WildCompareString( aTo, endpoint.name, false ) )
-                        {
-                            count++;
-                            toPad = endpoint.parent;
-
-                            path.to = toPad;
-                            path.fromName = fromName;
-                            path.toName = toName;
-                            path.fromWildcard = aFrom;
-                            path.toWildcard = aTo;
-
-                            if( count >= 2 )
-                            {
-                                // fixme: report this somewhere?
-                                //printf("Multiple targets found, aborting...\n");
-                                path.to = nullptr;
-                            }
-                        }
-                    }
-                }
+int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo,
+                                     std::unordered_set<BOARD_CONNECTED_ITEM*>& aPathItems )
+{
+    std::vector<D_PAD*>        fromPads;
+    std::unordered_set<D_PAD*> fromSet;
+    std::unordered_set<D_PAD*> toPads;
+
+    for( auto& endpoint : m_ftEndpoints )
+    {
+        if( WildCompareString( aFrom, endpoint.name, false )
+                && fromSet.insert( endpoint.parent ).second )
+        {
+            fromPads.push_back( endpoint.parent );
         }
+
+        if( WildCompareString( aTo, endpoint.name, false ) )
+            toPads.insert( endpoint.parent );
     }
 
     int newPaths = 0;
 
-    for( auto &path : paths )
+    for( D_PAD* fromPad : fromPads )
     {
-        if( !path.from || !path.to )
-            continue;
-
+        auto padNode = m_padNodes.find( fromPad );
 
-        CN_ITEM *cnFrom = cnAlgo->ItemEntry( path.from ).GetItems().front();
-        CN_ITEM *cnTo = cnAlgo->ItemEntry( path.to ).GetItems().front();
-        CN_ITEM::CONNECTED_ITEMS upath;
+        if( padNode == m_padNodes.end() )
+            continue;
 
-        auto result = uniquePathBetweenNodes( cnFrom, cnTo, upath );
+        const FT_NET& net = getNet( padNode->second.net );
+        int           from = padNode->second.node;
+        int           to = -1;
+        int           count = 0;
 
-        if( result == PS_OK )
-            path.isUnique = true;
-        else
-            path.isUnique = false;
+        for( int ii = 0; ii < (int) net.pads.size(); ++ii )
+        {
+            if( ii != from && net.root[ii] == net.root[from] && toPads.count( net.pads[ii] ) )
+            {
+                count++;
+                to = ii;
+            }
+        }
 
+        // fixme: report multiple targets somewhere?
+        if( count != 1 )
+            continue;
 
-        //printf( "%s\n", (const char *) wxString::Format( _("Check path: %s -> %s (net %s)"), path.fromName, path.toName, cnFrom->Parent()->GetNetname() ) );
+        FT_PATH path;
+        path.net = fromPad->GetNetCode();
+        path.from = fromPad;
+        path.to = net.pads[to];
+        path.fromName = fromPad->GetParent()->GetReference() + "-" + fromPad->GetName();
+        path.toName = path.to->GetParent()->GetReference() + "-" + path.to->GetName();
+        path.fromWildcard = aFrom;
+        path.toWildcard = aTo;
+
+        // Walk both ends up to their common ancestor
+        int u = from;
+        int v = to;
+        int cycleEdges = net.cycleEdges[u] + net.cycleEdges[v];
+
+        while( net.depth[u] > net.depth[v] )
+        {
+            path.pathItems.insert( net.nodes[u]->Parent() );
+            u = net.parent[u];
+        }
 
-        if( result == PS_NO_PATH )
-            continue;
+        while( net.depth[v] > net.depth[u] )
+        {
+            path.pathItems.insert( net.nodes[v]->Parent() );
+            v = net.parent[v];
+        }
 
-        for( auto item : upath )
+        while( u != v )
         {
-            path.pathItems.insert( item->Parent() );
+            path.pathItems.insert( net.nodes[u]->Parent() );
+            path.pathItems.insert( net.nodes[v]->Parent() );
+            u = net.parent[u];
+            v = net.parent[v];
         }
 
-        m_ftPaths.push_back(path);
+        path.pathItems.insert( net.nodes[u]->Parent() );
+        path.isUnique = cycleEdges == 2 * net.cycleEdges[u];
+
+        aPathItems.insert( path.pathItems.begin(), path.pathItems.end() );
+        m_ftPaths.push_back( path );
         newPaths++;
     }
 
-    //reportAux( _("Cached %d paths\n"), newPaths );
-
     return newPaths;
 }
 
-bool  FROM_TO_CACHE::IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString& aFrom, const wxString& aTo )
+
+void FROM_TO_CACHE::updateNets()
 {
-    int nFromTosFound = 0;
+    if( !m_netsValid )
+    {
+        buildEndpointList();
+        buildNets();
+        m_netsValid = true;
+    }
+}
+
 
+bool FROM_TO_CACHE::IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString& aFrom,
+                                    const wxString& aTo )
+{
     if( !m_board )
         return false;
 
-    //printf("Check %d cached paths [%p]\n", m_ftPaths.size(), aItem );
-    for( int attempt = 0; attempt < 2; attempt++ )
+    auto prepared = m_preparedPathItems.find( aFrom );
+
+    if( prepared != m_preparedPathItems.end() )
     {
-        // item already belongs to path
-        for( auto& ftPath : m_ftPaths )
-        {
-            if( aFrom == ftPath.fromWildcard &&
-                    aTo == ftPath.toWildcard )
-                {
-                    nFromTosFound++;
+        auto it = prepared->second.find( aTo );
 
-                    if( ftPath.pathItems.count( aItem ) )
-                    {
-            //            printf("Found cached path for %p [%s->%s]\n", aItem, (const char *)ftPath.fromName, (const char *) ftPath.toName );
-                        return true;
-                    }
-                }
-        }
+        if( it != prepared->second.end() )
+            return it->second.count( aItem ) > 0;
+    }
+
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    updateNets();
+
+    auto& toMap = m_pathItems[ aFrom ];
+    auto  it = toMap.find( aTo );
 
-        if( !nFromTosFound )
-            cacheFromToPaths( aFrom, aTo );
-        else
-            return false;
+    if( it == toMap.end() )
+    {
+        it = toMap.emplace( aTo, std::unordered_set<BOARD_CONNECTED_ITEM*>() ).first;
+        cacheFromToPaths( aFrom, aTo, it->second );
     }
 
-    return false;
+    return it->second.count( aItem ) > 0;
+}
+
+
+void FROM_TO_CACHE::Prepare( const std::set<std::pair<wxString, wxString>>& aPairs )
+{
+    if( !m_board || aPairs.empty() )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    updateNets();
+
+    for( const std::pair<wxString, wxString>& pair : aPairs )
+    {
+        auto& toMap = m_preparedPathItems[ pair.first ];
+
+        if( !toMap.count( pair.second ) )
+            cacheFromToPaths( pair.first, pair.second, toMap[ pair.second ] );
+    }
 }
 
 
 void FROM_TO_CACHE::Rebuild( BOARD* aBoard )
 {
+    std::lock_guard<std::mutex> lock( m_lock );
+
     m_board = aBoard;
-    buildEndpointList();
+    m_netsValid = false;
+    m_ftEndpoints.clear();
+    m_ftNets.clear();
+    m_padNodes.clear();
     m_ftPaths.clear();
+    m_pathItems.clear();
+    m_preparedPathItems.clear();
 }
 
 
 FROM_TO_CACHE::FT_PATH* FROM_TO_CACHE::QueryFromToPath( const std::set<BOARD_CONNECTED_ITEM*>& aItems )
 {
+    std::lock_guard<std::mutex> lock( m_lock );
+
     for( auto& ftPath : m_ftPaths )
     {
         if ( ftPath.pathItems == aItems )
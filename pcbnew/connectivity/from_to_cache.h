@@ -20,10 +20,16 @@
 #ifndef __FROM_TO_CACHE_H
 #define __FROM_TO_CACHE_H
 
+#include <deque>
+#include <mutex>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 class D_PAD;
 class BOARD_CONNECTED_ITEM;
+class CN_ITEM;
 
 class FROM_TO_CACHE
 {
@@ -47,6 +53,7 @@ public:
     };
 
     FROM_TO_CACHE( BOARD* aBoard = nullptr ) :
+        m_netsValid( false ),
         m_board( aBoard )
     {
     }
@@ -55,18 +62,82 @@ public:
     {
     }
 
+    /**
+     * Forgets the paths found so far.  The pads and nets of \a aBoard are read again by the
+     * first query, and the connection graph of a net is only reduced when a query needs it,
+     * so boards without fromTo() rules pay next to nothing.
+     */
     void Rebuild( BOARD* aBoard );
+
+    /**
+     * Tells whether an item lies on a path matching a fromTo() rule condition.  The paths of
+     * each pair of wildcards are resolved on first use; later queries are a table lookup.
+     */
     bool IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString& aFrom, const wxString& aTo );
 
+    /**
+     * Resolves the paths of the given (from, to) wildcard pairs up front.  Until the next
+     * Rebuild() queries for them are answered without locking, so that the rule evaluations
+     * of the concurrent DRC providers don't queue up on the cache.
+     */
+    void Prepare( const std::set<std::pair<wxString, wxString>>& aPairs );
+
     FT_PATH* QueryFromToPath( const std::set<BOARD_CONNECTED_ITEM*>& aItems );
 
 private:
 
-    int cacheFromToPaths( const wxString& aFrom, const wxString& aTo );
+    /**
+     * The connection graph of a net, reduced to a spanning forest.  The path between two
+     * nodes of the same tree is found by walking up to their common ancestor, and it is the
+     * only path between them if it crosses no edge that lies on a cycle.
+     */
+    struct FT_NET
+    {
+        std::vector<D_PAD*>   pads;       // the pads are the first nodes, in the same order
+        std::vector<CN_ITEM*> padItems;   // the connectivity items of the pads
+        bool                  built = false;
+        std::vector<CN_ITEM*> nodes;
+        std::vector<int>      parent;     // -1 for the root of a tree
+        std::vector<int>      depth;
+        std::vector<int>      root;
+        std::vector<int>      cycleEdges; // edges on cycles between the node and its root
+    };
+
+    struct FT_PAD_NODE
+    {
+        int net;
+        int node;
+    };
+
+    int cacheFromToPaths( const wxString& aFrom, const wxString& aTo,
+                          std::unordered_set<BOARD_CONNECTED_ITEM*>& aPathItems );
     void buildEndpointList();
+    void buildNets();
+
+    ///> @return the net, with its spanning forest built
+    const FT_NET& getNet( int aIndex );
+
+    ///> Reads the pads and nets of the board if they aren't yet.  Call with m_lock held.
+    void updateNets();
+
+    typedef std::unordered_map<wxString, std::unordered_map<wxString,
+            std::unordered_set<BOARD_CONNECTED_ITEM*>>> PATH_ITEMS_MAP;
 
     std::vector<FT_ENDPOINT> m_ftEndpoints;
-    std::vector<FT_PATH> m_ftPaths;
+    std::deque<FT_PATH> m_ftPaths;     // deque: QueryFromToPath() hands out pointers
+
+    std::vector<FT_NET> m_ftNets;
+    std::unordered_map<D_PAD*, FT_PAD_NODE> m_padNodes;
+    bool m_netsValid;   // m_ftEndpoints, m_ftNets and m_padNodes are of the current board
+
+    // Items on the paths of each fromTo() pair seen so far, including pairs without paths
+    PATH_ITEMS_MAP m_pathItems;
+
+    // The same for the pairs given to Prepare(); only written by Prepare() and Rebuild()
+    PATH_ITEMS_MAP m_preparedPathItems;
+
+    // Paths are resolved lazily from rule evaluation, which may run on several threads
+    std::mutex m_lock;
 
     BOARD* m_board;
 };
@@ -30,6 +30,9 @@
 #include <tool/tool_manager.h>
 #include <tools/selection_tool.h>
 #include <tools/global_edit_tool.h>
+#include <tools/drc_tool.h>
+#include <drc/drc_engine.h>
+#include <advanced_config.h>
 #include "dialog_global_edit_tracks_and_vias_base.h"
 
 // Columns of netclasses grid
@@ -348,8 +351,36 @@ bool DIALOG_GLOBAL_EDIT_TRACKS_AND_VIAS::TransferDataFromWindow()
 
     if( itemsListPicker.GetCount() > 0 )
     {
+        std::shared_ptr<DRC_ENGINE> drcEngine = m_brd->GetDesignSettings().m_DRCEngine;
+
+        // The zone fills and the DRC markers are out of date around both the old and the new
+        // state of the items
+        for( unsigned ii = 0; ii < itemsListPicker.GetCount(); ++ii )
+        {
+            BOARD_ITEM* item = (BOARD_ITEM*) itemsListPicker.GetPickedItem( ii );
+            BOARD_ITEM* image = (BOARD_ITEM*) itemsListPicker.GetPickedItemLink( ii );
+
+            m_brd->MarkZoneFillsDirty( item );
+            m_brd->MarkZoneFillsDirty( image );
+
+            if( drcEngine )
+            {
+                drcEngine->MarkItemDirty( item );
+                drcEngine->MarkItemDirty( image );
+            }
+        }
+
+        // Layer changes may have connected or disconnected items
+        m_brd->GetConnectivity()->RecalculateRatsnest();
+
         m_parent->SaveCopyInUndoList( itemsListPicker, UNDO_REDO::CHANGED );
 
+        if( ADVANCED_CFG::GetCfg().m_IncrementalDrc )
+        {
+            if( DRC_TOOL* drcTool = m_parent->GetToolManager()->GetTool<DRC_TOOL>() )
+                drcTool->ScheduleIncrementalTests();
+        }
+
         for( auto segment : m_brd->Tracks() )
             m_parent->GetCanvas()->GetView()->Update( segment );
     }
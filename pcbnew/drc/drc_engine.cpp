@@ -23,14 +23,26 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <thread>
+#include <future>
+#include <algorithm>
+
 #include <reporter.h>
 #include <widgets/progress_reporter.h>
+#include <connectivity/connectivity_data.h>
+#include <connectivity/from_to_cache.h>
 #include <drc/drc_engine.h>
 #include <drc/drc_rule_parser.h>
 #include <drc/drc_rule.h>
 #include <drc/drc_rule_condition.h>
 #include <drc/drc_test_provider.h>
+#include <drc/drc_rtree.h>
 #include <class_track.h>
+#include <class_module.h>
+#include <class_zone.h>
+#include <hash_eda.h>
+
+#include <wx/regex.h>
 
 void drcPrintDebugMessage( int level, const wxString& msg, const char *function, int line )
 {
@@ -55,14 +67,21 @@ DRC_ENGINE::DRC_ENGINE( BOARD* aBoard, BOARD_DESIGN_SETTINGS *aSettings ) :
     m_schematicNetlist( nullptr ),
     m_rulesValid( false ),
     m_userUnits( EDA_UNITS::MILLIMETRES ),
+    m_errorLimits( DRCE_LAST + 1 ),
     m_testTracksAgainstZones( false ),
     m_reportAllTrackErrors( false ),
     m_testFootprints( false ),
     m_reporter( nullptr ),
-    m_progressReporter( nullptr )
+    m_progressReporter( nullptr ),
+    m_runningConcurrently( false ),
+    m_concurrentPhasesShown( 0 ),
+    m_spareThreads( (int) std::max( std::thread::hardware_concurrency(), 1U ) - 1 ),
+    m_hasBaseline( false ),
+    m_baselineHash( 0 ),
+    m_incrementalRun( false ),
+    m_constraintCacheHits( 0 ),
+    m_constraintCacheMisses( 0 )
 {
-    m_errorLimits.resize( DRCE_LAST + 1 );
-
     for( int ii = DRCE_FIRST; ii <= DRCE_LAST; ++ii )
         m_errorLimits[ ii ] = INT_MAX;
 }
@@ -601,6 +620,10 @@ void DRC_ENGINE::InitEngine( const wxFileName& aRulePath )
 
     m_constraintMap.clear();
 
+    // Markers from a different rule set can't be updated incrementally, which
+    // CanRunIncrementally() checks for (reloading the same rules is fine)
+    ClearConstraintCache();
+
     try         // attempt to load full set of rules (implicit + user rules)
     {
         loadImplicitRules();
@@ -634,6 +657,14 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aTestTracksAgainstZones,
 {
     m_userUnits = aUnits;
 
+    // A full run replaces all markers, so whatever was dirty is now covered
+    if( !m_incrementalRun )
+        clearDirtyItems();
+
+    // The board may have changed since the last run
+    m_boardShapeIndex.reset();
+    m_scopedShapeIndex.reset();
+
     // Note: set these first.  The phase counts may be dependent on some of them.
     m_testTracksAgainstZones = aTestTracksAgainstZones;
     m_reportAllTrackErrors = aReportAllTrackErrors;
@@ -660,29 +691,521 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aTestTracksAgainstZones,
             m_errorLimits[ ii ] = INT_MAX;
     }
 
+    // Nets and netclasses may have been edited since the last run
+    ClearConstraintCache();
+
+    // Update and cache bounding boxes, courtyards and pad effective shapes so that we don't
+    // have to make them thread-safe.  What is out of the scope of an incremental run hasn't
+    // changed since the last run.
     for( ZONE_CONTAINER* zone : m_board->Zones() )
-        zone->CacheBoundingBox();
+    {
+        if( IsInTestScope( zone ) )
+            zone->CacheBoundingBox();
+    }
 
     for( MODULE* module : m_board->Modules() )
     {
+        if( !IsInTestScope( module ) )
+            continue;
+
         for( ZONE_CONTAINER* zone : module->Zones() )
             zone->CacheBoundingBox();
 
+        for( D_PAD* pad : module->Pads() )
+        {
+            if( pad->IsDirty() )
+                pad->BuildEffectiveShapes( UNDEFINED_LAYER );
+        }
+
         module->BuildPolyCourtyards();
+        module->GetPolyCourtyardFront().BuildBBoxCaches();
+        module->GetPolyCourtyardBack().BuildBBoxCaches();
     }
 
+    std::vector<DRC_TEST_PROVIDER*> exclusiveProviders;
+    std::vector<DRC_TEST_PROVIDER*> concurrentProviders;
+
+    m_pendingViolations.clear();
+
     for( DRC_TEST_PROVIDER* provider : m_testProviders )
     {
         if( !provider->IsEnabled() )
             continue;
 
+        m_pendingViolations[ provider ] = std::vector<PENDING_VIOLATION>();
+
+        if( provider->CanRunConcurrently() )
+            concurrentProviders.push_back( provider );
+        else
+            exclusiveProviders.push_back( provider );
+    }
+
+    bool keepGoing = true;
+
+    // Providers which modify shared board state (such as the connectivity) go first, one at
+    // a time, so that the concurrent ones see a stable board.
+    for( DRC_TEST_PROVIDER* provider : exclusiveProviders )
+    {
         drc_dbg( 0, "Running test provider: '%s'\n", provider->GetName() );
 
         ReportAux( wxString::Format( "Run DRC provider: '%s'", provider->GetName() ) );
 
         if( !provider->Run() )
+        {
+            keepGoing = false;
             break;
+        }
+    }
+
+    if( keepGoing )
+    {
+        // The from-to cache is shared by all rule conditions using fromTo(); rebuild it once
+        // here rather than from the individual providers, and resolve the paths the rules ask
+        // for so that the providers can query it without locking.
+        std::shared_ptr<FROM_TO_CACHE> ftCache = m_board->GetConnectivity()->GetFromToCache();
+
+        ftCache->Rebuild( m_board );
+        ftCache->Prepare( fromToPairs() );
+
+        keepGoing = runConcurrentProviders( concurrentProviders );
+    }
+
+    // Hand the violations over in provider order so that the resulting markers don't depend
+    // on thread scheduling.
+    for( DRC_TEST_PROVIDER* provider : m_testProviders )
+    {
+        auto it = m_pendingViolations.find( provider );
+
+        if( it == m_pendingViolations.end() )
+            continue;
+
+        for( const PENDING_VIOLATION& violation : it->second )
+            dispatchViolation( violation.item, violation.pos );
+    }
+
+    m_pendingViolations.clear();
+    m_boardShapeIndex.reset();
+    m_scopedShapeIndex.reset();
+
+    // An interrupted run leaves markers missing, so the next one has to be a full run
+    m_hasBaseline = keepGoing;
+    m_baselineHash = baselineHash();
+
+    ReportAux( wxString::Format( "Constraint cache: %d hits, %d misses",
+                                 (int) m_constraintCacheHits,
+                                 (int) m_constraintCacheMisses ) );
+}
+
+
+std::set<std::pair<wxString, wxString>> DRC_ENGINE::fromToPairs() const
+{
+    std::set<std::pair<wxString, wxString>> pairs;
+
+    // The arguments of fromTo() are string literals (see PCB_EXPR_BUILTIN_FUNCTIONS)
+    wxRegEx fromTo( wxT( "fromTo\\(\\s*'([^']*)'\\s*,\\s*'([^']*)'\\s*\\)" ),
+                    wxRE_ADVANCED | wxRE_ICASE );
+
+    for( DRC_RULE* rule : m_rules )
+    {
+        if( !rule->m_Condition )
+            continue;
+
+        wxString expr = rule->m_Condition->GetExpression();
+        size_t   start, len;
+
+        while( fromTo.Matches( expr ) )
+        {
+            pairs.emplace( fromTo.GetMatch( expr, 1 ), fromTo.GetMatch( expr, 2 ) );
+            fromTo.GetMatch( &start, &len, 0 );
+            expr = expr.Mid( start + len );
+        }
+    }
+
+    return pairs;
+}
+
+
+DRC_RTREE* DRC_ENGINE::GetBoardShapeIndex( bool aWholeBoard )
+{
+    std::lock_guard<std::mutex> lock( m_boardShapeIndexLock );
+
+    // Outside of incremental runs the test scope is the whole board
+    bool                        scoped = m_incrementalRun && !aWholeBoard;
+    std::unique_ptr<DRC_RTREE>& index = scoped ? m_scopedShapeIndex : m_boardShapeIndex;
+
+    if( index )
+        return index.get();
+
+    std::vector<BOARD_ITEM*> items;
+
+    auto addItem =
+            [&]( BOARD_ITEM* aItem )
+            {
+                if( !scoped || IsInTestScope( aItem ) )
+                    items.push_back( aItem );
+            };
+
+    for( TRACK* track : m_board->Tracks() )
+        addItem( track );
+
+    for( BOARD_ITEM* item : m_board->Drawings() )
+        addItem( item );
+
+    for( ZONE_CONTAINER* zone : m_board->Zones() )
+        addItem( zone );
+
+    for( MODULE* module : m_board->Modules() )
+    {
+        if( scoped && !IsInTestScope( module ) )
+            continue;
+
+        addItem( &module->Reference() );
+        addItem( &module->Value() );
+
+        for( D_PAD* pad : module->Pads() )
+            addItem( pad );
+
+        for( BOARD_ITEM* item : module->GraphicalItems() )
+            addItem( item );
+
+        for( MODULE_ZONE_CONTAINER* zone : module->Zones() )
+            addItem( zone );
+    }
+
+    index = std::make_unique<DRC_RTREE>();
+    index->BulkLoad( items );
+
+    ReportAux( wxString::Format( "Indexed %d board items (%d shapes).",
+                                 (int) items.size(),
+                                 (int) index->size() ) );
+
+    return index.get();
+}
+
+
+thread_local DRC_ENGINE::PROVIDER_PROGRESS* DRC_ENGINE::s_providerProgress = nullptr;
+
+
+bool DRC_ENGINE::runConcurrentProviders( const std::vector<DRC_TEST_PROVIDER*>& aProviders )
+{
+    std::vector<DRC_TEST_PROVIDER*> queue( aProviders );
+    std::vector<PROVIDER_PROGRESS>  progress( queue.size() );
+    std::atomic<size_t>             nextProvider( 0 );
+    std::atomic<bool>               cancelled( false );
+
+    for( PROVIDER_PROGRESS& slot : progress )
+    {
+        slot.phases = 0;
+        slot.progress = 0;
+    }
+
+    // Start the providers with the most phases first; they're generally the most expensive
+    // and we don't want them to be left running on their own at the end.
+    std::stable_sort( queue.begin(), queue.end(),
+                      []( const DRC_TEST_PROVIDER* lhs, const DRC_TEST_PROVIDER* rhs )
+                      {
+                          return lhs->GetNumPhases() > rhs->GetNumPhases();
+                      } );
+
+    auto run_lambda =
+            [&]() -> size_t
+            {
+                size_t num = 0;
+
+                for( size_t i = nextProvider++; i < queue.size(); i = nextProvider++ )
+                {
+                    if( cancelled )
+                        break;
+
+                    DRC_TEST_PROVIDER* provider = queue[i];
+
+                    drc_dbg( 0, "Running test provider: '%s'\n", provider->GetName() );
+
+                    ReportAux( wxString::Format( "Run DRC provider: '%s'", provider->GetName() ) );
+
+                    s_providerProgress = &progress[i];
+
+                    if( !provider->Run() )
+                        cancelled = true;
+
+                    // Its phases are done; don't count the last one twice
+                    progress[i].progress = 0;
+                    s_providerProgress = nullptr;
+
+                    num++;
+                }
+
+                return num;
+            };
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   queue.size() );
+
+    if( parallelThreadCount <= 1 )
+    {
+        run_lambda();
     }
+    else
+    {
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        m_runningConcurrently = true;
+        m_concurrentPhasesShown = 0;
+
+        // The calling thread only waits: its thread goes to the first worker.  A worker with
+        // no provider left hands its thread to the loops of the providers still running.
+        m_spareThreads -= (int) parallelThreadCount - 1;
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            returns[ii] = std::async( std::launch::async,
+                                      [&]() -> size_t
+                                      {
+                                          size_t num = run_lambda();
+                                          ReleaseThreads( 1 );
+                                          return num;
+                                      } );
+        }
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            // Here we balance returns with a 100ms timeout to allow UI updating
+            std::future_status status;
+            do
+            {
+                if( m_progressReporter )
+                {
+                    updateConcurrentProgress( progress );
+                    m_progressReporter->KeepRefreshing();
+                }
+
+                status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+            } while( status != std::future_status::ready );
+        }
+
+        if( m_progressReporter )
+            updateConcurrentProgress( progress );
+
+        m_runningConcurrently = false;
+
+        // Back on the calling thread
+        m_spareThreads -= 1;
+    }
+
+    return !cancelled;
+}
+
+
+void DRC_ENGINE::updateConcurrentProgress( std::vector<PROVIDER_PROGRESS>& aProgress )
+{
+    int phases = 0;
+    int progress = 0;
+
+    for( const PROVIDER_PROGRESS& slot : aProgress )
+    {
+        phases += slot.phases;
+        progress += slot.progress;
+    }
+
+    phases += progress / 1000;
+    progress %= 1000;
+
+    for( ; m_concurrentPhasesShown < phases; ++m_concurrentPhasesShown )
+        m_progressReporter->AdvancePhase();
+
+    m_progressReporter->SetCurrentProgress( progress / 1000.0 );
+}
+
+
+size_t DRC_ENGINE::AcquireThreads( size_t aCount )
+{
+    int spare = m_spareThreads;
+    int granted = 0;
+
+    do
+    {
+        granted = std::max( 0, std::min( spare, (int) aCount ) );
+    } while( granted > 0 && !m_spareThreads.compare_exchange_weak( spare, spare - granted ) );
+
+    return granted;
+}
+
+
+void DRC_ENGINE::ReleaseThreads( size_t aCount )
+{
+    m_spareThreads += (int) aCount;
+}
+
+
+bool DRC_ENGINE::CanRunIncrementally() const
+{
+    return m_hasBaseline && m_rulesValid && baselineHash() == m_baselineHash;
+}
+
+
+void DRC_ENGINE::DiscardBaseline()
+{
+    clearDirtyItems();
+    m_hasBaseline = false;
+}
+
+
+bool DRC_ENGINE::RunIncrementalTests( EDA_UNITS aUnits, bool aTestTracksAgainstZones,
+                                      bool aReportAllTrackErrors )
+{
+    if( !CanRunIncrementally() )
+        return false;
+
+    if( m_dirtyItems.empty() )
+        return true;
+
+    // Anything further away from a dirty item than the worst-case clearance can't have
+    // gained or lost a violation with it.
+    int worstClearance = 0;
+
+    for( DRC_CONSTRAINT_TYPE_T type : { DRC_CONSTRAINT_TYPE_CLEARANCE,
+                                        DRC_CONSTRAINT_TYPE_HOLE_CLEARANCE,
+                                        DRC_CONSTRAINT_TYPE_EDGE_CLEARANCE,
+                                        DRC_CONSTRAINT_TYPE_COURTYARD_CLEARANCE,
+                                        DRC_CONSTRAINT_TYPE_SILK_CLEARANCE } )
+    {
+        DRC_CONSTRAINT constraint;
+
+        if( QueryWorstConstraint( type, constraint, DRCCQ_LARGEST_MINIMUM ) )
+            worstClearance = std::max( worstClearance, constraint.GetValue().Min() );
+    }
+
+    m_testScope.clear();
+    m_testScopeBBox = EDA_RECT();
+
+    for( EDA_RECT area : m_dirtyAreas )
+    {
+        area.Normalize();
+        area.Inflate( worstClearance + 1 );
+
+        m_testScope.push_back( area );
+        m_testScopeBBox.Merge( area );
+    }
+
+    ReportAux( wxString::Format( "Incremental run: %d dirty items, worst clearance %d nm",
+                                 (int) m_dirtyItems.size(),
+                                 worstClearance ) );
+
+    m_incrementalRun = true;
+
+    // Footprint (schematic parity) tests always need the whole board
+    RunTests( aUnits, aTestTracksAgainstZones, aReportAllTrackErrors, false );
+
+    m_incrementalRun = false;
+    m_testScope.clear();
+    clearDirtyItems();
+
+    return true;
+}
+
+
+void DRC_ENGINE::MarkItemDirty( const BOARD_ITEM* aItem )
+{
+    // Beyond this many changes it's cheaper to just run the whole thing again
+    const size_t maxDirtyAreas = 1000;
+
+    // Markers are our own output; nets and groups have no geometry of their own
+    if( !m_hasBaseline || !aItem || aItem->Type() == PCB_MARKER_T
+            || aItem->Type() == PCB_NETINFO_T || aItem->Type() == PCB_GROUP_T )
+    {
+        return;
+    }
+
+    if( m_dirtyAreas.size() >= maxDirtyAreas )
+    {
+        DiscardBaseline();
+        return;
+    }
+
+    auto markNet =
+            [&]( const BOARD_ITEM* aChanged )
+            {
+                if( aChanged->IsConnected() )
+                {
+                    m_dirtyNets.insert(
+                            static_cast<const BOARD_CONNECTED_ITEM*>( aChanged )->GetNetCode() );
+                }
+            };
+
+    m_dirtyItems.insert( aItem->m_Uuid );
+    m_dirtyAreas.push_back( aItem->GetBoundingBox() );
+    markNet( aItem );
+
+    if( aItem->Type() == PCB_MODULE_T )
+    {
+        static_cast<const MODULE*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    m_dirtyItems.insert( aChild->m_Uuid );
+                    markNet( aChild );
+                } );
+    }
+}
+
+
+bool DRC_ENGINE::IsInTestScope( const BOARD_ITEM* aItem ) const
+{
+    if( !m_incrementalRun )
+        return true;
+
+    EDA_RECT bbox = aItem->GetBoundingBox();
+
+    bbox.Normalize();
+
+    if( !m_testScopeBBox.Intersects( bbox ) )
+        return false;
+
+    for( const EDA_RECT& area : m_testScope )
+    {
+        if( area.Intersects( bbox ) )
+            return true;
+    }
+
+    return false;
+}
+
+
+bool DRC_ENGINE::IsNetInTestScope( int aNetCode ) const
+{
+    return !m_incrementalRun || m_dirtyNets.count( aNetCode ) > 0;
+}
+
+
+bool DRC_ENGINE::involvesDirtyItem( const std::shared_ptr<DRC_ITEM>& aItem ) const
+{
+    return IsDirtyItem( aItem->GetMainItemID() ) || IsDirtyItem( aItem->GetAuxItemID() )
+            || IsDirtyItem( aItem->GetAuxItem2ID() ) || IsDirtyItem( aItem->GetAuxItem3ID() );
+}
+
+
+void DRC_ENGINE::clearDirtyItems()
+{
+    m_dirtyItems.clear();
+    m_dirtyNets.clear();
+    m_dirtyAreas.clear();
+}
+
+
+std::size_t DRC_ENGINE::CONSTRAINT_CACHE_KEY_HASH::operator()(
+        const CONSTRAINT_CACHE_KEY& aKey ) const
+{
+    return hash_val( (int) aKey.constraintType, (int) aKey.typeA, (int) aKey.typeB, aKey.netA,
+                     aKey.netB, (int) aKey.layer );
+}
+
+
+void DRC_ENGINE::ClearConstraintCache()
+{
+    std::lock_guard<std::mutex> lock( m_constraintCacheLock );
+
+    m_constraintCache.clear();
+    m_constraintCacheHits = 0;
+    m_constraintCacheMisses = 0;
 }
 
 
@@ -714,6 +1237,7 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRulesForItems( DRC_CONSTRAINT_TYPE_T aConstraintI
     const BOARD_CONNECTED_ITEM* connectedB = dynamic_cast<const BOARD_CONNECTED_ITEM*>( b );
     const DRC_CONSTRAINT*       constraintRef = nullptr;
     bool                        implicit = false;
+    wxString                    source;
 
     // Local overrides take precedence
     if( aConstraintId == DRC_CONSTRAINT_TYPE_CLEARANCE )
@@ -723,7 +1247,7 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRulesForItems( DRC_CONSTRAINT_TYPE_T aConstraintI
 
         if( connectedA && connectedA->GetLocalClearanceOverrides( nullptr ) > 0 )
         {
-            overrideA = connectedA->GetLocalClearanceOverrides( &m_msg );
+            overrideA = connectedA->GetLocalClearanceOverrides( &source );
 
             REPORT( "" )
             REPORT( wxString::Format( _( "Local override on %s; clearance: %s." ),
@@ -733,7 +1257,7 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRulesForItems( DRC_CONSTRAINT_TYPE_T aConstraintI
 
         if( connectedB && connectedB->GetLocalClearanceOverrides( nullptr ) > 0 )
         {
-            overrideB = connectedB->GetLocalClearanceOverrides( &m_msg );
+            overrideB = connectedB->GetLocalClearanceOverrides( &source );
 
             REPORT( "" )
             REPORT( wxString::Format( _( "Local override on %s; clearance: %s." ),
@@ -743,7 +1267,7 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRulesForItems( DRC_CONSTRAINT_TYPE_T aConstraintI
 
         if( overrideA || overrideB )
         {
-            DRC_CONSTRAINT constraint( DRC_CONSTRAINT_TYPE_CLEARANCE, m_msg );
+            DRC_CONSTRAINT constraint( DRC_CONSTRAINT_TYPE_CLEARANCE, source );
             constraint.m_Value.SetMin( std::max( overrideA, overrideB ) );
             return constraint;
         }
@@ -931,9 +1455,11 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRulesForItems( DRC_CONSTRAINT_TYPE_T aConstraintI
                 }
             };
 
-    if( m_constraintMap.count( aConstraintId ) )
+    auto ruleIt = m_constraintMap.find( aConstraintId );
+
+    if( ruleIt != m_constraintMap.end() )
     {
-        std::vector<CONSTRAINT_WITH_CONDITIONS*>* ruleset = m_constraintMap[ aConstraintId ];
+        std::vector<CONSTRAINT_WITH_CONDITIONS*>* ruleset = ruleIt->second;
 
         if( aReporter )
         {
@@ -943,6 +1469,71 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRulesForItems( DRC_CONSTRAINT_TYPE_T aConstraintI
                 processConstraint( ruleset->at( ii ) );
             }
         }
+        else if( aConstraintId != DRC_CONSTRAINT_TYPE_DISALLOW
+                    && !isKeepoutZone( a ) && !isKeepoutZone( b ) )
+        {
+            // Disallow constraints and keepout zones depend on item properties which aren't
+            // part of the cache key; everything else can be memoized as long as the rule
+            // conditions only look at item types, nets and netclasses.
+            CONSTRAINT_CACHE_KEY key = { aConstraintId,
+                                         a->Type(),
+                                         b ? b->Type() : NOT_USED,
+                                         connectedA ? connectedA->GetNetCode() : -1,
+                                         connectedB ? connectedB->GetNetCode() : -1,
+                                         aLayer };
+
+            CONSTRAINT_WITH_CONDITIONS* winner = nullptr;
+            bool                        found = false;
+
+            {
+                std::lock_guard<std::mutex> lock( m_constraintCacheLock );
+                auto                        it = m_constraintCache.find( key );
+
+                if( it != m_constraintCache.end() )
+                {
+                    winner = it->second;
+                    found = true;
+                }
+            }
+
+            if( found )
+            {
+                m_constraintCacheHits++;
+
+                if( winner )
+                {
+                    implicit = winner->parentRule && winner->parentRule->m_Implicit;
+                    constraintRef = &winner->constraint;
+                }
+            }
+            else
+            {
+                bool cacheable = true;
+
+                m_constraintCacheMisses++;
+
+                // Last matching rule wins, so process in reverse order and quit when match found
+                for( int ii = (int) ruleset->size() - 1; ii >= 0; --ii )
+                {
+                    CONSTRAINT_WITH_CONDITIONS* c = ruleset->at( ii );
+
+                    if( c->condition && !c->condition->IsCacheable() )
+                        cacheable = false;
+
+                    if( processConstraint( c ) )
+                    {
+                        winner = c;
+                        break;
+                    }
+                }
+
+                if( cacheable )
+                {
+                    std::lock_guard<std::mutex> lock( m_constraintCacheLock );
+                    m_constraintCache[ key ] = winner;
+                }
+            }
+        }
         else
         {
             // Last matching rule wins, so process in reverse order and quit when match found
@@ -972,7 +1563,7 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRulesForItems( DRC_CONSTRAINT_TYPE_T aConstraintI
                                       MessageTextFromValue( UNITS, localA ) ) )
 
             if( localA > clearance )
-                clearance = connectedA->GetLocalClearance( &m_msg );
+                clearance = connectedA->GetLocalClearance( &source );
         }
 
         if( localB > 0 )
@@ -983,12 +1574,12 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRulesForItems( DRC_CONSTRAINT_TYPE_T aConstraintI
                                       MessageTextFromValue( UNITS, localB ) ) )
 
             if( localB > clearance )
-                clearance = connectedB->GetLocalClearance( &m_msg );
+                clearance = connectedB->GetLocalClearance( &source );
         }
 
         if( localA > global || localB > global )
         {
-            DRC_CONSTRAINT constraint( DRC_CONSTRAINT_TYPE_CLEARANCE, m_msg );
+            DRC_CONSTRAINT constraint( DRC_CONSTRAINT_TYPE_CLEARANCE, source );
             constraint.m_Value.SetMin( clearance );
             return constraint;
         }
@@ -996,10 +1587,7 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRulesForItems( DRC_CONSTRAINT_TYPE_T aConstraintI
 
     // fixme: return optional<drc_constraint>, let the particular test decide what to do if no matching constraint
     // is found
-    static DRC_CONSTRAINT nullConstraint( DRC_CONSTRAINT_TYPE_NULL );
-    nullConstraint.m_DisallowFlags = 0;
-
-    return constraintRef ? *constraintRef : nullConstraint;
+    return constraintRef ? *constraintRef : DRC_CONSTRAINT( DRC_CONSTRAINT_TYPE_NULL );
 
 #undef REPORT
 #undef UNITS
@@ -1015,8 +1603,39 @@ bool DRC_ENGINE::IsErrorLimitExceeded( int error_code )
 
 void DRC_ENGINE::ReportViolation( const std::shared_ptr<DRC_ITEM>& aItem, wxPoint aPos )
 {
+    if( AccountViolation( aItem ) )
+        ReportAccountedViolation( aItem, aPos );
+}
+
+
+bool DRC_ENGINE::AccountViolation( const std::shared_ptr<DRC_ITEM>& aItem )
+{
+    // Violations between untouched items are still covered by their existing markers.  The
+    // unconnected items are all reported again (see RunIncrementalTests()).
+    if( m_incrementalRun && aItem->GetErrorCode() != DRCE_UNCONNECTED_ITEMS
+            && !involvesDirtyItem( aItem ) )
+    {
+        return false;
+    }
+
     m_errorLimits[ aItem->GetErrorCode() ] -= 1;
+    return true;
+}
 
+
+void DRC_ENGINE::ReportAccountedViolation( const std::shared_ptr<DRC_ITEM>& aItem, wxPoint aPos )
+{
+    auto it = m_pendingViolations.find( aItem->GetViolatingTest() );
+
+    if( it != m_pendingViolations.end() )
+        it->second.push_back( { aItem, aPos } );
+    else
+        dispatchViolation( aItem, aPos );
+}
+
+
+void DRC_ENGINE::dispatchViolation( const std::shared_ptr<DRC_ITEM>& aItem, wxPoint aPos )
+{
     if( m_violationHandler )
         m_violationHandler( aItem, aPos );
 
@@ -1047,16 +1666,34 @@ void DRC_ENGINE::ReportAux ( const wxString& aStr )
     if( !m_reporter )
         return;
 
+    std::lock_guard<std::mutex> lock( m_reporterLock );
     m_reporter->Report( aStr, RPT_SEVERITY_INFO );
 }
 
 
+bool DRC_ENGINE::IsCancelled() const
+{
+    return m_progressReporter && m_progressReporter->IsCancelled();
+}
+
+
 bool DRC_ENGINE::ReportProgress( double aProgress )
 {
     if( !m_progressReporter )
         return true;
 
+    // KeepRefreshing() may only be called from the main thread, which shows the progress of
+    // all the concurrent providers (see updateConcurrentProgress())
+    if( m_runningConcurrently )
+    {
+        if( s_providerProgress )
+            s_providerProgress->progress = std::min( (int) ( aProgress * 1000.0 ), 1000 );
+
+        return !m_progressReporter->IsCancelled();
+    }
+
     m_progressReporter->SetCurrentProgress( aProgress );
+
     return m_progressReporter->KeepRefreshing( false );
 }
 
@@ -1066,7 +1703,20 @@ bool DRC_ENGINE::ReportPhase( const wxString& aMessage )
     if( !m_progressReporter )
         return true;
 
+    if( m_runningConcurrently )
+    {
+        if( s_providerProgress )
+        {
+            s_providerProgress->phases++;
+            s_providerProgress->progress = 0;
+        }
+
+        m_progressReporter->Report( aMessage );
+        return !m_progressReporter->IsCancelled();
+    }
+
     m_progressReporter->AdvancePhase( aMessage );
+
     return m_progressReporter->KeepRefreshing( false );
 }
 
@@ -1106,6 +1756,62 @@ std::vector<DRC_CONSTRAINT> DRC_ENGINE::QueryConstraintsById( DRC_CONSTRAINT_TYP
 }
 
 
+size_t DRC_ENGINE::GetRulesHash() const
+{
+    size_t hash = 0;
+
+    for( const DRC_RULE* rule : m_rules )
+    {
+        hash_combine( hash, rule->m_Name, rule->m_Unary,
+                      static_cast<const BASE_SET&>( rule->m_LayerCondition ) );
+
+        if( rule->m_Condition )
+            hash_combine( hash, rule->m_Condition->GetExpression() );
+
+        for( const DRC_CONSTRAINT& constraint : rule->m_Constraints )
+        {
+            const MINOPTMAX<int>& value = constraint.GetValue();
+
+            hash_combine( hash, constraint.m_Type, constraint.m_DisallowFlags,
+                          value.HasMin() ? value.Min() : INT_MIN,
+                          value.HasOpt() ? value.Opt() : INT_MIN,
+                          value.HasMax() ? value.Max() : INT_MIN );
+        }
+    }
+
+    // The netclass rules only look up which nets are in a netclass when they're evaluated
+    auto hashNetclass =
+            [&]( const NETCLASSPTR& aNetclass )
+            {
+                hash_combine( hash, aNetclass->GetName() );
+
+                for( const wxString& netname : *aNetclass )
+                    hash_combine( hash, netname );
+            };
+
+    hashNetclass( m_designSettings->GetNetClasses().GetDefault() );
+
+    for( const std::pair<const wxString, NETCLASSPTR>& netclass :
+            m_designSettings->GetNetClasses().NetClasses() )
+    {
+        hashNetclass( netclass.second );
+    }
+
+    return hash;
+}
+
+
+size_t DRC_ENGINE::baselineHash() const
+{
+    size_t hash = GetRulesHash();
+
+    for( const std::pair<const int, int>& severity : m_designSettings->m_DRCSeverities )
+        hash_combine( hash, severity.first, severity.second );
+
+    return hash;
+}
+
+
 bool DRC_ENGINE::HasRulesForConstraintType( DRC_CONSTRAINT_TYPE_T constraintID )
 {
     //drc_dbg(10,"hascorrect id %d size %d\n", ruleID,  m_ruleMap[ruleID]->sortedRules.size( ) );
@@ -1116,6 +1822,23 @@ bool DRC_ENGINE::HasRulesForConstraintType( DRC_CONSTRAINT_TYPE_T constraintID )
 }
 
 
+bool DRC_ENGINE::HasOnlyCacheableRules( DRC_CONSTRAINT_TYPE_T aConstraintId )
+{
+    auto ruleIt = m_constraintMap.find( aConstraintId );
+
+    if( ruleIt == m_constraintMap.end() )
+        return true;
+
+    for( CONSTRAINT_WITH_CONDITIONS* c : *ruleIt->second )
+    {
+        if( c->condition && !c->condition->IsCacheable() )
+            return false;
+    }
+
+    return true;
+}
+
+
 bool DRC_ENGINE::QueryWorstConstraint( DRC_CONSTRAINT_TYPE_T aConstraintId,
                                        DRC_CONSTRAINT& aConstraint,
                                        DRC_CONSTRAINT_QUERY_T aQueryType )
@@ -24,15 +24,21 @@
 #ifndef DRC_ENGINE_H
 #define DRC_ENGINE_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <vector>
 #include <unordered_map>
 
+#include <eda_rect.h>
+#include <kiid.h>
 #include <drc/drc_rule.h>
 
 
 class BOARD_DESIGN_SETTINGS;
 class DRC_TEST_PROVIDER;
+class DRC_RTREE;
 class PCB_EDIT_FRAME;
 class BOARD_ITEM;
 class BOARD;
@@ -140,6 +146,11 @@ public:
 
     /**
      * Runs the DRC tests.
+     *
+     * Providers which report CanRunConcurrently() are run in parallel on a set of worker
+     * threads; violations are buffered per provider and handed to the violation handler on
+     * the calling thread, in provider order, once all providers have finished.
+     *
      * @param aUnits
      * @param aTestTracksAgainstZones
      * @param aReportAllTrackErrors
@@ -149,6 +160,59 @@ public:
                    bool aReportAllTrackErrors = true, bool aTestFootprints = true );
 
 
+    /**
+     * Records an item added, modified or removed by a commit so that the next call to
+     * RunIncrementalTests() re-tests it.  Modified items should be passed both in their old
+     * and their new state.  Does nothing until a full run has been completed.
+     */
+    void MarkItemDirty( const BOARD_ITEM* aItem );
+
+    /**
+     * Returns true if the markers of the last full run can be brought up to date by
+     * RunIncrementalTests().  Rule, netclass or severity changes, cancelled runs and very
+     * large sets of changes require a full run.
+     */
+    bool CanRunIncrementally() const;
+
+    /**
+     * Forgets the markers of the last full run, for when the board has been changed without
+     * the changes being passed to MarkItemDirty() (e.g.\ by a script).  The next run then has
+     * to be a full one.
+     */
+    void DiscardBaseline();
+
+    /**
+     * Re-runs the tests for the items marked dirty since the last run.  Only the dirty items
+     * and their neighbours within the worst-case clearance are tested, and only violations
+     * involving a dirty item are reported.  The caller is expected to remove the existing
+     * markers of the dirty items (see IsDirtyItem()) beforehand.
+     *
+     * The unconnected items are the exception: the connectivity is kept up to date by the
+     * commits, so they are all reported again from its ratsnest.
+     *
+     * @return false if a full run is needed instead.
+     */
+    bool RunIncrementalTests( EDA_UNITS aUnits = EDA_UNITS::MILLIMETRES,
+                              bool aTestTracksAgainstZones = true,
+                              bool aReportAllTrackErrors = true );
+
+    bool IsDirtyItem( const KIID& aId ) const { return m_dirtyItems.count( aId ) > 0; }
+    bool HasDirtyItems() const { return !m_dirtyItems.empty(); }
+
+    /**
+     * Returns false if aItem can be skipped by the current (incremental) run because it is
+     * too far away from any of the dirty items to be affected by them.
+     */
+    bool IsInTestScope( const BOARD_ITEM* aItem ) const;
+
+    /**
+     * Returns false if the items of net aNetCode can be skipped by the current (incremental)
+     * run because none of the dirty items belongs to it.  For the tests of whole nets.
+     */
+    bool IsNetInTestScope( int aNetCode ) const;
+
+    bool IsIncrementalRun() const { return m_incrementalRun; }
+
     bool IsErrorLimitExceeded( int error_code );
 
     DRC_CONSTRAINT EvalRulesForItems( DRC_CONSTRAINT_TYPE_T ruleID, const BOARD_ITEM* a,
@@ -160,6 +224,37 @@ public:
 
     bool HasRulesForConstraintType( DRC_CONSTRAINT_TYPE_T constraintID );
 
+    /**
+     * @return true if the rules for aConstraintId only depend on the types, nets and netclasses
+     * of the items and on the layer, so that their resolutions can be memoized.
+     */
+    bool HasOnlyCacheableRules( DRC_CONSTRAINT_TYPE_T aConstraintId );
+
+    /**
+     * Forgets all memoized rule resolutions.  Must be called whenever the board's nets or
+     * netclass assignments change; rule reloads and RunTests() take care of it themselves.
+     */
+    void ClearConstraintCache();
+
+    /**
+     * Returns the number of EvalRulesForItems() lookups answered from (or missing) the
+     * constraint cache since it was last cleared.
+     */
+    void GetConstraintCacheStats( size_t& aHits, size_t& aMisses ) const
+    {
+        aHits = m_constraintCacheHits;
+        aMisses = m_constraintCacheMisses;
+    }
+
+    /**
+     * Returns a spatial index of the effective shapes of all the board's items (on all their
+     * layers).  It is built on first use during RunTests() and is shared by the providers, so
+     * it must be treated as read-only.
+     *
+     * Incremental runs only index the items in the test scope, unless aWholeBoard is set.
+     */
+    DRC_RTREE* GetBoardShapeIndex( bool aWholeBoard = false );
+
     EDA_UNITS UserUnits() const { return m_userUnits; }
     bool GetTestTracksAgainstZones() const { return m_testTracksAgainstZones; }
     bool GetReportAllTrackErrors() const { return m_reportAllTrackErrors; }
@@ -167,7 +262,41 @@ public:
 
     bool RulesValid() { return m_rulesValid; }
 
+    /**
+     * @return a hash of the loaded rules (implicit and user ones) and of the nets of the
+     * netclasses they refer to.  It changes whenever a rule reload gives different rules.
+     */
+    size_t GetRulesHash() const;
+
+    /**
+     * Reserves up to \a aCount more threads for a provider's own parallel loop.  The threads
+     * of the concurrent providers and those of their loops share one budget of
+     * std::thread::hardware_concurrency(), so a provider only gets the threads that the others
+     * leave idle.
+     *
+     * @return the number of threads granted, which must be given back with ReleaseThreads().
+     */
+    size_t AcquireThreads( size_t aCount );
+    void ReleaseThreads( size_t aCount );
+
     void ReportViolation( const std::shared_ptr<DRC_ITEM>& aItem, wxPoint aPos );
+
+    /**
+     * The two halves of ReportViolation(), for violations found on a worker thread which are
+     * held back to be reported in a reproducible order.  AccountViolation() counts the
+     * violation against its error limit straight away, so that the other threads see it.
+     *
+     * @return false if the violation is filtered out and mustn't be reported.
+     */
+    bool AccountViolation( const std::shared_ptr<DRC_ITEM>& aItem );
+    void ReportAccountedViolation( const std::shared_ptr<DRC_ITEM>& aItem, wxPoint aPos );
+
+    /**
+     * @return true if the user cancelled the run.  Unlike ReportProgress() this may be
+     * called from any thread, including those of a provider's own parallel loop.
+     */
+    bool IsCancelled() const;
+
     bool ReportProgress( double aProgress );
     bool ReportPhase( const wxString& aMessage );
     void ReportAux( const wxString& aStr );
@@ -208,6 +337,79 @@ private:
     void loadTestProviders();
     DRC_RULE* createImplicitRule( const wxString& name );
 
+    /**
+     * Runs the given providers on worker threads, each thread picking up the next waiting
+     * provider as soon as it is done with its current one.
+     *
+     * @return false if a provider was cancelled.
+     */
+    bool runConcurrentProviders( const std::vector<DRC_TEST_PROVIDER*>& aProviders );
+
+    /**
+     * Progress of a provider running concurrently with others: the phases it has started and
+     * its progress (in thousandths) within the current one.
+     */
+    struct PROVIDER_PROGRESS
+    {
+        std::atomic<int> phases;
+        std::atomic<int> progress;
+    };
+
+    /**
+     * Shows the sum of the progress of the concurrent providers.  Each of them reports into
+     * its own slot, as their phases would otherwise make the progress bar jump back and forth.
+     * Must be called from the thread which called RunTests().
+     */
+    void updateConcurrentProgress( std::vector<PROVIDER_PROGRESS>& aProgress );
+
+    // The progress slot of the concurrent provider running on this thread (if any)
+    static thread_local PROVIDER_PROGRESS* s_providerProgress;
+
+    void dispatchViolation( const std::shared_ptr<DRC_ITEM>& aItem, wxPoint aPos );
+
+    bool involvesDirtyItem( const std::shared_ptr<DRC_ITEM>& aItem ) const;
+
+    void clearDirtyItems();
+
+    /// @return GetRulesHash() combined with the severities of the violations
+    size_t baselineHash() const;
+
+    /// @return the (from, to) arguments of the fromTo() calls in the rule conditions
+    std::set<std::pair<wxString, wxString>> fromToPairs() const;
+
+    struct PENDING_VIOLATION
+    {
+        std::shared_ptr<DRC_ITEM> item;
+        wxPoint                   pos;
+    };
+
+    /**
+     * Rule resolutions only depending on the types and nets of the items and on the layer
+     * are memoized under this key.
+     */
+    struct CONSTRAINT_CACHE_KEY
+    {
+        DRC_CONSTRAINT_TYPE_T constraintType;
+        KICAD_T               typeA;
+        KICAD_T               typeB;
+        int                   netA;
+        int                   netB;
+        PCB_LAYER_ID          layer;
+
+        bool operator==( const CONSTRAINT_CACHE_KEY& aOther ) const
+        {
+            return constraintType == aOther.constraintType
+                    && typeA == aOther.typeA && typeB == aOther.typeB
+                    && netA == aOther.netA && netB == aOther.netB
+                    && layer == aOther.layer;
+        }
+    };
+
+    struct CONSTRAINT_CACHE_KEY_HASH
+    {
+        std::size_t operator()( const CONSTRAINT_CACHE_KEY& aKey ) const;
+    };
+
 protected:
     BOARD_DESIGN_SETTINGS*           m_designSettings;
     BOARD*                           m_board;
@@ -219,7 +421,7 @@ protected:
     std::vector<DRC_TEST_PROVIDER*>  m_testProviders;
 
     EDA_UNITS                        m_userUnits;
-    std::vector<int>                 m_errorLimits;
+    std::vector<std::atomic<int>>    m_errorLimits;
     bool                             m_testTracksAgainstZones;
     bool                             m_reportAllTrackErrors;
     bool                             m_testFootprints;
@@ -232,7 +434,42 @@ protected:
     REPORTER*                        m_reporter;
     PROGRESS_REPORTER*               m_progressReporter;
 
-    wxString m_msg;  // Allocating strings gets expensive enough to want to avoid it
+    // Violations held back during RunTests() so that they can be handed to the violation
+    // handler in a reproducible order.  The map is populated before the providers are started
+    // and each vector is only ever written by the thread running its provider.
+    std::unordered_map<const DRC_TEST_PROVIDER*,
+                       std::vector<PENDING_VIOLATION>> m_pendingViolations;
+
+    // Set while providers are running on worker threads (UI refreshes are then left to the
+    // thread which called RunTests()).
+    std::atomic<bool>                m_runningConcurrently;
+    int                              m_concurrentPhasesShown;
+    std::mutex                       m_reporterLock;
+
+    // Threads of the budget that no provider is using (the calling thread has one)
+    std::atomic<int>                 m_spareThreads;
+
+    // Incremental runs: ids and (old and new) areas of the items changed since the last run
+    std::set<KIID>                   m_dirtyItems;
+    std::set<int>                    m_dirtyNets;
+    std::vector<EDA_RECT>            m_dirtyAreas;
+    std::vector<EDA_RECT>            m_testScope;       // m_dirtyAreas inflated by clearance
+    EDA_RECT                         m_testScopeBBox;
+    bool                             m_hasBaseline;     // markers of a full run are in place
+    size_t                           m_baselineHash;    // baselineHash() of that run
+    bool                             m_incrementalRun;
+
+    // Winning rule (or nullptr if none) for each cacheable EvalRulesForItems() query.
+    std::unordered_map<CONSTRAINT_CACHE_KEY, CONSTRAINT_WITH_CONDITIONS*,
+                       CONSTRAINT_CACHE_KEY_HASH> m_constraintCache;
+    std::mutex                       m_constraintCacheLock;
+    std::atomic<size_t>              m_constraintCacheHits;
+    std::atomic<size_t>              m_constraintCacheMisses;
+
+    std::unique_ptr<DRC_RTREE>       m_boardShapeIndex;     // valid for one run only
+    std::unique_ptr<DRC_RTREE>       m_scopedShapeIndex;    // same, for the test scope
+    std::mutex                       m_boardShapeIndexLock;
+
     std::shared_ptr<KIGFX::VIEW_OVERLAY> m_debugOverlay;
 };
 
@@ -29,17 +29,21 @@
 #include <class_board_item.h>
 #include <class_track.h>
 #include <class_zone.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <unordered_set>
 #include <set>
 #include <vector>
 
-#include <geometry/rtree.h>
+#include <geometry/packed_rtree.h>
 #include <math/vector2d.h>
 
 /**
  * DRC_RTREE -
  * Implements an R-tree for fast spatial and layer indexing of connectable items.
- * Non-owning.
+ * Owns its shape records, but not the board items they refer to.
  */
 class DRC_RTREE
 {
@@ -59,35 +63,28 @@ public:
 
 private:
     
-    using drc_rtree = RTree<ITEM_WITH_SHAPE*, int, 2, double>;
+    using drc_rtree = PACKED_RTREE<ITEM_WITH_SHAPE*, 2>;
 
 public:
 
-    DRC_RTREE()
+    DRC_RTREE() :
+            m_count( 0 ),
+            m_stale( false )
     {
-        for( int layer : LSET::AllLayersMask().Seq() )
-            m_tree[layer] = new drc_rtree();
-
-        m_count = 0;
-    }
-
-    ~DRC_RTREE()
-    {
-        for( auto tree : m_tree )
-            delete tree;
     }
 
     /**
      * Function Insert()
      * Inserts an item into the tree. Item's bounding box is taken via its GetBoundingBox() method.
+     * The layer trees are only repacked by the next query, so it is much cheaper to insert all
+     * the items before querying than to alternate between the two.
      */
     void insert( BOARD_ITEM* aItem )
     {
-        std::vector<SHAPE*> subshapes;
-
         for( int layer : aItem->GetLayerSet().Seq() )
         {
             std::shared_ptr<SHAPE> itemShape = aItem->GetEffectiveShape( (PCB_LAYER_ID) layer );
+            std::vector<SHAPE*>    subshapes;
 
             if( itemShape->HasIndexableSubshapes() )
             {
@@ -99,15 +96,38 @@ public:
             }
 
             for( auto subshape : subshapes )
+                addEntry( (PCB_LAYER_ID) layer, aItem, subshape, itemShape );
+        }
+
+        m_stale = true;
+    }
+
+    /**
+     * Function BulkLoad()
+     * Inserts a set of items on the given layers and packs the tree right away, so that it can
+     * be shared between threads.
+     */
+    void BulkLoad( const std::vector<BOARD_ITEM*>& aItems, LSET aLayers = LSET::AllLayersMask() )
+    {
+        for( BOARD_ITEM* item : aItems )
+        {
+            for( PCB_LAYER_ID layer : ( item->GetLayerSet() & aLayers ).Seq() )
             {
-                BOX2I     bbox    = subshape->BBox();
-                const int mmin[2] = { bbox.GetX(), bbox.GetY() };
-                const int mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+                std::shared_ptr<SHAPE> itemShape = item->GetEffectiveShape( layer );
+                std::vector<SHAPE*>    subshapes;
+
+                if( itemShape->HasIndexableSubshapes() )
+                    itemShape->GetIndexableSubshapes( subshapes );
+                else
+                    subshapes.push_back( itemShape.get() );
 
-                m_tree[layer]->Insert( mmin, mmax, new ITEM_WITH_SHAPE( aItem, subshape, itemShape ) );
-                m_count++;
+                for( SHAPE* subshape : subshapes )
+                    addEntry( layer, item, subshape, itemShape );
             }
         }
+
+        m_stale = true;
+        pack();
     }
 
 #if 0
@@ -174,10 +194,15 @@ public:
      */
     void clear()
     {
-        for( auto tree : m_tree )
-            tree->RemoveAll();
+        for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+        {
+            m_tree[layer].Clear();
+            m_pending[layer].clear();
+        }
 
+        m_items.clear();
         m_count = 0;
+        m_stale = false;
     }
 
 #if 0
@@ -242,6 +267,8 @@ public:
                          int aClearance = 0,
                          std::function<bool( BOARD_ITEM*)> aFilter = nullptr ) const
     {
+        pack();
+
         BOX2I box = aRefShape->BBox();
         box.Inflate( aClearance );
 
@@ -267,7 +294,7 @@ public:
                     return true;
                 };
 
-        this->m_tree[aTargetLayer]->Search( min, max, visit );
+        this->m_tree[aTargetLayer].Search( min, max, visit );
         return count > 0;
     }
 
@@ -278,6 +305,8 @@ public:
                         std::function<bool( BOARD_ITEM*, int)> aVisitor = nullptr,
                         int aClearance = 0 ) const
     {
+        pack();
+
         // keep track of BOARD_ITEMs that have been already found to collide (some items
         // might be build of COMPOUND/triangulated shapes and a single subshape collision
         // means we have a hit)
@@ -319,7 +348,7 @@ public:
                     return true;
                 };
 
-        this->m_tree[aTargetLayer]->Search( min, max, visit );
+        this->m_tree[aTargetLayer].Search( min, max, visit );
         return count;
     }
 
@@ -348,6 +377,8 @@ public:
     {
         std::vector< PAIR_INFO > pairsToVisit;
 
+        pack();
+
         for( LAYER_PAIR& refLayerIter : aLayers )
         {
             const PCB_LAYER_ID refLayer = refLayerIter.first;
@@ -372,7 +403,7 @@ public:
                             return true;
                         };
 
-                this->m_tree[targetLayer]->Search( min, max, visit );
+                this->m_tree[targetLayer].Search( min, max, visit );
             };
         }
 
@@ -473,7 +504,7 @@ public:
         return m_count == 0;
     }
 
-    using iterator = typename drc_rtree::Iterator;
+    using iterator = typename std::vector<ITEM_WITH_SHAPE*>::iterator;
 
     /**
      * The DRC_LAYER struct provides a layer-specific auto-range iterator to the RTree.  Using
@@ -485,52 +516,124 @@ public:
      */
     struct DRC_LAYER
     {
-        DRC_LAYER( drc_rtree* aTree ) : layer_tree( aTree )
+        DRC_LAYER( const drc_rtree& aTree )
         {
-            m_rect = { { INT_MIN, INT_MIN }, { INT_MAX, INT_MAX } };
+            m_rect[0] = INT_MIN;
+            m_rect[1] = INT_MIN;
+            m_rect[2] = INT_MAX;
+            m_rect[3] = INT_MAX;
+            collect( aTree );
         };
 
-        DRC_LAYER( drc_rtree* aTree, const EDA_RECT aRect ) : layer_tree( aTree )
+        DRC_LAYER( const drc_rtree& aTree, const EDA_RECT aRect )
         {
-            m_rect = { { aRect.GetX(), aRect.GetY() },
-                       { aRect.GetRight(), aRect.GetBottom() } };
+            m_rect[0] = aRect.GetX();
+            m_rect[1] = aRect.GetY();
+            m_rect[2] = aRect.GetRight();
+            m_rect[3] = aRect.GetBottom();
+            collect( aTree );
         };
 
-        drc_rtree::Rect m_rect;
-        drc_rtree*      layer_tree;
+        int                           m_rect[4];
+        std::vector<ITEM_WITH_SHAPE*> m_items;
 
         iterator begin()
         {
-            return layer_tree->begin( m_rect );
+            return m_items.begin();
         }
 
         iterator end()
         {
-            return layer_tree->end( m_rect );
+            return m_items.end();
+        }
+
+    private:
+        void collect( const drc_rtree& aTree )
+        {
+            auto visit =
+                    [this]( ITEM_WITH_SHAPE* aItem ) -> bool
+                    {
+                        m_items.push_back( aItem );
+                        return true;
+                    };
+
+            aTree.Search( m_rect, m_rect + 2, visit );
         }
     };
 
-    DRC_LAYER OnLayer( PCB_LAYER_ID aLayer )
+    DRC_LAYER OnLayer( PCB_LAYER_ID aLayer ) const
     {
+        pack();
         return DRC_LAYER( m_tree[int( aLayer )] );
     }
 
-    DRC_LAYER Overlapping( PCB_LAYER_ID aLayer, const wxPoint& aPoint, int aAccuracy = 0 )
+    DRC_LAYER Overlapping( PCB_LAYER_ID aLayer, const wxPoint& aPoint, int aAccuracy = 0 ) const
     {
         EDA_RECT rect( aPoint, wxSize( 0, 0 ) );
         rect.Inflate( aAccuracy );
+
+        pack();
         return DRC_LAYER( m_tree[int( aLayer )], rect );
     }
 
-    DRC_LAYER Overlapping( PCB_LAYER_ID aLayer, const EDA_RECT& aRect )
+    DRC_LAYER Overlapping( PCB_LAYER_ID aLayer, const EDA_RECT& aRect ) const
     {
+        pack();
         return DRC_LAYER( m_tree[int( aLayer )], aRect );
     }
 
 
 private:
-    drc_rtree*  m_tree[PCB_LAYER_ID_COUNT];
-    size_t      m_count;
+    void addEntry( PCB_LAYER_ID aLayer, BOARD_ITEM* aItem, SHAPE* aShape,
+                   const std::shared_ptr<SHAPE>& aParentShape )
+    {
+        m_items.emplace_back( aItem, aShape, aParentShape );
+
+        BOX2I            bbox = aShape->BBox();
+        drc_rtree::ENTRY entry = { { bbox.GetX(), bbox.GetY() },
+                                   { bbox.GetRight(), bbox.GetBottom() },
+                                   &m_items.back() };
+
+        m_pending[aLayer].push_back( entry );
+        m_count++;
+    }
+
+    /**
+     * Rebuilds the layer trees which have had items inserted since they were last packed.
+     * Called by all the queries; several threads may do so at once.
+     */
+    void pack() const
+    {
+        if( !m_stale )
+            return;
+
+        std::lock_guard<std::mutex> lock( m_packLock );
+
+        if( !m_stale )
+            return;
+
+        for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+        {
+            if( m_pending[layer].empty() )
+                continue;
+
+            m_tree[layer].GetEntries( m_pending[layer] );
+            m_tree[layer].Build( m_pending[layer] );
+
+            std::vector<drc_rtree::ENTRY>().swap( m_pending[layer] );
+        }
+
+        m_stale = false;
+    }
+
+    size_t                                m_count;
+    std::deque<ITEM_WITH_SHAPE>           m_items;     // arena for the tree entries
+
+    // Entries inserted since the last query are packed into the layer trees by the next one
+    mutable drc_rtree                     m_tree[PCB_LAYER_ID_COUNT];
+    mutable std::vector<drc_rtree::ENTRY> m_pending[PCB_LAYER_ID_COUNT];
+    mutable std::atomic<bool>             m_stale;
+    mutable std::mutex                    m_packLock;
 };
 
 
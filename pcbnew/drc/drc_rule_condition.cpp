@@ -113,3 +113,7 @@ bool DRC_RULE_CONDITION::Compile( REPORTER* aReporter, int aSourceLine, int aSou
 }
 
 
+bool DRC_RULE_CONDITION::IsCacheable() const
+{
+    return !m_ucode || m_ucode->IsCacheable();
+}
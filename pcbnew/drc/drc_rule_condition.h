@@ -43,6 +43,12 @@ public:
 
     bool Compile( REPORTER* aReporter, int aSourceLine = 0, int aSourceOffset = 0 );
 
+    /**
+     * @return true if the result of EvaluateFor() depends only on the types, nets and
+     *         netclasses of the items and on the layer.
+     */
+    bool IsCacheable() const;
+
     void SetExpression( const wxString& aExpression ) { m_expression = aExpression; }
     wxString GetExpression() const { return m_expression; }
 
@@ -26,6 +26,7 @@
 #include <drc/drc_rule_parser.h>
 #include <drc/drc_rule_condition.h>
 #include <drc_rules_lexer.h>
+#include <kicad_string.h>
 #include <pcb_expr_evaluator.h>
 #include <reporter.h>
 
@@ -128,7 +129,7 @@ void DRC_RULES_PARSER::Parse( std::vector<DRC_RULE*>& aRules, REPORTER* aReporte
 
             if( (int) token == DSN_NUMBER )
             {
-                m_requiredVersion = (int)strtol( CurText(), NULL, 10 );
+                m_requiredVersion = (int) StrToLong( CurText(), NULL, 10 );
                 m_tooRecent = ( m_requiredVersion > DRC_RULE_FILE_VERSION );
                 token = NextTok();
             }
@@ -21,6 +21,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <thread>
+#include <future>
+#include <algorithm>
+
 #include <drc/drc_engine.h>
 #include <drc/drc_item.h>
 #include <drc/drc_test_provider.h>
@@ -35,12 +39,47 @@
 std::vector<KICAD_T> DRC_TEST_PROVIDER::s_allBasicItems;
 
 
+namespace
+{
+
+/**
+ * Violations and rule statistics collected by one chunk of forEachIndexInParallel().
+ */
+struct CHUNK_RESULTS
+{
+    std::vector<std::pair<std::shared_ptr<DRC_ITEM>, wxPoint>> violations;
+    std::unordered_map<const DRC_RULE*, int>                   stats;
+};
+
+// The chunk the current thread is working on (if any)
+thread_local CHUNK_RESULTS* s_currentChunk = nullptr;
+
+}
+
+
 DRC_TEST_PROVIDER::DRC_TEST_PROVIDER() :
     m_drcEngine( nullptr )
 {
 }
 
 
+void DRC_TEST_PROVIDER::SetDRCEngine( DRC_ENGINE* engine )
+{
+    m_drcEngine = engine;
+    m_stats.clear();
+
+    // Filled in here rather than lazily as providers may be run from several threads at once
+    if( s_allBasicItems.size() == 0 )
+    {
+        for( int i = 0; i < MAX_STRUCT_TYPE_ID; i++ )
+        {
+            if( i != PCB_MODULE_T && i != PCB_GROUP_T )
+                s_allBasicItems.push_back( (KICAD_T) i );
+        }
+    }
+}
+
+
 const wxString DRC_TEST_PROVIDER::GetName() const { return "<no name test>"; }
 const wxString DRC_TEST_PROVIDER::GetDescription() const { return ""; }
 
@@ -48,7 +87,15 @@ const wxString DRC_TEST_PROVIDER::GetDescription() const { return ""; }
 void DRC_TEST_PROVIDER::reportViolation( std::shared_ptr<DRC_ITEM>& item, wxPoint aMarkerPos )
 {
     item->SetViolatingTest( this );
-    m_drcEngine->ReportViolation( item, aMarkerPos );
+
+    // Counted straight away so that the other chunks see the error limits
+    if( s_currentChunk )
+    {
+        if( m_drcEngine->AccountViolation( item ) )
+            s_currentChunk->violations.emplace_back( item, aMarkerPos );
+    }
+    else
+        m_drcEngine->ReportViolation( item, aMarkerPos );
 }
 
 
@@ -90,6 +137,12 @@ EDA_UNITS DRC_TEST_PROVIDER::userUnits() const
 
 void DRC_TEST_PROVIDER::accountCheck( const DRC_RULE* ruleToTest )
 {
+    if( s_currentChunk )
+    {
+        s_currentChunk->stats[ ruleToTest ] += 1;
+        return;
+    }
+
     auto it = m_stats.find( ruleToTest );
 
     if( it == m_stats.end() )
@@ -131,15 +184,6 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
     std::bitset<MAX_STRUCT_TYPE_ID> typeMask;
     int n = 0;
 
-    if( s_allBasicItems.size() == 0 )
-    {
-        for( int i = 0; i < MAX_STRUCT_TYPE_ID; i++ )
-        {
-            if( i != PCB_MODULE_T && i != PCB_GROUP_T )
-                s_allBasicItems.push_back( (KICAD_T) i );
-        }
-    }
-
     if( aTypes.size() == 0 )
     {
         for( int i = 0; i < MAX_STRUCT_TYPE_ID; i++ )
@@ -305,6 +349,113 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
 }
 
 
+bool DRC_TEST_PROVIDER::forEachIndexInParallel( int aCount, int aChunkSize,
+                                                const std::function<void( int )>& aFunc )
+{
+    if( aCount <= 0 )
+        return true;
+
+    size_t                     chunkCount = ( aCount + aChunkSize - 1 ) / aChunkSize;
+    std::vector<CHUNK_RESULTS> results( chunkCount );
+    std::atomic<size_t>        nextChunk( 0 );
+    std::atomic<int>           done( 0 );
+    std::atomic<bool>          cancelled( false );
+
+    auto processChunk =
+            [&]( size_t aChunk )
+            {
+                int first = aChunk * aChunkSize;
+                int last = std::min( first + aChunkSize, aCount );
+
+                s_currentChunk = &results[ aChunk ];
+
+                for( int ii = first; ii < last; ++ii )
+                    aFunc( ii );
+
+                s_currentChunk = nullptr;
+                done += last - first;
+            };
+
+    auto chunk_lambda =
+            [&]() -> size_t
+            {
+                size_t num = 0;
+
+                for( size_t i = nextChunk++; i < chunkCount; i = nextChunk++ )
+                {
+                    if( cancelled || m_drcEngine->IsCancelled() )
+                    {
+                        cancelled = true;
+                        break;
+                    }
+
+                    processChunk( i );
+                    num++;
+                }
+
+                return num;
+            };
+
+    // Other providers may be running concurrently: only take the threads they leave idle
+    size_t extraThreads = m_drcEngine->AcquireThreads( chunkCount - 1 );
+
+    if( extraThreads == 0 )
+    {
+        for( size_t i = 0; i < chunkCount && !cancelled; ++i )
+        {
+            processChunk( i );
+
+            if( !m_drcEngine->ReportProgress( (double) done / (double) aCount ) )
+                cancelled = true;
+        }
+    }
+    else
+    {
+        // The calling thread only waits, so its thread goes to the first worker.  The others
+        // give theirs back as soon as there are no chunks left.
+        size_t                           parallelThreadCount = extraThreads + 1;
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        returns[0] = std::async( std::launch::async, chunk_lambda );
+
+        for( size_t ii = 1; ii < parallelThreadCount; ++ii )
+        {
+            returns[ii] = std::async( std::launch::async,
+                                      [&]() -> size_t
+                                      {
+                                          size_t num = chunk_lambda();
+                                          m_drcEngine->ReleaseThreads( 1 );
+                                          return num;
+                                      } );
+        }
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            // Here we balance returns with a 100ms timeout to allow progress reporting
+            std::future_status status;
+            do
+            {
+                if( !m_drcEngine->ReportProgress( (double) done / (double) aCount ) )
+                    cancelled = true;
+
+                status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+            } while( status != std::future_status::ready );
+        }
+    }
+
+    for( CHUNK_RESULTS& chunk : results )
+    {
+        for( const std::pair<const DRC_RULE* const, int>& stat : chunk.stats )
+            m_stats[ stat.first ] += stat.second;
+
+        for( std::pair<std::shared_ptr<DRC_ITEM>, wxPoint>& violation : chunk.violations )
+            m_drcEngine->ReportAccountedViolation( violation.first, violation.second );
+    }
+
+    return !cancelled;
+}
+
+
 bool DRC_TEST_PROVIDER::isInvisibleText( const BOARD_ITEM* aItem ) const
 {
 
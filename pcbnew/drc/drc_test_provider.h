@@ -74,11 +74,7 @@ public:
     DRC_TEST_PROVIDER ();
     virtual ~DRC_TEST_PROVIDER() {}
 
-    void SetDRCEngine( DRC_ENGINE *engine )
-    {
-        m_drcEngine = engine;
-        m_stats.clear();
-    }
+    void SetDRCEngine( DRC_ENGINE *engine );
 
     /**
      * Runs this provider against the given PCB with configured options (if any).
@@ -97,6 +93,15 @@ public:
         return m_isRuleDriven;
     }
 
+    /**
+     * Returns false if the provider modifies shared board state (connectivity, caches, etc.)
+     * and must therefore be run on its own before the concurrent providers are started.
+     */
+    virtual bool CanRunConcurrently() const
+    {
+        return true;
+    }
+
     bool IsEnabled() const
     {
         return m_enabled;
@@ -111,6 +116,26 @@ protected:
     int forEachGeometryItem( const std::vector<KICAD_T>& aTypes, LSET aLayers,
                              const std::function<bool(BOARD_ITEM*)>& aFunc );
 
+    /**
+     * Calls aFunc for each index in [0, aCount) from a set of worker threads, handing out the
+     * indices in chunks of aChunkSize.  Violations and rule statistics reported from within
+     * aFunc are collected per chunk and passed on in index order once all chunks are done, so
+     * the results are the same as those of a serial run.  They are counted against the error
+     * limits as they are found, though, so that aFunc can rely on
+     * DRC_ENGINE::IsErrorLimitExceeded().  Progress is reported from the calling thread;
+     * cancellation is checked before each chunk.
+     *
+     * The worker threads come out of the engine's budget (see DRC_ENGINE::AcquireThreads()),
+     * so with all the threads taken by concurrent providers the loop runs on the calling
+     * thread.
+     *
+     * Note that aFunc must not use member state such as m_msg.
+     *
+     * @return false if the user cancelled the run.
+     */
+    bool forEachIndexInParallel( int aCount, int aChunkSize,
+                                 const std::function<void( int )>& aFunc );
+
     virtual void reportAux( wxString fmt, ... );
     virtual void reportViolation( std::shared_ptr<DRC_ITEM>& item, wxPoint aMarkerPos );
     virtual bool reportProgress( int aCount, int aSize, int aDelta );
@@ -147,6 +147,9 @@ bool DRC_TEST_PROVIDER_ANNULUS::Run()
         if( !reportProgress( ii++, board->Tracks().size(), delta ) )
             break;
 
+        if( !m_drcEngine->IsInTestScope( item ) )
+            continue;
+
         if( !checkAnnulus( item ) )
             break;
     }
@@ -66,6 +66,12 @@ public:
     virtual std::set<DRC_CONSTRAINT_TYPE_T> GetConstraintTypes() const override;
 
     int GetNumPhases() const override;
+
+    // Rebuilds the board connectivity, which the other providers depend on.
+    bool CanRunConcurrently() const override
+    {
+        return false;
+    }
 };
 
 
@@ -78,9 +84,13 @@ bool DRC_TEST_PROVIDER_CONNECTIVITY::Run()
 
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = board->GetConnectivity();
 
-    // Rebuild just in case. This really needs to be reliable.
-    connectivity->Clear();
-    connectivity->Build( board, m_drcEngine->GetProgressReporter() );
+    // Rebuild just in case. This really needs to be reliable.  Incremental runs follow commits,
+    // which keep the connectivity and its ratsnest up to date themselves.
+    if( !m_drcEngine->IsIncrementalRun() )
+    {
+        connectivity->Clear();
+        connectivity->Build( board, m_drcEngine->GetProgressReporter() );
+    }
 
     int delta = 100;  // This is the number of tests between 2 calls to the progress bar
     int ii = 0;
@@ -104,6 +114,9 @@ bool DRC_TEST_PROVIDER_CONNECTIVITY::Run()
         if( !reportProgress( ii++, count, delta ) )
             break;
 
+        if( !m_drcEngine->IsInTestScope( track ) )
+            continue;
+
         // Test for dangling items
         int code = track->Type() == PCB_VIA_T ? DRCE_DANGLING_VIA : DRCE_DANGLING_TRACK;
         wxPoint pos;
@@ -145,7 +158,9 @@ bool DRC_TEST_PROVIDER_CONNECTIVITY::Run()
     if( !reportPhase( _( "Checking net connections..." ) ) )
         return false;
 
-    connectivity->RecalculateRatsnest();
+    if( !m_drcEngine->IsIncrementalRun() )
+        connectivity->RecalculateRatsnest();
+
     std::vector<CN_EDGE> edges;
     connectivity->GetUnconnectedEdges( edges );
 
@@ -79,9 +79,11 @@ public:
     int GetNumPhases() const override;
 
 private:
-    void testPadClearances();
+    ///> @return false if the user cancelled the run
+    bool testPadClearances();
 
-    void testTrackClearances();
+    ///> @return false if the user cancelled the run
+    bool testTrackClearances();
 
     void testCopperTextAndGraphics();
 
@@ -126,12 +128,14 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::Run()
     if( !reportPhase( _( "Checking pad clearances..." ) ) )
         return false;
 
-    testPadClearances();
+    if( !testPadClearances() )
+        return false;
 
     if( !reportPhase( _( "Checking track & via clearances..." ) ) )
         return false;
 
-    testTrackClearances();
+    if( !testTrackClearances() )
+        return false;
 
     if( !reportPhase( _( "Checking copper graphic & text clearances..." ) ) )
         return false;
@@ -194,6 +198,9 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testCopperDrawItem( BOARD_ITEM* aItem )
     PCB_LAYER_ID           layer = aItem->GetLayer();
     BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
 
+    if( !m_drcEngine->IsInTestScope( aItem ) )
+        return;
+
     if( textItem )
     {
         bbox = textItem->GetTextBox();
@@ -311,27 +318,28 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testCopperDrawItem( BOARD_ITEM* aItem )
 }
 
 
-void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
+bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
 {
-    // This is the number of tests between 2 calls to the progress bar
-    const int delta = 25;
-    int       count = m_board->Tracks().size();
+    // Number of tracks handed to a worker thread at a time.  Each track is only tested
+    // against the tracks following it, so keep this small to even out the load.
+    const int chunkSize = 32;
+    TRACKS&   tracks = m_board->Tracks();
+    int       count = tracks.size();
 
     reportAux( "Testing %d tracks...", count );
 
-    int ii = 0;
+    return forEachIndexInParallel( count, chunkSize,
+            [&]( int ii )
+            {
+                TRACKS::iterator seg_it = tracks.begin() + ii;
 
-    for( auto seg_it = m_board->Tracks().begin(); seg_it != m_board->Tracks().end(); seg_it++ )
-    {
-        if( !reportProgress( ii++, m_board->Tracks().size(), delta ) )
-            break;
+                if( !m_drcEngine->IsInTestScope( *seg_it ) )
+                    return;
 
-        // Test segment against tracks and pads, optionally against copper zones
-        for( PCB_LAYER_ID layer : (*seg_it)->GetLayerSet().Seq() )
-        {
-            doTrackDrc( *seg_it, layer, seg_it + 1, m_board->Tracks().end() );
-        }
-    }
+                // Test segment against tracks and pads, optionally against copper zones
+                for( PCB_LAYER_ID layer : (*seg_it)->GetLayerSet().Seq() )
+                    doTrackDrc( *seg_it, layer, seg_it + 1, tracks.end() );
+            } );
 }
 
 
@@ -340,6 +348,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::doTrackDrc( TRACK* aRefSeg, PCB_LAYER_I
                                                      TRACKS::iterator aEndIt )
 {
     BOARD_DESIGN_SETTINGS&  bds = m_board->GetDesignSettings();
+    wxString                msg;    // Called from several threads; don't use m_msg
 
     SHAPE_SEGMENT refSeg( aRefSeg->GetStart(), aRefSeg->GetEnd(), aRefSeg->GetWidth() );
     EDA_RECT      refSegInflatedBB = aRefSeg->GetBoundingBox();
@@ -406,12 +415,12 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::doTrackDrc( TRACK* aRefSeg, PCB_LAYER_I
             {
                 std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_CLEARANCE );
 
-                m_msg.Printf( drcItem->GetErrorText() + wxS( " " ) + _( "(%s clearance %s; actual %s)" ),
-                              constraint.GetName(),
-                              MessageTextFromValue( userUnits(), minClearance ),
-                              MessageTextFromValue( userUnits(), actual ) );
+                msg.Printf( drcItem->GetErrorText() + wxS( " " ) + _( "(%s clearance %s; actual %s)" ),
+                            constraint.GetName(),
+                            MessageTextFromValue( userUnits(), minClearance ),
+                            MessageTextFromValue( userUnits(), actual ) );
 
-                drcItem->SetErrorMessage( m_msg );
+                drcItem->SetErrorMessage( msg );
                 drcItem->SetItems( aRefSeg, pad );
                 drcItem->SetViolatingRule( constraint.GetParentRule() );
 
@@ -482,12 +491,12 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::doTrackDrc( TRACK* aRefSeg, PCB_LAYER_I
         {
             std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_CLEARANCE );
 
-            m_msg.Printf( drcItem->GetErrorText() + wxS( " " ) + _( "(%s clearance %s; actual %s)" ),
-                          constraint.GetName(),
-                          MessageTextFromValue( userUnits(), minClearance ),
-                          MessageTextFromValue( userUnits(), actual ) );
+            msg.Printf( drcItem->GetErrorText() + wxS( " " ) + _( "(%s clearance %s; actual %s)" ),
+                        constraint.GetName(),
+                        MessageTextFromValue( userUnits(), minClearance ),
+                        MessageTextFromValue( userUnits(), actual ) );
 
-            drcItem->SetErrorMessage( m_msg );
+            drcItem->SetErrorMessage( msg );
             drcItem->SetItems( aRefSeg, track );
             drcItem->SetViolatingRule( constraint.GetParentRule() );
 
@@ -588,12 +597,12 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::doTrackDrc( TRACK* aRefSeg, PCB_LAYER_I
                 actual = std::max( 0, actual - halfWidth );
                 std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_CLEARANCE );
 
-                m_msg.Printf( drcItem->GetErrorText() + wxS( " " ) + _( "(%s clearance %s; actual %s)" ),
-                              constraint.GetName(),
-                              MessageTextFromValue( userUnits(), minClearance ),
-                              MessageTextFromValue( userUnits(), actual ) );
+                msg.Printf( drcItem->GetErrorText() + wxS( " " ) + _( "(%s clearance %s; actual %s)" ),
+                            constraint.GetName(),
+                            MessageTextFromValue( userUnits(), minClearance ),
+                            MessageTextFromValue( userUnits(), actual ) );
 
-                drcItem->SetErrorMessage( m_msg );
+                drcItem->SetErrorMessage( msg );
                 drcItem->SetItems( aRefSeg, zone );
                 drcItem->SetViolatingRule( constraint.GetParentRule() );
 
@@ -604,9 +613,9 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::doTrackDrc( TRACK* aRefSeg, PCB_LAYER_I
 }
 
 
-void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
+bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
 {
-    const int delta = 25;  // This is the number of tests between 2 calls to the progress bar
+    const int chunkSize = 64;   // Number of pads handed to a worker thread at a time
     std::vector<D_PAD*> sortedPads;
 
     m_board->GetSortedPadListByXthenYCoord( sortedPads );
@@ -614,7 +623,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
     reportAux( "Testing %d pads...", sortedPads.size());
 
     if( sortedPads.empty() )
-        return;
+        return true;
 
     // find the max size of the pads (used to stop the pad-to-pad tests)
     int max_size = 0;
@@ -632,18 +641,19 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
     // actual clearances
     max_size += m_largestClearance;
 
-    // Test the pads
-    for( int idx = 0; idx < (int) sortedPads.size(); idx++ )
-    {
-        D_PAD* pad = sortedPads[idx];
-
-        if( !reportProgress( idx, sortedPads.size(), delta ) )
-            break;
+    // Test the pads.  As the list is sorted by X, each chunk covers a vertical strip of the
+    // board.
+    return forEachIndexInParallel( sortedPads.size(), chunkSize,
+            [&]( int idx )
+            {
+                D_PAD* pad = sortedPads[idx];
+                int    x_limit = pad->GetPosition().x + pad->GetBoundingRadius() + max_size;
 
-        int x_limit = pad->GetPosition().x + pad->GetBoundingRadius() + max_size;
+                if( !m_drcEngine->IsInTestScope( pad ) )
+                    return;
 
-        doPadToPadsDrc( idx, sortedPads, x_limit );
-    }
+                doPadToPadsDrc( idx, sortedPads, x_limit );
+            } );
 }
 
 void DRC_TEST_PROVIDER_COPPER_CLEARANCE::doPadToPadsDrc( int aRefPadIdx,
@@ -652,6 +662,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::doPadToPadsDrc( int aRefPadIdx,
 {
     const static LSET all_cu = LSET::AllCuMask();
     const BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    wxString msg;   // Called from several threads; don't use m_msg
 
     D_PAD*   refPad = aSortedPadsList[aRefPadIdx];
     LSET     layerMask = refPad->GetLayerSet() & all_cu;
@@ -692,10 +703,10 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::doPadToPadsDrc( int aRefPadIdx,
             {
                 std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_SHORTING_ITEMS );
 
-                m_msg.Printf( drcItem->GetErrorText() + wxS( " " ) + _( "(nets %s and %s)" ),
-                              pad->GetNetname(), refPad->GetNetname() );
+                msg.Printf( drcItem->GetErrorText() + wxS( " " ) + _( "(nets %s and %s)" ),
+                            pad->GetNetname(), refPad->GetNetname() );
 
-                drcItem->SetErrorMessage( m_msg );
+                drcItem->SetErrorMessage( msg );
                 drcItem->SetItems( pad, refPad );
 
                 reportViolation( drcItem, refPad->GetPosition());
@@ -772,12 +783,12 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::doPadToPadsDrc( int aRefPadIdx,
             {
                 std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_CLEARANCE );
 
-                m_msg.Printf( drcItem->GetErrorText() + wxS( " " ) + _( "(%s clearance %s; actual %s)" ),
-                              constraint.GetName(),
-                              MessageTextFromValue( userUnits(), minClearance ),
-                              MessageTextFromValue( userUnits(), actual ) );
+                msg.Printf( drcItem->GetErrorText() + wxS( " " ) + _( "(%s clearance %s; actual %s)" ),
+                            constraint.GetName(),
+                            MessageTextFromValue( userUnits(), minClearance ),
+                            MessageTextFromValue( userUnits(), actual ) );
 
-                drcItem->SetErrorMessage( m_msg );
+                drcItem->SetErrorMessage( msg );
                 drcItem->SetItems( refPad, pad );
                 drcItem->SetViolatingRule( constraint.GetParentRule() );
 
@@ -827,7 +838,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZones()
 
             ZONE_CONTAINER* zoneRef = m_board->GetArea( ia );
 
-            if( !zoneRef->IsOnLayer( layer ) )
+            if( !zoneRef->IsOnLayer( layer ) || !m_drcEngine->IsInTestScope( zoneRef ) )
                 continue;
 
             // If we are testing a single zone, then iterate through all other zones
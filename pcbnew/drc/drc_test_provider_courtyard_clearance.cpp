@@ -88,6 +88,9 @@ void DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testFootprintCourtyardDefinitions()
         if( !reportProgress( ii++, m_board->Modules().size(), delta ) )
             return;
 
+        if( !m_drcEngine->IsInTestScope( footprint ) )
+            continue;
+
         if( ( footprint->GetFlags() & MALFORMED_COURTYARD ) != 0 )
         {
             if( m_drcEngine->IsErrorLimitExceeded( DRCE_MALFORMED_COURTYARD) )
@@ -111,11 +114,6 @@ void DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testFootprintCourtyardDefinitions()
             drcItem->SetItems( footprint );
             reportViolation( drcItem, footprint->GetPosition());
         }
-        else
-        {
-            footprint->GetPolyCourtyardFront().BuildBBoxCaches();
-            footprint->GetPolyCourtyardBack().BuildBBoxCaches();
-        }
     }
 }
 
@@ -144,6 +142,9 @@ void DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testOverlappingComponentCourtyards()
         if( footprintFront.OutlineCount() == 0 && footprintBack.OutlineCount() == 0 )
             continue; // No courtyards defined
 
+        if( !m_drcEngine->IsInTestScope( footprint ) )
+            continue;
+
         for( auto it2 = it1 + 1; it2 != m_board->Modules().end(); it2++ )
         {
             MODULE*         test = *it2;
@@ -223,6 +223,20 @@ static void extractDiffPairCoupledItems( DIFF_PAIR_ITEMS& aDp, DRC_RTREE& aTree
             auto excludeSelf =
                     [&] ( BOARD_ITEM *aItem )
                     {
+                        // The shared board index holds more than just copper connections
+                        switch( aItem->Type() )
+                        {
+                        case PCB_TRACE_T:
+                        case PCB_VIA_T:
+                        case PCB_PAD_T:
+                        case PCB_ZONE_AREA_T:
+                        case PCB_ARC_T:
+                            break;
+
+                        default:
+                            return false;
+                        }
+
                         if( aItem == bestCoupled->parentN || aItem == bestCoupled->parentP )
                         {
                             return false;
@@ -304,31 +318,25 @@ bool test::DRC_TEST_PROVIDER_DIFF_PAIR_COUPLING::Run()
                 return true;
             };
 
-    m_board->GetConnectivity()->GetFromToCache()->Rebuild( m_board );
-
     forEachGeometryItem( { PCB_TRACE_T, PCB_VIA_T, PCB_ARC_T },
                     LSET::AllCuMask(), evaluateDpConstraints );
 
     drc_dbg( 10, "dp rule matches %d\n", (int) dpRuleMatches.size() );
 
 
-    DRC_RTREE copperTree;
-
-    auto addToTree =
-            [&copperTree]( BOARD_ITEM *item ) -> bool
-            {
-                copperTree.insert( item );
-                return true;
-            };
-
-    forEachGeometryItem( { PCB_TRACE_T, PCB_VIA_T, PCB_PAD_T, PCB_ZONE_AREA_T, PCB_ARC_T },
-                         LSET::AllCuMask(), addToTree );
-
-
     reportAux( wxString::Format( _("DPs evaluated:") ) );
 
     for( auto& it : dpRuleMatches )
     {
+        if( !m_drcEngine->IsNetInTestScope( it.first.netP )
+                && !m_drcEngine->IsNetInTestScope( it.first.netN ) )
+        {
+            continue;
+        }
+
+        // The coupled parts of a pair may be anywhere on the board, not just in the test scope
+        DRC_RTREE* copperTree = m_drcEngine->GetBoardShapeIndex( true );
+
         NETINFO_ITEM *niP = m_board->GetNetInfo().GetNetItem( it.first.netP );
         NETINFO_ITEM *niN = m_board->GetNetInfo().GetNetItem( it.first.netN );
 
@@ -340,7 +348,7 @@ bool test::DRC_TEST_PROVIDER_DIFF_PAIR_COUPLING::Run()
 
         reportAux( wxString::Format( "Rule '%s', DP: (+) %s - (-) %s", it.first.parentRule->m_Name, nameP, nameN ) );
 
-        extractDiffPairCoupledItems( it.second, copperTree );
+        extractDiffPairCoupledItems( it.second, *copperTree );
 
         it.second.totalCoupled = 0;
         it.second.totalLengthN = 0;
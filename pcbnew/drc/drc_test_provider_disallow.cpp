@@ -99,6 +99,9 @@ bool DRC_TEST_PROVIDER_DISALLOW::Run()
                 if( m_drcEngine->IsErrorLimitExceeded( DRCE_ALLOWED_ITEMS ) )
                     return false;
 
+                if( !m_drcEngine->IsInTestScope( item ) )
+                    return true;
+
                 item->ClearFlags( HOLE_PROXY );
                 doCheckItem( item );
 
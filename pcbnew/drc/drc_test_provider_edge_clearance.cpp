@@ -139,7 +139,9 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
     auto queryBoardGeometryItems =
             [&]( BOARD_ITEM *item ) -> bool
             {
-                boardItems.push_back( item );
+                if( m_drcEngine->IsInTestScope( item ) )
+                    boardItems.push_back( item );
+
                 return true;
             };
 
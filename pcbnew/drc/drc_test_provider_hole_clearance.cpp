@@ -209,6 +209,9 @@ void DRC_TEST_PROVIDER_HOLE_CLEARANCE::testPads2Holes()
         if( !reportProgress( idx, sortedPads.size(), delta ) )
             break;
 
+        if( !m_drcEngine->IsInTestScope( pad ) )
+            continue;
+
         doPadToPadHoleDrc( idx, sortedPads, x_limit );
     }
 }
@@ -356,6 +359,9 @@ void DRC_TEST_PROVIDER_HOLE_CLEARANCE::testHoles2Holes()
         DRILLED_HOLE& refHole = m_drilledHoles[ ii ];
         int neighborhood = refHole.m_drillRadius + m_largestClearance + m_largestRadius;
 
+        if( !m_drcEngine->IsInTestScope( refHole.m_owner ) )
+            continue;
+
         for( size_t jj = ii + 1; jj < m_drilledHoles.size(); ++jj )
         {
             if( m_drcEngine->IsErrorLimitExceeded( DRCE_DRILLED_HOLES_TOO_CLOSE ) )
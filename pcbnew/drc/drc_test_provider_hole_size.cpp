@@ -91,7 +91,8 @@ bool DRC_TEST_PROVIDER_HOLE_SIZE::Run()
             if( m_drcEngine->IsErrorLimitExceeded( DRCE_TOO_SMALL_DRILL ) )
                 break;
 
-            checkPad( pad );
+            if( m_drcEngine->IsInTestScope( pad ) )
+                checkPad( pad );
         }
     }
 
@@ -115,7 +116,8 @@ bool DRC_TEST_PROVIDER_HOLE_SIZE::Run()
         if( exceedMicro && exceedStd )
             break;
 
-        checkVia( via, exceedMicro, exceedStd );
+        if( m_drcEngine->IsInTestScope( via ) )
+            checkVia( via, exceedMicro, exceedStd );
     }
 
     reportRuleStatistics();
@@ -265,10 +265,9 @@ bool test::DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode
                 return true;
             };
 
+    // Note: the from-to cache has already been rebuilt by the DRC engine
     auto ftCache = m_board->GetConnectivity()->GetFromToCache();
 
-    ftCache->Rebuild( m_board );
-
     forEachGeometryItem( { PCB_TRACE_T, PCB_VIA_T, PCB_ARC_T },
                     LSET::AllCuMask(), evaluateLengthConstraints );
 
@@ -277,10 +276,18 @@ bool test::DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode
     for( auto it : itemSets )
     {
         std::map<int, CITEMS> netMap;
+        bool                  inScope = false;
 
         for( auto citem : it.second )
+        {
             netMap[ citem->GetNetCode() ].insert( citem );
+            inScope |= m_drcEngine->IsNetInTestScope( citem->GetNetCode() );
+        }
 
+        // The skews are between all the nets of a rule: its nets are tested together or not
+        // at all
+        if( !inScope )
+            continue;
 
         for( auto nitem : netMap )
         {
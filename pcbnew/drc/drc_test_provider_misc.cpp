@@ -85,6 +85,11 @@ void DRC_TEST_PROVIDER_MISC::testOutline()
 
     SHAPE_POLY_SET boardOutlines;
 
+    // These are reported against the board, which is never one of the dirty items of an
+    // incremental run
+    if( m_drcEngine->IsIncrementalRun() )
+        return;
+
     if( m_board->GetBoardPolygonOutlines( boardOutlines, nullptr, &discontinuities,
                                           &intersections ) )
     {
@@ -127,6 +132,9 @@ void DRC_TEST_PROVIDER_MISC::testDisabledLayers()
     auto checkDisabledLayers =
             [&]( BOARD_ITEM* item ) -> bool
             {
+                if( !m_drcEngine->IsInTestScope( item ) )
+                    return true;
+
                 LSET refLayers ( item->GetLayer() );
 
                 if( ( disabledLayers & refLayers ).any() )
@@ -157,6 +165,9 @@ void DRC_TEST_PROVIDER_MISC::testTextVars()
                 if( m_drcEngine->IsErrorLimitExceeded( DRCE_UNRESOLVED_VARIABLE ) )
                     return false;
 
+                if( !m_drcEngine->IsInTestScope( static_cast<BOARD_ITEM*>( item ) ) )
+                    return true;
+
                 EDA_TEXT* text = dynamic_cast<EDA_TEXT*>( item );
 
                 if( text && text->GetShownText().Matches( wxT( "*${*}*" ) ) )
@@ -175,8 +186,12 @@ void DRC_TEST_PROVIDER_MISC::testTextVars()
     KIGFX::WS_PROXY_VIEW_ITEM* worksheet = m_drcEngine->GetWorksheet();
     WS_DRAW_ITEM_LIST          wsItems;
 
-    if( !worksheet || m_drcEngine->IsErrorLimitExceeded( DRCE_UNRESOLVED_VARIABLE ) )
+    // Worksheet items are never dirty either
+    if( !worksheet || m_drcEngine->IsIncrementalRun()
+            || m_drcEngine->IsErrorLimitExceeded( DRCE_UNRESOLVED_VARIABLE ) )
+    {
         return;
+    }
 
     wsItems.SetMilsToIUfactor( IU_PER_MILS );
     wsItems.SetPageNumber( "1" );
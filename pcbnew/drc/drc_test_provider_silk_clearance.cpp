@@ -105,21 +105,8 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
     if( !reportPhase( _( "Checking silkscreen for overlapping items..." ) ) )
         return false;
 
-    DRC_RTREE silkTree, targetTree;
-
-    auto addToSilkTree =
-            [&silkTree]( BOARD_ITEM *item ) -> bool
-            {
-                silkTree.insert( item );
-                return true;
-            };
-
-    auto addToTargetTree =
-            [&targetTree]( BOARD_ITEM *item ) -> bool
-            {
-                targetTree.insert( item );
-                return true;
-            };
+    DRC_RTREE* boardIndex = m_drcEngine->GetBoardShapeIndex();
+    LSET       targetLayers = LSET::FrontMask() | LSET::BackMask();
 
     auto checkClearance =
             [&]( const DRC_RTREE::LAYER_PAIR& aLayers, DRC_RTREE::ITEM_WITH_SHAPE* aRefItem,
@@ -134,6 +121,10 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
                 if ( isInvisibleText( aTestItem->parent ) )
                     return true;
 
+                // Board outlines are only of interest when they're also on an outer layer
+                if( !( aTestItem->parent->GetLayerSet() & targetLayers ).any() )
+                    return true;
+
                 auto constraint = m_drcEngine->EvalRulesForItems( DRC_CONSTRAINT_TYPE_SILK_CLEARANCE,
                                                                   aRefItem->parent,
                                                                   aTestItem->parent,
@@ -186,12 +177,8 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
                 return true;
             };
 
-    forEachGeometryItem( s_allBasicItems, LSET( 2, F_SilkS, B_SilkS ), addToSilkTree );
-    forEachGeometryItem( s_allBasicItems, LSET::FrontMask() | LSET::BackMask(), addToTargetTree );
-
-    reportAux( _("Testing %d silkscreen features against %d board items."),
-               silkTree.size(),
-               targetTree.size() );
+    reportAux( _("Testing silkscreen features against %d indexed board shapes."),
+               (int) boardIndex->size() );
 
     const std::vector<DRC_RTREE::LAYER_PAIR> layerPairs =
     {
@@ -216,7 +203,7 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
     // This is the number of tests between 2 calls to the progress bar
     const int delta = 250;
 
-    targetTree.QueryCollidingPairs( &silkTree, layerPairs, checkClearance, m_largestClearance,
+    boardIndex->QueryCollidingPairs( boardIndex, layerPairs, checkClearance, m_largestClearance,
                                     [&]( int aCount, int aSize ) -> bool
                                     {
                                         return reportProgress( aCount, aSize, delta );
@@ -103,21 +103,7 @@ bool DRC_TEST_PROVIDER_SILK_TO_MASK::Run()
     if( !reportPhase( _( "Checking silkscreen for potential soldermask clipping..." ) ) )
         return false;
 
-    DRC_RTREE maskTree, silkTree;
-
-    auto addMaskToTree =
-            [&maskTree]( BOARD_ITEM *item ) -> bool
-            {
-                maskTree.insert( item );
-                return true;
-            };
-
-    auto addSilkToTree =
-            [&silkTree]( BOARD_ITEM *item ) -> bool
-            {
-                silkTree.insert( item );
-                return true;
-            };
+    DRC_RTREE* boardIndex = m_drcEngine->GetBoardShapeIndex();
 
     auto checkClearance =
             [&]( const DRC_RTREE::LAYER_PAIR& aLayers, DRC_RTREE::ITEM_WITH_SHAPE* aRefItem,
@@ -166,10 +152,7 @@ bool DRC_TEST_PROVIDER_SILK_TO_MASK::Run()
                 return true;
             };
 
-    int numMask = forEachGeometryItem( s_allBasicItems, LSET( 2, F_Mask, B_Mask ), addMaskToTree );
-    int numSilk = forEachGeometryItem( s_allBasicItems, LSET( 2, F_SilkS, B_SilkS ), addSilkToTree );
-
-    reportAux( _("Testing %d mask apertures against %d silkscreen features."), numMask, numSilk );
+    reportAux( _("Testing mask apertures against silkscreen features.") );
 
     const std::vector<DRC_RTREE::LAYER_PAIR> layerPairs =
     {
@@ -180,11 +163,11 @@ bool DRC_TEST_PROVIDER_SILK_TO_MASK::Run()
     // This is the number of tests between 2 calls to the progress bar
     const int delta = 250;
 
-    maskTree.QueryCollidingPairs( &silkTree, layerPairs, checkClearance, m_largestClearance,
-                                  [&]( int aCount, int aSize ) -> bool
-                                  {
-                                      return reportProgress( aCount, aSize, delta );
-                                  } );
+    boardIndex->QueryCollidingPairs( boardIndex, layerPairs, checkClearance, m_largestClearance,
+                                     [&]( int aCount, int aSize ) -> bool
+                                     {
+                                         return reportProgress( aCount, aSize, delta );
+                                     } );
 
     reportRuleStatistics();
 
@@ -155,6 +155,9 @@ bool DRC_TEST_PROVIDER_TRACK_WIDTH::Run()
         if( !reportProgress( ii++, m_drcEngine->GetBoard()->Tracks().size(), delta ) )
             break;
 
+        if( !m_drcEngine->IsInTestScope( item ) )
+            continue;
+
         if( !checkTrackWidth( item ) )
             break;
     }
@@ -142,6 +142,9 @@ bool DRC_TEST_PROVIDER_VIA_DIAMETER::Run()
         if( !reportProgress( ii++, m_drcEngine->GetBoard()->Tracks().size(), delta ) )
             break;
 
+        if( !m_drcEngine->IsInTestScope( item ) )
+            continue;
+
         if( !checkViaDiameter( item ) )
             break;
     }
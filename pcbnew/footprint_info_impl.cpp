@@ -246,6 +246,9 @@ bool FOOTPRINT_LIST_IMPL::JoinWorkers()
     // destroy it after they finish, and block the main (GUI) thread while they work. Any deviation
     // from this will cause nasal demons.
     //
+    // The KiCad s-expression plugin no longer depends on the locale to read numbers, but the
+    // legacy and third party plugins do.
+    //
     // TODO: blast LOCALE_IO into the sun
 
     SYNC_QUEUE<std::unique_ptr<FOOTPRINT_INFO>> queue_parsed;
@@ -574,6 +574,11 @@ LIBEVAL::FUNC_CALL_REF PCB_EXPR_UCODE::CreateFuncCall( const wxString& aName )
 {
     PCB_EXPR_BUILTIN_FUNCTIONS& registry = PCB_EXPR_BUILTIN_FUNCTIONS::Instance();
 
+    // isDiffPair() only looks at the item's net; everything else depends on geometry or other
+    // item properties.
+    if( aName.Lower() != "isdiffpair" )
+        m_cacheable = false;
+
     return registry.Get( aName.Lower() );
 }
 
@@ -601,6 +606,12 @@ std::unique_ptr<LIBEVAL::VAR_REF> PCB_EXPR_UCODE::CreateVarRef( const wxString&
     wxString field( aField );
     field.Replace( "_",  " " );
 
+    if( aVar != "L" && field != "Type" && field != "Net" && field != "NetName"
+            && field != "NetClass" )
+    {
+        m_cacheable = false;
+    }
+
     for( const PROPERTY_MANAGER::CLASS_INFO& cls : propMgr.GetAllClasses() )
     {
         if( propMgr.IsOfType( cls.type, TYPE_HASH( BOARD_ITEM ) ) )
@@ -40,11 +40,23 @@ class PCB_EXPR_VAR_REF;
 class PCB_EXPR_UCODE final : public LIBEVAL::UCODE
 {
 public:
-    PCB_EXPR_UCODE() {};
+    PCB_EXPR_UCODE() :
+        m_cacheable( true )
+    {};
+
     virtual ~PCB_EXPR_UCODE() {};
 
     virtual std::unique_ptr<LIBEVAL::VAR_REF> CreateVarRef( const wxString& aVar, const wxString& aField ) override;
     virtual LIBEVAL::FUNC_CALL_REF CreateFuncCall( const wxString& aName ) override;
+
+    /**
+     * @return true if the compiled expression only depends on the types, nets and netclasses
+     *         of the items and on the layer, so its result can be cached against those.
+     */
+    bool IsCacheable() const { return m_cacheable; }
+
+private:
+    bool m_cacheable;
 };
 
 
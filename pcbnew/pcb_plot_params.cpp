@@ -23,6 +23,7 @@
 
 #include <board_design_settings.h>
 #include <convert_to_biu.h>
+#include <kicad_string.h>
 #include <layers_id_colors_and_visibility.h>
 #include <macros.h>
 #include <math/util.h> // for KiROUND
@@ -583,7 +584,7 @@ int PCB_PLOT_PARAMS_PARSER::parseInt( int aMin, int aMax )
     if( token != T_NUMBER )
         Expecting( T_NUMBER );
 
-    int val = atoi( CurText() );
+    int val = (int) StrToLong( CurText(), NULL );
 
     if( val < aMin )
         val = aMin;
@@ -601,7 +602,8 @@ double PCB_PLOT_PARAMS_PARSER::parseDouble()
     if( token != T_NUMBER )
         Expecting( T_NUMBER );
 
-    double val = strtod( CurText(), NULL );
+    // Not strtod(): the board parser no longer switches to the "C" locale
+    double val = StrToDouble( CurText(), NULL );
 
     return val;
 }
@@ -50,6 +50,39 @@
 using namespace PCB_KEYS_T;
 
 
+/**
+ * The text of a coordinate or a point, in a buffer of its own.
+ *
+ * Used in place of FormatInternalUnits() where there are many numbers to write, such as
+ * track ends and polygon points, to avoid a std::string for each of them.  Like the
+ * std::string's, a temporary's c_str() is valid until the end of the full expression.
+ */
+class IU_TEXT
+{
+public:
+    IU_TEXT( int aValue )               { FormatInternalUnits( aValue, m_buf ); }
+    IU_TEXT( const VECTOR2I& aPoint )   { FormatInternalUnits( aPoint, m_buf ); }
+
+    const char* c_str() const { return m_buf; }
+
+private:
+    char m_buf[2 * FMT_IU_BUFZ];
+};
+
+
+///> The text of an angle, in a buffer of its own.  See IU_TEXT.
+class ANGLE_TEXT
+{
+public:
+    explicit ANGLE_TEXT( double aAngle ) { FormatAngle( aAngle, m_buf ); }
+
+    const char* c_str() const { return m_buf; }
+
+private:
+    char m_buf[FMT_IU_BUFZ];
+};
+
+
 /**
  * Helper class for creating a footprint library cache.
  *
@@ -254,7 +287,7 @@ void FP_CACHE::Load()
             // Queue I/O errors so only files that fail to parse don't get loaded.
             try
             {
-                FILE_LINE_READER    reader( fn.GetFullPath() );
+                MAPPED_FILE_LINE_READER reader( fn.GetFullPath() );
 
                 m_owner->m_parser->SetLineReader( &reader );
 
@@ -762,31 +795,31 @@ void PCB_IO::format( PCB_SHAPE* aShape, int aNestLevel ) const
     {
     case S_SEGMENT:  // Line
         m_out->Print( aNestLevel, "(gr_line (start %s) (end %s)",
-                      FormatInternalUnits( aShape->GetStart() ).c_str(),
-                      FormatInternalUnits( aShape->GetEnd() ).c_str() );
+                      IU_TEXT( aShape->GetStart() ).c_str(),
+                      IU_TEXT( aShape->GetEnd() ).c_str() );
 
         if( aShape->GetAngle() != 0.0 )
-            m_out->Print( 0, " (angle %s)", FormatAngle( aShape->GetAngle() ).c_str() );
+            m_out->Print( 0, " (angle %s)", ANGLE_TEXT( aShape->GetAngle() ).c_str() );
 
         break;
 
     case S_RECT:  // Rectangle
         m_out->Print( aNestLevel, "(gr_rect (start %s) (end %s)",
-                      FormatInternalUnits( aShape->GetStart() ).c_str(),
-                      FormatInternalUnits( aShape->GetEnd() ).c_str() );
+                      IU_TEXT( aShape->GetStart() ).c_str(),
+                      IU_TEXT( aShape->GetEnd() ).c_str() );
         break;
 
     case S_CIRCLE:  // Circle
         m_out->Print( aNestLevel, "(gr_circle (center %s) (end %s)",
-                      FormatInternalUnits( aShape->GetStart() ).c_str(),
-                      FormatInternalUnits( aShape->GetEnd() ).c_str() );
+                      IU_TEXT( aShape->GetStart() ).c_str(),
+                      IU_TEXT( aShape->GetEnd() ).c_str() );
         break;
 
     case S_ARC:     // Arc
         m_out->Print( aNestLevel, "(gr_arc (start %s) (end %s) (angle %s)",
-                      FormatInternalUnits( aShape->GetStart() ).c_str(),
-                      FormatInternalUnits( aShape->GetEnd() ).c_str(),
-                      FormatAngle( aShape->GetAngle() ).c_str() );
+                      IU_TEXT( aShape->GetStart() ).c_str(),
+                      IU_TEXT( aShape->GetEnd() ).c_str(),
+                      ANGLE_TEXT( aShape->GetAngle() ).c_str() );
         break;
 
     case S_POLYGON: // Polygon
@@ -809,7 +842,7 @@ void PCB_IO::format( PCB_SHAPE* aShape, int aNestLevel ) const
                 }
 
                 m_out->Print( nestLevel, "%s(xy %s)",
-                              nestLevel ? "" : " ", FormatInternalUnits( outline.CPoint( ii ) ).c_str() );
+                              nestLevel ? "" : " ", IU_TEXT( outline.CPoint( ii ) ).c_str() );
             }
 
             m_out->Print( 0, ")" );
@@ -824,10 +857,10 @@ void PCB_IO::format( PCB_SHAPE* aShape, int aNestLevel ) const
 
     case S_CURVE:   // Bezier curve
         m_out->Print( aNestLevel, "(gr_curve (pts (xy %s) (xy %s) (xy %s) (xy %s))",
-                      FormatInternalUnits( aShape->GetStart() ).c_str(),
-                      FormatInternalUnits( aShape->GetBezControl1() ).c_str(),
-                      FormatInternalUnits( aShape->GetBezControl2() ).c_str(),
-                      FormatInternalUnits( aShape->GetEnd() ).c_str() );
+                      IU_TEXT( aShape->GetStart() ).c_str(),
+                      IU_TEXT( aShape->GetBezControl1() ).c_str(),
+                      IU_TEXT( aShape->GetBezControl2() ).c_str(),
+                      IU_TEXT( aShape->GetEnd() ).c_str() );
         break;
 
     default:
@@ -838,7 +871,7 @@ void PCB_IO::format( PCB_SHAPE* aShape, int aNestLevel ) const
 
     formatLayer( aShape );
 
-    m_out->Print( 0, " (width %s)", FormatInternalUnits( aShape->GetWidth() ).c_str() );
+    m_out->Print( 0, " (width %s)", IU_TEXT( aShape->GetWidth() ).c_str() );
 
     m_out->Print( 0, " (tstamp %s)", TO_UTF8( aShape->m_Uuid.AsString() ) );
 
@@ -852,27 +885,27 @@ void PCB_IO::format( FP_SHAPE* aModuleDrawing, int aNestLevel ) const
     {
     case S_SEGMENT:  // Line
         m_out->Print( aNestLevel, "(fp_line (start %s) (end %s)",
-                      FormatInternalUnits( aModuleDrawing->GetStart0() ).c_str(),
-                      FormatInternalUnits( aModuleDrawing->GetEnd0() ).c_str() );
+                      IU_TEXT( aModuleDrawing->GetStart0() ).c_str(),
+                      IU_TEXT( aModuleDrawing->GetEnd0() ).c_str() );
         break;
 
     case S_RECT:    // Rectangle
         m_out->Print( aNestLevel, "(fp_rect (start %s) (end %s)",
-                      FormatInternalUnits( aModuleDrawing->GetStart0() ).c_str(),
-                      FormatInternalUnits( aModuleDrawing->GetEnd0() ).c_str() );
+                      IU_TEXT( aModuleDrawing->GetStart0() ).c_str(),
+                      IU_TEXT( aModuleDrawing->GetEnd0() ).c_str() );
         break;
 
     case S_CIRCLE:  // Circle
         m_out->Print( aNestLevel, "(fp_circle (center %s) (end %s)",
-                      FormatInternalUnits( aModuleDrawing->GetStart0() ).c_str(),
-                      FormatInternalUnits( aModuleDrawing->GetEnd0() ).c_str() );
+                      IU_TEXT( aModuleDrawing->GetStart0() ).c_str(),
+                      IU_TEXT( aModuleDrawing->GetEnd0() ).c_str() );
         break;
 
     case S_ARC:     // Arc
         m_out->Print( aNestLevel, "(fp_arc (start %s) (end %s) (angle %s)",
-                      FormatInternalUnits( aModuleDrawing->GetStart0() ).c_str(),
-                      FormatInternalUnits( aModuleDrawing->GetEnd0() ).c_str(),
-                      FormatAngle( aModuleDrawing->GetAngle() ).c_str() );
+                      IU_TEXT( aModuleDrawing->GetStart0() ).c_str(),
+                      IU_TEXT( aModuleDrawing->GetEnd0() ).c_str(),
+                      ANGLE_TEXT( aModuleDrawing->GetAngle() ).c_str() );
         break;
 
     case S_POLYGON: // Polygonal segment
@@ -895,7 +928,7 @@ void PCB_IO::format( FP_SHAPE* aModuleDrawing, int aNestLevel ) const
                 }
 
                 m_out->Print( nestLevel, "%s(xy %s)",
-                              nestLevel ? "" : " ", FormatInternalUnits( outline.CPoint( ii ) ).c_str() );
+                              nestLevel ? "" : " ", IU_TEXT( outline.CPoint( ii ) ).c_str() );
             }
 
             m_out->Print( 0, ")" );
@@ -909,10 +942,10 @@ void PCB_IO::format( FP_SHAPE* aModuleDrawing, int aNestLevel ) const
 
     case S_CURVE:   // Bezier curve
         m_out->Print( aNestLevel, "(fp_curve (pts (xy %s) (xy %s) (xy %s) (xy %s))",
-                      FormatInternalUnits( aModuleDrawing->GetStart0() ).c_str(),
-                      FormatInternalUnits( aModuleDrawing->GetBezier0_C1() ).c_str(),
-                      FormatInternalUnits( aModuleDrawing->GetBezier0_C2() ).c_str(),
-                      FormatInternalUnits( aModuleDrawing->GetEnd0() ).c_str() );
+                      IU_TEXT( aModuleDrawing->GetStart0() ).c_str(),
+                      IU_TEXT( aModuleDrawing->GetBezier0_C1() ).c_str(),
+                      IU_TEXT( aModuleDrawing->GetBezier0_C2() ).c_str(),
+                      IU_TEXT( aModuleDrawing->GetEnd0() ).c_str() );
         break;
 
     default:
@@ -923,7 +956,7 @@ void PCB_IO::format( FP_SHAPE* aModuleDrawing, int aNestLevel ) const
 
     formatLayer( aModuleDrawing );
 
-    m_out->Print( 0, " (width %s)", FormatInternalUnits( aModuleDrawing->GetWidth() ).c_str() );
+    m_out->Print( 0, " (width %s)", IU_TEXT( aModuleDrawing->GetWidth() ).c_str() );
 
     m_out->Print( 0, " (tstamp %s)", TO_UTF8( aModuleDrawing->m_Uuid.AsString() ) );
 
@@ -988,10 +1021,10 @@ void PCB_IO::format( MODULE* aModule, int aNestLevel ) const
 
     if( !( m_ctl & CTL_OMIT_AT ) )
     {
-        m_out->Print( aNestLevel+1, "(at %s", FormatInternalUnits( aModule->GetPosition() ).c_str() );
+        m_out->Print( aNestLevel+1, "(at %s", IU_TEXT( aModule->GetPosition() ).c_str() );
 
         if( aModule->GetOrientation() != 0.0 )
-            m_out->Print( 0, " %s", FormatAngle( aModule->GetOrientation() ).c_str() );
+            m_out->Print( 0, " %s", ANGLE_TEXT( aModule->GetOrientation() ).c_str() );
 
         m_out->Print( 0, ")\n" );
     }
@@ -1025,11 +1058,11 @@ void PCB_IO::format( MODULE* aModule, int aNestLevel ) const
 
     if( aModule->GetLocalSolderMaskMargin() != 0 )
         m_out->Print( aNestLevel+1, "(solder_mask_margin %s)\n",
-                      FormatInternalUnits( aModule->GetLocalSolderMaskMargin() ).c_str() );
+                      IU_TEXT( aModule->GetLocalSolderMaskMargin() ).c_str() );
 
     if( aModule->GetLocalSolderPasteMargin() != 0 )
         m_out->Print( aNestLevel+1, "(solder_paste_margin %s)\n",
-                      FormatInternalUnits( aModule->GetLocalSolderPasteMargin() ).c_str() );
+                      IU_TEXT( aModule->GetLocalSolderPasteMargin() ).c_str() );
 
     if( aModule->GetLocalSolderPasteMarginRatio() != 0 )
         m_out->Print( aNestLevel+1, "(solder_paste_ratio %s)\n",
@@ -1037,7 +1070,7 @@ void PCB_IO::format( MODULE* aModule, int aNestLevel ) const
 
     if( aModule->GetLocalClearance() != 0 )
         m_out->Print( aNestLevel+1, "(clearance %s)\n",
-                      FormatInternalUnits( aModule->GetLocalClearance() ).c_str() );
+                      IU_TEXT( aModule->GetLocalClearance() ).c_str() );
 
     if( aModule->GetZoneConnection() != ZONE_CONNECTION::INHERITED )
         m_out->Print( aNestLevel+1, "(zone_connect %d)\n",
@@ -1045,11 +1078,11 @@ void PCB_IO::format( MODULE* aModule, int aNestLevel ) const
 
     if( aModule->GetThermalWidth() != 0 )
         m_out->Print( aNestLevel+1, "(thermal_width %s)\n",
-                      FormatInternalUnits( aModule->GetThermalWidth() ).c_str() );
+                      IU_TEXT( aModule->GetThermalWidth() ).c_str() );
 
     if( aModule->GetThermalGap() != 0 )
         m_out->Print( aNestLevel+1, "(thermal_gap %s)\n",
-                      FormatInternalUnits( aModule->GetThermalGap() ).c_str() );
+                      IU_TEXT( aModule->GetThermalGap() ).c_str() );
 
     // Attributes
     if( aModule->GetAttributes() )
@@ -1279,16 +1312,16 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
     m_out->Print( aNestLevel, "(pad %s %s %s",
                   m_out->Quotew( aPad->GetName() ).c_str(),
                   type, shape );
-    m_out->Print( 0, " (at %s", FormatInternalUnits( aPad->GetPos0() ).c_str() );
+    m_out->Print( 0, " (at %s", IU_TEXT( aPad->GetPos0() ).c_str() );
 
     if( aPad->GetOrientation() != 0.0 )
-        m_out->Print( 0, " %s", FormatAngle( aPad->GetOrientation() ).c_str() );
+        m_out->Print( 0, " %s", ANGLE_TEXT( aPad->GetOrientation() ).c_str() );
 
     m_out->Print( 0, ")" );
-    m_out->Print( 0, " (size %s)", FormatInternalUnits( aPad->GetSize() ).c_str() );
+    m_out->Print( 0, " (size %s)", IU_TEXT( aPad->GetSize() ).c_str() );
 
     if( (aPad->GetDelta().GetWidth()) != 0 || (aPad->GetDelta().GetHeight() != 0 ) )
-        m_out->Print( 0, " (rect_delta %s )", FormatInternalUnits( aPad->GetDelta() ).c_str() );
+        m_out->Print( 0, " (rect_delta %s )", IU_TEXT( aPad->GetDelta() ).c_str() );
 
     wxSize sz = aPad->GetDrillSize();
     wxPoint shapeoffset = aPad->GetOffset();
@@ -1302,13 +1335,13 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
             m_out->Print( 0, " oval" );
 
         if( sz.GetWidth() > 0 )
-            m_out->Print( 0,  " %s", FormatInternalUnits( sz.GetWidth() ).c_str() );
+            m_out->Print( 0,  " %s", IU_TEXT( sz.GetWidth() ).c_str() );
 
         if( sz.GetHeight() > 0  && sz.GetWidth() != sz.GetHeight() )
-            m_out->Print( 0,  " %s", FormatInternalUnits( sz.GetHeight() ).c_str() );
+            m_out->Print( 0,  " %s", IU_TEXT( sz.GetHeight() ).c_str() );
 
         if( (shapeoffset.x != 0) || (shapeoffset.y != 0) )
-            m_out->Print( 0, " (offset %s)", FormatInternalUnits( aPad->GetOffset() ).c_str() );
+            m_out->Print( 0, " (offset %s)", IU_TEXT( aPad->GetOffset() ).c_str() );
 
         m_out->Print( 0, ")" );
     }
@@ -1378,15 +1411,15 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
 
     if( aPad->GetPadToDieLength() != 0 )
         StrPrintf( &output, " (die_length %s)",
-                   FormatInternalUnits( aPad->GetPadToDieLength() ).c_str() );
+                   IU_TEXT( aPad->GetPadToDieLength() ).c_str() );
 
     if( aPad->GetLocalSolderMaskMargin() != 0 )
         StrPrintf( &output, " (solder_mask_margin %s)",
-                   FormatInternalUnits( aPad->GetLocalSolderMaskMargin() ).c_str() );
+                   IU_TEXT( aPad->GetLocalSolderMaskMargin() ).c_str() );
 
     if( aPad->GetLocalSolderPasteMargin() != 0 )
         StrPrintf( &output, " (solder_paste_margin %s)",
-                   FormatInternalUnits( aPad->GetLocalSolderPasteMargin() ).c_str() );
+                   IU_TEXT( aPad->GetLocalSolderPasteMargin() ).c_str() );
 
     if( aPad->GetLocalSolderPasteMarginRatio() != 0 )
         StrPrintf( &output, " (solder_paste_margin_ratio %s)",
@@ -1394,7 +1427,7 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
 
     if( aPad->GetLocalClearance() != 0 )
         StrPrintf( &output, " (clearance %s)",
-                   FormatInternalUnits( aPad->GetLocalClearance() ).c_str() );
+                   IU_TEXT( aPad->GetLocalClearance() ).c_str() );
 
     if( aPad->GetEffectiveZoneConnection() != ZONE_CONNECTION::INHERITED )
         StrPrintf( &output, " (zone_connect %d)",
@@ -1402,11 +1435,11 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
 
     if( aPad->GetThermalSpokeWidth() != 0 )
         StrPrintf( &output, " (thermal_width %s)",
-                   FormatInternalUnits( aPad->GetThermalSpokeWidth() ).c_str() );
+                   IU_TEXT( aPad->GetThermalSpokeWidth() ).c_str() );
 
     if( aPad->GetThermalGap() != 0 )
         StrPrintf( &output, " (thermal_gap %s)",
-                   FormatInternalUnits( aPad->GetThermalGap() ).c_str() );
+                   IU_TEXT( aPad->GetThermalGap() ).c_str() );
 
     if( output.size() )
     {
@@ -1451,40 +1484,40 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
             {
             case S_SEGMENT:         // usual segment : line with rounded ends
                 m_out->Print( nested_level, "(gr_line (start %s) (end %s) (width %s))",
-                              FormatInternalUnits( primitive->GetStart() ).c_str(),
-                              FormatInternalUnits( primitive->GetEnd() ).c_str(),
-                              FormatInternalUnits( primitive->GetWidth() ).c_str() );
+                              IU_TEXT( primitive->GetStart() ).c_str(),
+                              IU_TEXT( primitive->GetEnd() ).c_str(),
+                              IU_TEXT( primitive->GetWidth() ).c_str() );
                 break;
 
             case S_RECT:
                 m_out->Print( nested_level, "(gr_rect (start %s) (end %s) (width %s))",
-                              FormatInternalUnits( primitive->GetStart() ).c_str(),
-                              FormatInternalUnits( primitive->GetEnd() ).c_str(),
-                              FormatInternalUnits( primitive->GetWidth() ).c_str() );
+                              IU_TEXT( primitive->GetStart() ).c_str(),
+                              IU_TEXT( primitive->GetEnd() ).c_str(),
+                              IU_TEXT( primitive->GetWidth() ).c_str() );
                 break;
 
             case S_ARC:             // Arc with rounded ends
                 m_out->Print( nested_level, "(gr_arc (start %s) (end %s) (angle %s) (width %s))",
-                              FormatInternalUnits( primitive->GetStart() ).c_str(),
-                              FormatInternalUnits( primitive->GetEnd() ).c_str(),
-                              FormatAngle( primitive->GetAngle() ).c_str(),
-                              FormatInternalUnits( primitive->GetWidth() ).c_str() );
+                              IU_TEXT( primitive->GetStart() ).c_str(),
+                              IU_TEXT( primitive->GetEnd() ).c_str(),
+                              ANGLE_TEXT( primitive->GetAngle() ).c_str(),
+                              IU_TEXT( primitive->GetWidth() ).c_str() );
                 break;
 
             case S_CIRCLE:          //  ring or circle (circle if width == 0
                 m_out->Print( nested_level, "(gr_circle (center %s) (end %s) (width %s))",
-                              FormatInternalUnits( primitive->GetStart() ).c_str(),
-                              FormatInternalUnits( primitive->GetEnd() ).c_str(),
-                              FormatInternalUnits( primitive->GetWidth() ).c_str() );
+                              IU_TEXT( primitive->GetStart() ).c_str(),
+                              IU_TEXT( primitive->GetEnd() ).c_str(),
+                              IU_TEXT( primitive->GetWidth() ).c_str() );
                 break;
 
             case S_CURVE:          //  Bezier Curve
                 m_out->Print( aNestLevel, "(gr_curve (pts (xy %s) (xy %s) (xy %s) (xy %s)) (width %s))",
-                              FormatInternalUnits( primitive->GetStart() ).c_str(),
-                              FormatInternalUnits( primitive->GetBezControl1() ).c_str(),
-                              FormatInternalUnits( primitive->GetBezControl2() ).c_str(),
-                              FormatInternalUnits( primitive->GetEnd() ).c_str(),
-                              FormatInternalUnits( primitive->GetWidth() ).c_str() );
+                              IU_TEXT( primitive->GetStart() ).c_str(),
+                              IU_TEXT( primitive->GetBezControl1() ).c_str(),
+                              IU_TEXT( primitive->GetBezControl2() ).c_str(),
+                              IU_TEXT( primitive->GetEnd() ).c_str(),
+                              IU_TEXT( primitive->GetWidth() ).c_str() );
                 break;
 
             case S_POLYGON:         // polygon
@@ -1501,10 +1534,10 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
                 {
                     if( newLine == 0 )
                         m_out->Print( nested_level+1, "(xy %s)",
-                                      FormatInternalUnits( (wxPoint) pt ).c_str() );
+                                      IU_TEXT( pt ).c_str() );
                     else
                         m_out->Print( 0, " (xy %s)",
-                                      FormatInternalUnits( (wxPoint) pt ).c_str() );
+                                      IU_TEXT( pt ).c_str() );
 
                     if( ++newLine > 4 || !ADVANCED_CFG::GetCfg().m_CompactSave )
                     {
@@ -1513,7 +1546,7 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
                     }
                 }
 
-                m_out->Print( 0, ") (width %s))", FormatInternalUnits( primitive->GetWidth() ).c_str() );
+                m_out->Print( 0, ") (width %s))", IU_TEXT( primitive->GetWidth() ).c_str() );
                 }
                 break;
 
@@ -1536,10 +1569,10 @@ void PCB_IO::format( PCB_TEXT* aText, int aNestLevel ) const
 {
     m_out->Print( aNestLevel, "(gr_text %s (at %s",
                   m_out->Quotew( aText->GetText() ).c_str(),
-                  FormatInternalUnits( aText->GetTextPos() ).c_str() );
+                  IU_TEXT( aText->GetTextPos() ).c_str() );
 
     if( aText->GetTextAngle() != 0.0 )
-        m_out->Print( 0, " %s", FormatAngle( aText->GetTextAngle() ).c_str() );
+        m_out->Print( 0, " %s", ANGLE_TEXT( aText->GetTextAngle() ).c_str() );
 
     m_out->Print( 0, ")" );
 
@@ -1596,7 +1629,7 @@ void PCB_IO::format( FP_TEXT* aText, int aNestLevel ) const
     m_out->Print( aNestLevel, "(fp_text %s %s (at %s",
                   type.c_str(),
                   m_out->Quotew( aText->GetText() ).c_str(),
-                  FormatInternalUnits( aText->GetPos0() ).c_str() );
+                  IU_TEXT( aText->GetPos0() ).c_str() );
 
     // Due to Pcbnew history, fp_text angle is saved as an absolute on screen angle,
     // but internally the angle is held relative to its parent footprint.  parent
@@ -1623,7 +1656,7 @@ void PCB_IO::format( FP_TEXT* aText, int aNestLevel ) const
     }
 
     if( orient != 0.0 )
-        m_out->Print( 0, " %s", FormatAngle( orient ).c_str() );
+        m_out->Print( 0, " %s", ANGLE_TEXT( orient ).c_str() );
 
     if( !aText->IsKeepUpright() )
         m_out->Print( 0, " unlocked" );
@@ -1678,11 +1711,11 @@ void PCB_IO::format( TRACK* aTrack, int aNestLevel ) const
         }
 
         m_out->Print( 0, " (at %s) (size %s)",
-                      FormatInternalUnits( aTrack->GetStart() ).c_str(),
-                      FormatInternalUnits( aTrack->GetWidth() ).c_str() );
+                      IU_TEXT( aTrack->GetStart() ).c_str(),
+                      IU_TEXT( aTrack->GetWidth() ).c_str() );
 
         if( via->GetDrill() != UNDEFINED_DRILL_DIAMETER )
-            m_out->Print( 0, " (drill %s)", FormatInternalUnits( via->GetDrill() ).c_str() );
+            m_out->Print( 0, " (drill %s)", IU_TEXT( via->GetDrill() ).c_str() );
 
         m_out->Print( 0, " (layers %s %s)",
                       m_out->Quotew( LSET::Name( layer1 ) ).c_str(),
@@ -1701,19 +1734,19 @@ void PCB_IO::format( TRACK* aTrack, int aNestLevel ) const
         const ARC* arc = static_cast<const ARC*>( aTrack );
 
         m_out->Print( aNestLevel, "(arc (start %s) (mid %s) (end %s) (width %s)",
-                FormatInternalUnits( arc->GetStart() ).c_str(),
-                FormatInternalUnits( arc->GetMid() ).c_str(),
-                FormatInternalUnits( arc->GetEnd() ).c_str(),
-                FormatInternalUnits( arc->GetWidth() ).c_str() );
+                IU_TEXT( arc->GetStart() ).c_str(),
+                IU_TEXT( arc->GetMid() ).c_str(),
+                IU_TEXT( arc->GetEnd() ).c_str(),
+                IU_TEXT( arc->GetWidth() ).c_str() );
 
         m_out->Print( 0, " (layer %s)", m_out->Quotew( LSET::Name( arc->GetLayer() ) ).c_str() );
     }
     else
     {
         m_out->Print( aNestLevel, "(segment (start %s) (end %s) (width %s)",
-                      FormatInternalUnits( aTrack->GetStart() ).c_str(),
-                      FormatInternalUnits( aTrack->GetEnd() ).c_str(),
-                      FormatInternalUnits( aTrack->GetWidth() ).c_str() );
+                      IU_TEXT( aTrack->GetStart() ).c_str(),
+                      IU_TEXT( aTrack->GetEnd() ).c_str(),
+                      IU_TEXT( aTrack->GetWidth() ).c_str() );
 
         m_out->Print( 0, " (layer %s)", m_out->Quotew( LSET::Name( aTrack->GetLayer() ) ).c_str() );
     }
@@ -1765,7 +1798,7 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
     }
 
     m_out->Print( 0, " (hatch %s %s)\n", hatch.c_str(),
-                  FormatInternalUnits( aZone->GetBorderHatchPitch() ).c_str() );
+                  IU_TEXT( aZone->GetBorderHatchPitch() ).c_str() );
 
     if( aZone->GetPriority() > 0 )
         m_out->Print( aNestLevel+1, "(priority %d)\n", aZone->GetPriority() );
@@ -1792,10 +1825,10 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
     }
 
     m_out->Print( 0, " (clearance %s))\n",
-                  FormatInternalUnits( aZone->GetLocalClearance() ).c_str() );
+                  IU_TEXT( aZone->GetLocalClearance() ).c_str() );
 
     m_out->Print( aNestLevel+1, "(min_thickness %s)",
-                  FormatInternalUnits( aZone->GetMinThickness() ).c_str() );
+                  IU_TEXT( aZone->GetMinThickness() ).c_str() );
 
     // write it only if V 6.O version option is used (i.e. do not write if the "legacy"
     // algorithm is used)
@@ -1825,8 +1858,8 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
         m_out->Print( 0, " (mode hatch)" );
 
     m_out->Print( 0, " (thermal_gap %s) (thermal_bridge_width %s)",
-                  FormatInternalUnits( aZone->GetThermalReliefGap() ).c_str(),
-                  FormatInternalUnits( aZone->GetThermalReliefSpokeWidth() ).c_str() );
+                  IU_TEXT( aZone->GetThermalReliefGap() ).c_str(),
+                  IU_TEXT( aZone->GetThermalReliefSpokeWidth() ).c_str() );
 
     if( aZone->GetCornerSmoothingType() != ZONE_SETTINGS::SMOOTHING_NONE )
     {
@@ -1850,22 +1883,22 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
 
         if( aZone->GetCornerRadius() != 0 )
             m_out->Print( 0, " (radius %s)",
-                          FormatInternalUnits( aZone->GetCornerRadius() ).c_str() );
+                          IU_TEXT( aZone->GetCornerRadius() ).c_str() );
     }
 
     if( aZone->GetIslandRemovalMode() != ISLAND_REMOVAL_MODE::ALWAYS )
     {
         m_out->Print( 0, " (island_removal_mode %d) (island_area_min %s)",
                       static_cast<int>( aZone->GetIslandRemovalMode() ),
-                      FormatInternalUnits( aZone->GetMinIslandArea() / IU_PER_MM ).c_str() );
+                      IU_TEXT( aZone->GetMinIslandArea() / IU_PER_MM ).c_str() );
     }
 
     if( aZone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN )
     {
         m_out->Print( 0, "\n" );
         m_out->Print( aNestLevel+2, "(hatch_thickness %s) (hatch_gap %s) (hatch_orientation %s)",
-                      FormatInternalUnits( aZone->GetHatchThickness() ).c_str(),
-                      FormatInternalUnits( aZone->GetHatchGap() ).c_str(),
+                      IU_TEXT( aZone->GetHatchThickness() ).c_str(),
+                      IU_TEXT( aZone->GetHatchGap() ).c_str(),
                       Double2Str( aZone->GetHatchOrientation() ).c_str() );
 
         if( aZone->GetHatchSmoothingLevel() > 0 )
@@ -1904,12 +1937,12 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
 
             if( newLine == 0 )
                 m_out->Print( aNestLevel+3, "(xy %s %s)",
-                              FormatInternalUnits( iterator->x ).c_str(),
-                              FormatInternalUnits( iterator->y ).c_str() );
+                              IU_TEXT( iterator->x ).c_str(),
+                              IU_TEXT( iterator->y ).c_str() );
             else
                 m_out->Print( 0, " (xy %s %s)",
-                              FormatInternalUnits( iterator->x ).c_str(),
-                              FormatInternalUnits( iterator->y ).c_str() );
+                              IU_TEXT( iterator->x ).c_str(),
+                              IU_TEXT( iterator->y ).c_str() );
 
             if( newLine < 4 && ADVANCED_CFG::GetCfg().m_CompactSave )
             {
@@ -1976,11 +2009,11 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
 
                 if( newLine == 0 )
                     m_out->Print( aNestLevel + 3, "(xy %s %s)",
-                            FormatInternalUnits( it->x ).c_str(),
-                            FormatInternalUnits( it->y ).c_str() );
+                            IU_TEXT( it->x ).c_str(),
+                            IU_TEXT( it->y ).c_str() );
                 else
-                    m_out->Print( 0, " (xy %s %s)", FormatInternalUnits( it->x ).c_str(),
-                            FormatInternalUnits( it->y ).c_str() );
+                    m_out->Print( 0, " (xy %s %s)", IU_TEXT( it->x ).c_str(),
+                            IU_TEXT( it->y ).c_str() );
 
                 if( newLine < 4 && ADVANCED_CFG::GetCfg().m_CompactSave )
                 {
@@ -2021,8 +2054,8 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
             for( ZONE_SEGMENT_FILL::const_iterator it = segs.begin(); it != segs.end(); ++it )
             {
                 m_out->Print( aNestLevel + 2, "(pts (xy %s) (xy %s))\n",
-                        FormatInternalUnits( wxPoint( it->A ) ).c_str(),
-                        FormatInternalUnits( wxPoint( it->B ) ).c_str() );
+                        IU_TEXT( wxPoint( it->A ) ).c_str(),
+                        IU_TEXT( wxPoint( it->B ) ).c_str() );
             }
 
             m_out->Print( aNestLevel + 1, ")\n" );
@@ -2054,7 +2087,7 @@ PCB_IO::~PCB_IO()
 
 BOARD* PCB_IO::Load( const wxString& aFileName, BOARD* aAppendToMe, const PROPERTIES* aProperties )
 {
-    FILE_LINE_READER reader( aFileName );
+    MAPPED_FILE_LINE_READER reader( aFileName );
 
     BOARD* board = DoLoad( reader, aAppendToMe, aProperties );
 
@@ -2128,7 +2161,6 @@ void PCB_IO::validateCache( const wxString& aLibraryPath, bool checkModified )
 void PCB_IO::FootprintEnumerate( wxArrayString& aFootprintNames, const wxString& aLibPath,
                                  bool aBestEfforts, const PROPERTIES* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
     wxDir     dir( aLibPath );
     wxString  errorMsg;
 
@@ -2159,8 +2191,6 @@ const MODULE* PCB_IO::getFootprint( const wxString& aLibraryPath,
                                     const PROPERTIES* aProperties,
                                     bool checkModified )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     init( aProperties );
 
     try
@@ -2440,8 +2470,6 @@ bool PCB_IO::FootprintLibDelete( const wxString& aLibraryPath, const PROPERTIES*
 
 bool PCB_IO::IsFootprintLibWritable( const wxString& aLibraryPath )
 {
-    LOCALE_IO   toggle;
-
     init( NULL );
 
     validateCache( aLibraryPath );
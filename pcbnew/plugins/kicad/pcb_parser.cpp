@@ -27,7 +27,10 @@
  * @brief Pcbnew s-expression file format parser implementation.
  */
 
+#include <atomic>
 #include <cerrno>
+#include <future>
+#include <thread>
 #include <common.h>
 #include <confirm.h>
 #include <macros.h>
@@ -49,7 +52,6 @@
 #include <plugins/kicad/kicad_plugin.h>
 #include <pcb_plot_params_parser.h>
 #include <pcb_plot_params.h>
-#include <locale_io.h>
 #include <zones.h>
 #include <plugins/kicad/pcb_parser.h>
 #include <convert_basic_shapes_to_polygon.h>    // for RECT_CHAMFER_POSITIONS definition
@@ -58,9 +60,25 @@
 using namespace PCB_KEYS_T;
 
 
+/**
+ * BLOCK_LINE_READER
+ * reads the text of a BOARD_BLOCK, numbering its lines as they are numbered in the file.
+ */
+class BLOCK_LINE_READER : public STRING_LINE_READER
+{
+public:
+    BLOCK_LINE_READER( const std::string& aText, const wxString& aSource, int aLineNumber ) :
+        STRING_LINE_READER( aText, aSource )
+    {
+        m_lineNum = aLineNumber - 1;
+    }
+};
+
+
 void PCB_PARSER::init()
 {
     m_showLegacyZoneWarning = true;
+    m_deferZoneFills = ADVANCED_CFG::GetCfg().m_DeferZoneFillLoad;
     m_tooRecent = false;
     m_requiredVersion = 0;
     m_layerIndices.clear();
@@ -138,11 +156,12 @@ void PCB_PARSER::pushValueIntoMap( int aIndex, int aValue )
 
 double PCB_PARSER::parseDouble()
 {
-    char* tmp;
+    const char* tmp;
 
     errno = 0;
 
-    double fval = strtod( CurText(), &tmp );
+    // Not strtod(): the files are in the "C" locale, whatever the locale of the process is
+    double fval = StrToDouble( CurText(), &tmp );
 
     if( errno )
     {
@@ -486,7 +505,6 @@ BOARD_ITEM* PCB_PARSER::Parse()
 {
     T               token;
     BOARD_ITEM*     item;
-    LOCALE_IO       toggle;
 
     m_groupInfos.clear();
 
@@ -529,7 +547,16 @@ BOARD* PCB_PARSER::parseBOARD()
 {
     try
     {
-        return parseBOARD_unchecked();
+        try
+        {
+            return parseBOARD_unchecked();
+        }
+        catch( const IO_ERROR& )
+        {
+            // An error in an item set aside comes first in the file, so it is the one to report
+            parseBoardBlocks();
+            throw;
+        }
     }
     catch( const PARSE_ERROR& parse_error )
     {
@@ -558,6 +585,13 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
         if( token == T_page && m_requiredVersion <= 20200119 )
             token = T_paper;
 
+        // Anything else may depend on, or be ordered after, the items set aside before it
+        if( token != T_module && token != T_segment && token != T_arc && token != T_via
+                && token != T_zone )
+        {
+            parseBoardBlocks();
+        }
+
         switch( token )
         {
         case T_general:
@@ -611,29 +645,17 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
             break;
 
         case T_module:
-            m_board->Add( parseMODULE(), ADD_MODE::APPEND );
-            break;
-
         case T_segment:
-            m_board->Add( parseTRACK(), ADD_MODE::APPEND );
-            break;
-
         case T_arc:
-            m_board->Add( parseARC(), ADD_MODE::APPEND );
+        case T_via:
+        case T_zone:
+            readBoardBlock();
             break;
 
         case T_group:
             parseGROUP( m_board );
             break;
 
-        case T_via:
-            m_board->Add( parseVIA(), ADD_MODE::APPEND );
-            break;
-
-        case T_zone:
-            m_board->Add( parseZONE_CONTAINER( m_board ), ADD_MODE::APPEND );
-            break;
-
         case T_target:
             m_board->Add( parsePCB_TARGET(), ADD_MODE::APPEND );
             break;
@@ -645,6 +667,8 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
         }
     }
 
+    parseBoardBlocks();
+
     m_board->SetProperties( properties );
 
     if( m_undefinedLayers.size() > 0 )
@@ -730,6 +754,192 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
 }
 
 
+void PCB_PARSER::readBoardBlock()
+{
+    m_boardBlocks.emplace_back();
+
+    BOARD_BLOCK& block = m_boardBlocks.back();
+
+    // Pad the first line so errors are reported at the offsets they have in the file
+    block.text.assign( curOffset, ' ' );
+    block.text += CurStr();
+    block.lineNumber = CurLineNumber();
+
+    // If the file ends first, parsing the block reports it
+    ReadSexprText( block.text );
+}
+
+
+void PCB_PARSER::parseBoardBlock( PCB_PARSER& aParser, BOARD_BLOCK& aBlock,
+                                  const wxString& aSource )
+{
+    BLOCK_LINE_READER reader( aBlock.text, aSource, aBlock.lineNumber );
+
+    aParser.PushReader( &reader );
+
+    try
+    {
+        switch( aParser.NextTok() )
+        {
+        case T_module:  aBlock.item = aParser.parseMODULE();                             break;
+        case T_segment: aBlock.item = aParser.parseTRACK();                              break;
+        case T_arc:     aBlock.item = aParser.parseARC();                                break;
+        case T_via:     aBlock.item = aParser.parseVIA();                                break;
+        default:        aBlock.item = aParser.parseZONE_CONTAINER( aParser.m_board );    break;
+        }
+
+        aBlock.groupInfos = std::move( aParser.m_groupInfos );
+        aBlock.resetKIIDMap = std::move( aParser.m_resetKIIDMap );
+    }
+    catch( const BLOCK_NEEDS_MAIN_THREAD& )
+    {
+        aBlock.needsMainThread = true;
+    }
+    catch( ... )
+    {
+        aBlock.error = std::current_exception();
+    }
+
+    aParser.PopReader();
+    aParser.m_groupInfos.clear();
+    aParser.m_resetKIIDMap.clear();
+}
+
+
+void PCB_PARSER::parseBoardBlocks()
+{
+    if( m_boardBlocks.empty() )
+        return;
+
+    std::vector<BOARD_BLOCK> blocks;
+    blocks.swap( m_boardBlocks );
+
+    const wxString source = CurSource();
+
+    auto makeParser =
+            [&]( bool aIsWorker )
+            {
+                std::unique_ptr<PCB_PARSER> parser = std::make_unique<PCB_PARSER>();
+
+                parser->m_board = m_board;
+                parser->m_layerIndices = m_layerIndices;
+                parser->m_layerMasks = m_layerMasks;
+                parser->m_netCodes = m_netCodes;
+                parser->m_tooRecent = m_tooRecent;
+                parser->m_requiredVersion = m_requiredVersion;
+                parser->m_resetKIIDs = m_resetKIIDs;
+                parser->m_showLegacyZoneWarning = m_showLegacyZoneWarning;
+                parser->m_deferZoneFills = m_deferZoneFills;
+                parser->m_isWorker = aIsWorker;
+
+                return parser;
+            };
+
+    auto mergeParser =
+            [&]( const PCB_PARSER& aParser )
+            {
+                m_undefinedLayers.insert( aParser.m_undefinedLayers.begin(),
+                                          aParser.m_undefinedLayers.end() );
+                m_requiredVersion = std::max( m_requiredVersion, aParser.m_requiredVersion );
+                m_tooRecent = m_tooRecent || aParser.m_tooRecent;
+            };
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   ( blocks.size() + 63 ) / 64 );
+    parallelThreadCount = std::max<size_t>( parallelThreadCount, 1 );
+
+    std::vector<std::unique_ptr<PCB_PARSER>> parsers;
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        parsers.push_back( makeParser( true ) );
+
+    std::atomic<size_t> nextBlock( 0 );
+
+    auto parse_lambda =
+            [&]( PCB_PARSER* aParser ) -> size_t
+            {
+                for( size_t i = nextBlock++; i < blocks.size(); i = nextBlock++ )
+                    parseBoardBlock( *aParser, blocks[i], source );
+
+                return 1;
+            };
+
+    if( parallelThreadCount <= 1 )
+    {
+        parse_lambda( parsers[0].get() );
+    }
+    else
+    {
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, parse_lambda, parsers[ii].get() );
+
+        for( const std::future<size_t>& ret : returns )
+            ret.wait();
+    }
+
+    for( const std::unique_ptr<PCB_PARSER>& parser : parsers )
+        mergeParser( *parser );
+
+    // Add the items to the board in file order, on this thread
+    size_t ii = 0;
+
+    try
+    {
+        for( ; ii < blocks.size(); ++ii )
+        {
+            BOARD_BLOCK& block = blocks[ii];
+
+            if( block.needsMainThread )
+            {
+                std::unique_ptr<PCB_PARSER> parser = makeParser( false );
+
+                parseBoardBlock( *parser, block, source );
+                mergeParser( *parser );
+                m_showLegacyZoneWarning = parser->m_showLegacyZoneWarning;
+
+                if( parser->m_netCodes != m_netCodes )
+                {
+                    // A net was added: the items after this one must be parsed again with it
+                    for( size_t jj = ii + 1; jj < blocks.size(); ++jj )
+                    {
+                        BOARD_BLOCK& later = blocks[jj];
+
+                        delete later.item;
+                        later.item = nullptr;
+                        later.error = nullptr;
+                        later.groupInfos.clear();
+                        later.resetKIIDMap.clear();
+                        later.needsMainThread = true;
+                    }
+
+                    m_netCodes = parser->m_netCodes;
+                }
+            }
+
+            if( block.error )
+                std::rethrow_exception( block.error );
+
+            m_groupInfos.insert( m_groupInfos.end(),
+                                 std::make_move_iterator( block.groupInfos.begin() ),
+                                 std::make_move_iterator( block.groupInfos.end() ) );
+            m_resetKIIDMap.insert( block.resetKIIDMap.begin(), block.resetKIIDMap.end() );
+
+            m_board->Add( block.item, ADD_MODE::APPEND );
+            block.item = nullptr;
+        }
+    }
+    catch( ... )
+    {
+        for( ; ii < blocks.size(); ++ii )
+            delete blocks[ii].item;
+
+        throw;
+    }
+}
+
+
 void PCB_PARSER::resolveGroups( BOARD_ITEM* aParent )
 {
     auto getItem = [&]( const KIID& aId )
@@ -4273,6 +4483,8 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
 
     // bigger scope since each filled_polygon is concatenated in here
     std::map<PCB_LAYER_ID, SHAPE_POLY_SET> pts;
+    std::map<PCB_LAYER_ID, std::string>    unparsedPts;     // or here, if m_deferZoneFills
+    std::map<PCB_LAYER_ID, int>            unparsedOutlines;
     bool inModule = false;
     PCB_LAYER_ID filledLayer;
     bool addedFilledPolygons = false;
@@ -4419,6 +4631,10 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
 
                     if( token == T_segment )    // deprecated
                     {
+                        // The user may have to be asked, which only the main thread can do
+                        if( m_isWorker )
+                            throw BLOCK_NEEDS_MAIN_THREAD();
+
                         // SEGMENT fill mode no longer supported.  Make sure user is OK with converting them.
                         if( m_showLegacyZoneWarning )
                         {
@@ -4680,6 +4896,28 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
                 if( token != T_pts )
                     Expecting( T_pts );
 
+                if( m_deferZoneFills )
+                {
+                    // Keep the points as they are in the file, for parseFilledPolys()
+                    int idx = unparsedOutlines[filledLayer]++;
+
+                    if( island )
+                        zone->SetIsIsland( filledLayer, idx );
+
+                    std::string& text = unparsedPts[filledLayer];
+
+                    ReadSexprText( text );
+                    text += '\n';
+
+                    if( CurTok() != T_RIGHT )   // the file ended first
+                        Expecting( T_RIGHT );
+
+                    NeedRIGHT();
+
+                    addedFilledPolygons = true;
+                    break;
+                }
+
                 if( !pts.count( filledLayer ) )
                     pts[filledLayer] = SHAPE_POLY_SET();
 
@@ -4766,7 +5004,22 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
         zone->SetBorderDisplayStyle( hatchStyle, hatchPitch, true );
     }
 
-    if( addedFilledPolygons )
+    if( addedFilledPolygons && !unparsedPts.empty() )
+    {
+        zone->SetFilledPolysLoader(
+                [text = std::move( unparsedPts ), source = CurSource()](
+                        std::map<PCB_LAYER_ID, SHAPE_POLY_SET>& aFilledPolys ) -> bool
+                {
+                    for( const std::pair<const PCB_LAYER_ID, std::string>& pair : text )
+                    {
+                        if( !parseFilledPolys( pair.second, source, aFilledPolys[pair.first] ) )
+                            return false;
+                    }
+
+                    return true;
+                } );
+    }
+    else if( addedFilledPolygons )
     {
         for( auto& pair : pts )
             zone->SetFilledPolysList( pair.first, pair.second );
@@ -4794,6 +5047,10 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
             zone->SetNetCode( net->GetNet() );
         else    // Not existing net: add a new net to keep trace of the zone netname
         {
+            // Only the main thread can add to the board
+            if( m_isWorker )
+                throw BLOCK_NEEDS_MAIN_THREAD();
+
             int newnetcode = m_board->GetNetCount();
             net = new NETINFO_ITEM( m_board, netnameFromfile, newnetcode );
             m_board->Add( net );
@@ -4812,6 +5069,35 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
 }
 
 
+bool PCB_PARSER::parseFilledPolys( const std::string& aText, const wxString& aSource,
+                                   SHAPE_POLY_SET& aPolys )
+{
+    STRING_LINE_READER reader( aText, aSource );
+    PCB_PARSER         parser( &reader );
+
+    try
+    {
+        // Each outline is its points, up to the paren closing "(pts"
+        for( T token = parser.NextTok();  token != T_EOF;  token = parser.NextTok() )
+        {
+            aPolys.NewOutline();
+
+            for( ;  token != T_RIGHT;  token = parser.NextTok() )
+                aPolys.Append( parser.parseXY() );
+        }
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        // Too late to refuse the file; the zone will need a refill
+        wxLogError( _( "Error reading zone fill: %s" ), ioe.What() );
+        aPolys.RemoveAllContours();
+        return false;
+    }
+
+    return true;
+}
+
+
 PCB_TARGET* PCB_PARSER::parsePCB_TARGET()
 {
     wxCHECK_MSG( CurTok() == T_target, NULL,
@@ -32,10 +32,12 @@
 
 #include <convert_to_biu.h>                      // IU_PER_MM
 #include <hashtables.h>
+#include <kicad_string.h>                        // StrToDouble, StrToLong
 #include <layers_id_colors_and_visibility.h>     // PCB_LAYER_ID
 #include <math/util.h>                           // KiROUND, Clamp
 #include <pcb_lexer.h>
 
+#include <exception>
 #include <unordered_map>
 
 
@@ -84,6 +86,7 @@ class PCB_PARSER : public PCB_LEXER
     KIID_MAP            m_resetKIIDMap;     ///< if resetting UUIDs, record new ones to update groups with
 
     bool                m_showLegacyZoneWarning;
+    bool                m_deferZoneFills;   ///< leave zone filled polygons to parse when used
 
     // Group membership info refers to other Uuids in the file.
     // We don't want to rely on group declarations being last in the file, so
@@ -99,6 +102,27 @@ class PCB_PARSER : public PCB_LEXER
 
     std::vector<GROUP_INFO> m_groupInfos;
 
+    // Footprints, tracks and zones make up most of a board file, and don't depend on each
+    // other.  Their text is set aside while reading the board, and parsed on worker threads
+    // before the next item that is not one of them.  They are added to the board in file
+    // order, with the first error in the file thrown as it would be when parsing in order.
+    struct BOARD_BLOCK
+    {
+        std::string             text;               ///< from the keyword to the closing ')'
+        int                     lineNumber = 0;     ///< line of the keyword in the file
+        BOARD_ITEM*             item = nullptr;
+        std::exception_ptr      error;
+        bool                    needsMainThread = false; ///< parsing must ask the user something
+        std::vector<GROUP_INFO> groupInfos;
+        KIID_MAP                resetKIIDMap;
+    };
+
+    std::vector<BOARD_BLOCK> m_boardBlocks;
+    bool                     m_isWorker;    ///< parsing a BOARD_BLOCK on a worker thread
+
+    ///> Thrown by a worker thread for a BOARD_BLOCK which must be parsed on the main thread
+    struct BLOCK_NEEDS_MAIN_THREAD {};
+
     ///> Converts net code using the mapping table if available,
     ///> otherwise returns unchanged net code if < 0 or if is is out of range
     inline int getNetCode( int aNetCode )
@@ -179,6 +203,16 @@ class PCB_PARSER : public PCB_LEXER
     TRACK*          parseTRACK();
     VIA*            parseVIA();
     ZONE_CONTAINER* parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent );
+
+    /**
+     * Parses the point lists of the filled polygons of a zone, set aside when loading it
+     * with m_deferZoneFills, into @a aPolys.  Errors are logged and leave the fill empty.
+     *
+     * @return false on error, for the zone to be marked as needing a refill.
+     */
+    static bool parseFilledPolys( const std::string& aText, const wxString& aSource,
+                                  SHAPE_POLY_SET& aPolys );
+
     PCB_TARGET*     parsePCB_TARGET();
     MARKER_PCB*     parseMARKER( BOARD_ITEM_CONTAINER* aParent );
     BOARD*          parseBOARD();
@@ -312,7 +346,7 @@ class PCB_PARSER : public PCB_LEXER
 
     inline int parseInt()
     {
-        return (int)strtol( CurText(), NULL, 10 );
+        return (int) StrToLong( CurText(), NULL, 10 );
     }
 
     inline int parseInt( const char* aExpected )
@@ -324,7 +358,7 @@ class PCB_PARSER : public PCB_LEXER
     inline long parseHex()
     {
         NextTok();
-        return strtol( CurText(), NULL, 16 );
+        return StrToLong( CurText(), NULL, 16 );
     }
 
     bool parseBool();
@@ -346,12 +380,30 @@ class PCB_PARSER : public PCB_LEXER
      */
     void resolveGroups( BOARD_ITEM* aParent );
 
+    /**
+     * Sets aside the text of the board item whose keyword is the current token, to be parsed
+     * by parseBoardBlocks().  Expects to start on the keyword, and eats the closing paren.
+     */
+    void readBoardBlock();
+
+    /**
+     * Parses the board items set aside by readBoardBlock(), and adds them to the board.
+     */
+    void parseBoardBlocks();
+
+    /**
+     * Parses @a aBlock with @a aParser, a parser set up like this one for a single block.
+     */
+    static void parseBoardBlock( PCB_PARSER& aParser, BOARD_BLOCK& aBlock,
+                                 const wxString& aSource );
+
 public:
 
     PCB_PARSER( LINE_READER* aReader = NULL ) :
         PCB_LEXER( aReader ),
         m_board( 0 ),
-        m_resetKIIDs( false )
+        m_resetKIIDs( false ),
+        m_isWorker( false )
     {
         init();
     }
@@ -381,6 +433,17 @@ public:
     }
 
     BOARD_ITEM* Parse();
+
+    /**
+     * Leave the filled polygons of zones to be parsed when they are first used, which makes
+     * loading a board faster when they are not.  Defaults to the advanced config, and is
+     * reset to it by SetBoard().
+     */
+    void SetDeferZoneFills( bool aDefer )
+    {
+        m_deferZoneFills = aDefer;
+    }
+
     /**
      * Function parseMODULE
      * @param aInitialComments may be a pointer to a heap allocated initial comment block
@@ -110,6 +110,15 @@ class PcbnewPyShell(editor.EditorNotebookFrame):
 
         self.LoadHistory()
 
+        # The commands edit the board directly, without telling what they changed
+        dispatcher.connect(receiver=self.OnPush, signal='Interpreter.push')
+
+    def OnPush(self, more=False, **kwargs):
+        """Called by the interpreter after each command."""
+        board = pcbnew.GetBoard()
+        if board and not more:
+            board.OnUntrackedChanges()
+
     def OnAbout(self, event):
         """Display an About window."""
         title = 'About : KiCad:PCBNEW - Python Shell'
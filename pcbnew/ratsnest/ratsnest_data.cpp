@@ -40,7 +40,9 @@ using namespace std::placeholders;
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <limits>
+#include <unordered_map>
 
 #include <delaunator.hpp>
 
@@ -106,165 +108,931 @@ private:
     std::vector<int> m_depth;
 };
 
-void RN_NET::kruskalMST( const std::vector<CN_EDGE> &aEdges )
+// Checks if all nodes in aNodes lie on a single line. Requires the nodes to
+// have unique coordinates!
+static bool areNodesColinear( const std::vector<CN_ANCHOR_PTR>& aNodes )
 {
-    disjoint_set dset( m_nodes.size() );
-
-    m_rnEdges.clear();
-
-    int i = 0;
+    if ( aNodes.size() <= 2 )
+        return true;
 
-    for( auto& node : m_nodes )
-        node->SetTag( i++ );
+    const VECTOR2I p0( aNodes[0]->Pos() );
+    const VECTOR2I v0( aNodes[1]->Pos() - p0 );
 
-    for( auto& tmp : aEdges )
+    for( unsigned i = 2; i < aNodes.size(); i++ )
     {
-        int u = tmp.GetSourceNode()->GetTag();
-        int v = tmp.GetTargetNode()->GetTag();
+        const VECTOR2I v1 = aNodes[i]->Pos() - p0;
 
-        if( dset.unite( u, v ) )
-        {
-            if( tmp.GetWeight() > 0 )
-                m_rnEdges.push_back( tmp );
-        }
+        if( v0.Cross( v1 ) != 0 )
+            return false;
     }
+
+    return true;
 }
 
 
+/**
+ * Delaunay triangulation of the anchors of a net, kept from one update to the next.
+ *
+ * Moving a footprint changes a handful of anchor positions of a net, possibly one with
+ * thousands of them.  Instead of triangulating everything again, the vertices that went away
+ * are removed from the triangulation and the new ones inserted, both of which only touch the
+ * triangles around them, and the edge list (kept sorted by length, ready for Kruskal) is
+ * patched with the edges that changed.
+ *
+ * The predicates are exact, so cocircular and collinear anchors (the norm on a PCB) don't
+ * need tie breaking.
+ */
 class RN_NET::TRIANGULATOR_STATE
 {
-private:
-    std::multiset<CN_ANCHOR_PTR, CN_PTR_CMP> m_allNodes;
+public:
+    /**
+     * An edge of the triangulation, between two vertex ids.
+     */
+    struct EDGE
+    {
+        unsigned m_weight;
+        int      m_a;
+        int      m_b;
+
+        bool operator<( const EDGE& aOther ) const
+        {
+            if( m_weight != aOther.m_weight )
+                return m_weight < aOther.m_weight;
+            else if( m_a != aOther.m_a )
+                return m_a < aOther.m_a;
+            else
+                return m_b < aOther.m_b;
+        }
+    };
 
+    void Clear()
+    {
+        m_points.clear();
+        m_vertexTri.clear();
+        m_freeVertices.clear();
+        m_tris.clear();
+        m_freeTris.clear();
+        m_sorted.clear();
+        m_edges.clear();
+        m_edgeDelta.clear();
+        m_hint = -1;
+    }
 
-    // Checks if all nodes in aNodes lie on a single line. Requires the nodes to
-    // have unique coordinates!
-    bool areNodesColinear( const std::vector<CN_ANCHOR_PTR>& aNodes ) const
+    /**
+     * Brings the triangulation in line with a new set of points.
+     * @param aPositions are the points, distinct, not all on a line and sorted the way
+     *                   CN_PTR_CMP sorts the nodes.
+     * @param aIds receives the vertex id of each point, as used by Edges().
+     * @return false if the points couldn't be triangulated.
+     */
+    bool Update( const std::vector<VECTOR2I>& aPositions, std::vector<int>& aIds )
     {
-        if ( aNodes.size() <= 2 )
-            return true;
+        std::vector<std::pair<VECTOR2I, int>> sorted;
+        std::vector<int>                      removed;
+        size_t                                added = 0;
+
+        sorted.reserve( aPositions.size() );
 
-        const VECTOR2I p0( aNodes[0]->Pos() );
-        const VECTOR2I v0( aNodes[1]->Pos() - p0 );
+        // Match the new points with the current vertices
+        size_t ii = 0;
+        size_t jj = 0;
 
-        for( unsigned i = 2; i < aNodes.size(); i++ )
+        while( ii < aPositions.size() || jj < m_sorted.size() )
         {
-            const VECTOR2I v1 = aNodes[i]->Pos() - p0;
+            if( jj == m_sorted.size()
+                    || ( ii < aPositions.size()
+                         && CN_PTR_CMP::less( aPositions[ii], m_sorted[jj].first ) ) )
+            {
+                sorted.emplace_back( aPositions[ii++], -1 );
+                added++;
+            }
+            else if( ii == aPositions.size()
+                     || CN_PTR_CMP::less( m_sorted[jj].first, aPositions[ii] ) )
+            {
+                removed.push_back( m_sorted[jj++].second );
+            }
+            else
+            {
+                sorted.push_back( m_sorted[jj++] );
+                ii++;
+            }
+        }
 
-            if( v0.Cross( v1 ) != 0 )
-                return false;
+        // Large changes are cheaper to triangulate from scratch
+        bool ok = !m_sorted.empty() && 4 * ( added + removed.size() ) < aPositions.size();
+
+        if( ok )
+        {
+            m_edgeDelta.clear();
+
+            // Insert first: the intermediate point sets are then all supersets of the final one,
+            // which is known not to be degenerate.
+            for( size_t kk = 0; ok && kk < sorted.size(); kk++ )
+            {
+                if( sorted[kk].second < 0 )
+                {
+                    sorted[kk].second = newVertex( sorted[kk].first );
+                    ok = insertVertex( sorted[kk].second );
+                }
+            }
+
+            for( size_t kk = 0; ok && kk < removed.size(); kk++ )
+                ok = removeVertex( removed[kk] );
+        }
+
+        if( ok )
+        {
+            m_sorted = std::move( sorted );
+            updateEdges();
+            m_incrementalUpdates++;
+        }
+        else if( !build( aPositions ) )
+        {
+            Clear();
+            return false;
         }
 
+        aIds.resize( m_sorted.size() );
+
+        for( size_t kk = 0; kk < m_sorted.size(); kk++ )
+            aIds[kk] = m_sorted[kk].second;
+
         return true;
     }
 
-public:
+    /**
+     * @return the edges of the triangulation, shortest first.
+     */
+    const std::vector<EDGE>& Edges() const
+    {
+        return m_edges;
+    }
 
-    void Clear()
+    /**
+     * @return one more than the highest vertex id in use.
+     */
+    int VertexCount() const
+    {
+        return (int) m_points.size();
+    }
+
+    /**
+     * @return how many updates edited the triangulation rather than building it again.
+     */
+    unsigned IncrementalUpdateCount() const
+    {
+        return m_incrementalUpdates;
+    }
+
+private:
+    ///> The vertex at infinity: each edge of the convex hull has a "ghost" triangle with it,
+    ///> so that all the edges have two triangles and points outside the hull need no special
+    ///> handling.
+    static const int INF_VERTEX = -1;
+
+    struct TRIANGLE
     {
-        m_allNodes.clear();
+        int      m_v[3];    ///< vertices, counter-clockwise; ghosts have INF_VERTEX as m_v[2]
+        int      m_n[3];    ///< m_n[i] is the triangle across the edge opposite to m_v[i]
+        bool     m_alive;
+        unsigned m_mark;
+
+        bool IsGhost() const
+        {
+            return m_v[2] == INF_VERTEX;
+        }
+
+        int IndexOf( int aVertex ) const
+        {
+            return m_v[0] == aVertex ? 0 : m_v[1] == aVertex ? 1 : m_v[2] == aVertex ? 2 : -1;
+        }
+    };
+
+    static uint64_t edgeKey( int aA, int aB )
+    {
+        if( aA > aB )
+            std::swap( aA, aB );
+
+        return directedKey( aA, aB );
     }
 
-    void AddNode( CN_ANCHOR_PTR aNode )
+    static uint64_t directedKey( int aA, int aB )
     {
-        m_allNodes.insert( aNode );
+        return ( (uint64_t) (uint32_t) aA << 32 ) | (uint32_t) aB;
     }
 
-    void Triangulate( std::vector<CN_EDGE>& mstEdges)
+    EDGE makeEdge( int aA, int aB ) const
     {
-        std::vector<double>          node_pts;
+        return { (unsigned) ( m_points[aA] - m_points[aB] ).EuclideanNorm(), aA, aB };
+    }
 
-        using ANCHOR_LIST = std::vector<CN_ANCHOR_PTR>;
+    ///> Sign of the cross product (b - a) x (c - a): positive when a, b, c turn left
+    int orient( int aA, int aB, int aC ) const
+    {
+        const VECTOR2I& a = m_points[aA];
+        const VECTOR2I& b = m_points[aB];
+        const VECTOR2I& c = m_points[aC];
 
-        ANCHOR_LIST              anchors;
-        std::vector<ANCHOR_LIST> anchorChains( m_allNodes.size() );
+        int64_t det = ( (int64_t) b.x - a.x ) * ( (int64_t) c.y - a.y )
+                      - ( (int64_t) b.y - a.y ) * ( (int64_t) c.x - a.x );
 
-        node_pts.reserve( 2 * m_allNodes.size() );
-        anchors.reserve( m_allNodes.size() );
+        return ( det > 0 ) - ( det < 0 );
+    }
 
-        CN_ANCHOR_PTR prev = nullptr;
+    ///> Positive if p lies inside the circumcircle of the counter-clockwise triangle a, b, c.
+    ///> Exact as long as the coordinates differ by less than 2^30 (a meter or so).
+    int inCircle( int aA, int aB, int aC, int aP ) const
+    {
+        const VECTOR2I& p = m_points[aP];
+
+        int64_t adx = (int64_t) m_points[aA].x - p.x;
+        int64_t ady = (int64_t) m_points[aA].y - p.y;
+        int64_t bdx = (int64_t) m_points[aB].x - p.x;
+        int64_t bdy = (int64_t) m_points[aB].y - p.y;
+        int64_t cdx = (int64_t) m_points[aC].x - p.x;
+        int64_t cdy = (int64_t) m_points[aC].y - p.y;
+
+        int64_t alift = adx * adx + ady * ady;
+        int64_t blift = bdx * bdx + bdy * bdy;
+        int64_t clift = cdx * cdx + cdy * cdy;
+
+        return sumOfProductsSign( alift, bdx * cdy - cdx * bdy,
+                                  blift, cdx * ady - adx * cdy,
+                                  clift, adx * bdy - bdx * ady );
+    }
+
+    ///> Sign of aA * aB + aC * aD + aE * aF, computed without rounding or overflow
+    static int sumOfProductsSign( int64_t aA, int64_t aB, int64_t aC, int64_t aD, int64_t aE,
+                                  int64_t aF )
+    {
+#ifdef __SIZEOF_INT128__
+        __int128 sum = (__int128) aA * aB + (__int128) aC * aD + (__int128) aE * aF;
+
+        return ( sum > 0 ) - ( sum < 0 );
+#else
+        // No 128 bit integers (MSVC), and long double is no wider than double there: add up
+        // the products in a pair of 64 bit words
+        uint64_t hi = 0;
+        uint64_t lo = 0;
+
+        auto addProduct =
+                [&]( int64_t aX, int64_t aY )
+                {
+                    uint64_t x = aX < 0 ? 0 - (uint64_t) aX : (uint64_t) aX;
+                    uint64_t y = aY < 0 ? 0 - (uint64_t) aY : (uint64_t) aY;
+
+                    uint64_t p00 = ( x & 0xFFFFFFFF ) * ( y & 0xFFFFFFFF );
+                    uint64_t p01 = ( x & 0xFFFFFFFF ) * ( y >> 32 );
+                    uint64_t p10 = ( x >> 32 ) * ( y & 0xFFFFFFFF );
+                    uint64_t p11 = ( x >> 32 ) * ( y >> 32 );
+                    uint64_t mid = ( p00 >> 32 ) + ( p01 & 0xFFFFFFFF ) + ( p10 & 0xFFFFFFFF );
+
+                    uint64_t productLo = ( mid << 32 ) | ( p00 & 0xFFFFFFFF );
+                    uint64_t productHi = p11 + ( p01 >> 32 ) + ( p10 >> 32 ) + ( mid >> 32 );
+
+                    if( ( aX < 0 ) != ( aY < 0 ) )
+                    {
+                        productLo = ~productLo + 1;
+                        productHi = ~productHi + ( productLo == 0 ? 1 : 0 );
+                    }
+
+                    lo += productLo;
+                    hi += productHi + ( lo < productLo ? 1 : 0 );
+                };
+
+        addProduct( aA, aB );
+        addProduct( aC, aD );
+        addProduct( aE, aF );
+
+        if( (int64_t) hi < 0 )
+            return -1;
+
+        return ( hi | lo ) != 0 ? 1 : 0;
+#endif
+    }
+
+    ///> Does aP invalidate triangle aTri, i.e. lie inside its circumcircle?
+    bool conflicts( int aTri, int aP ) const
+    {
+        const TRIANGLE& t = m_tris[aTri];
+
+        if( !t.IsGhost() )
+            return inCircle( t.m_v[0], t.m_v[1], t.m_v[2], aP ) > 0;
+
+        // The "circumcircle" of a ghost triangle is the half plane beyond its hull edge
+        int side = orient( t.m_v[0], t.m_v[1], aP );
+
+        if( side != 0 )
+            return side > 0;
+
+        // On the line of the edge: only the points of the edge itself
+        const VECTOR2I& a = m_points[t.m_v[0]];
+        const VECTOR2I& b = m_points[t.m_v[1]];
+        const VECTOR2I& p = m_points[aP];
+
+        int64_t dot = ( (int64_t) p.x - a.x ) * ( (int64_t) p.x - b.x )
+                      + ( (int64_t) p.y - a.y ) * ( (int64_t) p.y - b.y );
+
+        return dot < 0;
+    }
 
-        for( const auto& n : m_allNodes )
+    int newVertex( const VECTOR2I& aPos )
+    {
+        if( !m_freeVertices.empty() )
+        {
+            int id = m_freeVertices.back();
+            m_freeVertices.pop_back();
+            m_points[id] = aPos;
+            return id;
+        }
+
+        m_points.push_back( aPos );
+        m_vertexTri.push_back( -1 );
+        return (int) m_points.size() - 1;
+    }
+
+    int newTriangle( int aA, int aB, int aC )
+    {
+        // Keep the vertex at infinity last
+        if( aA == INF_VERTEX )
+        {
+            aA = aB;
+            aB = aC;
+            aC = INF_VERTEX;
+        }
+        else if( aB == INF_VERTEX )
+        {
+            aB = aA;
+            aA = aC;
+            aC = INF_VERTEX;
+        }
+
+        int id;
+
+        if( !m_freeTris.empty() )
+        {
+            id = m_freeTris.back();
+            m_freeTris.pop_back();
+        }
+        else
+        {
+            id = (int) m_tris.size();
+            m_tris.emplace_back();
+        }
+
+        TRIANGLE& t = m_tris[id];
+
+        t.m_v[0] = aA;
+        t.m_v[1] = aB;
+        t.m_v[2] = aC;
+        t.m_n[0] = t.m_n[1] = t.m_n[2] = -1;
+        t.m_alive = true;
+        t.m_mark = 0;
+
+        for( int ii = 0; ii < 3; ii++ )
         {
-            if( !prev || prev->Pos() != n->Pos() )
+            if( t.m_v[ii] != INF_VERTEX )
             {
-                node_pts.push_back( n->Pos().x );
-                node_pts.push_back( n->Pos().y );
-                anchors.push_back( n );
-                prev = n;
+                m_vertexTri[t.m_v[ii]] = id;
+
+                if( t.m_v[( ii + 1 ) % 3] != INF_VERTEX )
+                    m_edgeDelta[edgeKey( t.m_v[ii], t.m_v[( ii + 1 ) % 3] )]++;
             }
+        }
+
+        if( !t.IsGhost() )
+            m_hint = id;
 
-            anchorChains[anchors.size() - 1].push_back( n );
+        return id;
+    }
+
+    void deleteTriangle( int aTri )
+    {
+        TRIANGLE& t = m_tris[aTri];
+
+        for( int ii = 0; ii < 3; ii++ )
+        {
+            if( t.m_v[ii] != INF_VERTEX && t.m_v[( ii + 1 ) % 3] != INF_VERTEX )
+                m_edgeDelta[edgeKey( t.m_v[ii], t.m_v[( ii + 1 ) % 3] )]--;
         }
 
-        if( anchors.size() < 2 )
+        t.m_alive = false;
+        m_freeTris.push_back( aTri );
+    }
+
+    /**
+     * Connects the triangles along their common edges.
+     * @param aTris are the triangles to link.
+     * @param aOutside are the triangles already in place around them, by the (directed)
+     *                 edge they have in common with the new triangles.
+     */
+    void linkTriangles( const std::vector<int>& aTris,
+                        const std::unordered_map<uint64_t, int>& aOutside )
+    {
+        std::unordered_map<uint64_t, int> edges;
+
+        for( int tri : aTris )
         {
-            return;
+            const TRIANGLE& t = m_tris[tri];
+
+            for( int ii = 0; ii < 3; ii++ )
+                edges[directedKey( t.m_v[( ii + 1 ) % 3], t.m_v[( ii + 2 ) % 3] )] = tri;
         }
-        else if( areNodesColinear( anchors ) )
+
+        for( int tri : aTris )
         {
-            // special case: all nodes are on the same line - there's no
-            // triangulation for such set. In this case, we sort along any coordinate
-            // and chain the nodes together.
-            for( size_t i = 0; i < anchors.size() - 1; i++ )
+            TRIANGLE& t = m_tris[tri];
+
+            for( int ii = 0; ii < 3; ii++ )
             {
-                auto src = anchors[i];
-                auto dst = anchors[i + 1];
-                mstEdges.emplace_back( src, dst, src->Dist( *dst ) );
+                int a = t.m_v[( ii + 1 ) % 3];
+                int b = t.m_v[( ii + 2 ) % 3];
+
+                auto twin = edges.find( directedKey( b, a ) );
+
+                if( twin != edges.end() )
+                {
+                    t.m_n[ii] = twin->second;
+                    continue;
+                }
+
+                auto outside = aOutside.find( directedKey( b, a ) );
+
+                if( outside == aOutside.end() )
+                    continue;
+
+                TRIANGLE& o = m_tris[outside->second];
+
+                t.m_n[ii] = outside->second;
+                o.m_n[3 - o.IndexOf( a ) - o.IndexOf( b )] = tri;
             }
         }
-        else
+    }
+
+    /**
+     * @return a triangle in conflict with aP, found by walking towards it.
+     */
+    int locate( int aP )
+    {
+        int tri = m_hint;
+
+        if( tri < 0 || !m_tris[tri].m_alive )
         {
-            delaunator::Delaunator delaunator( node_pts );
-            auto& triangles = delaunator.triangles;
+            tri = -1;
 
-            for( size_t i = 0; i < triangles.size(); i += 3 )
+            for( size_t ii = 0; ii < m_tris.size() && tri < 0; ii++ )
             {
-                auto src = anchors[triangles[i]];
-                auto dst = anchors[triangles[i + 1]];
-                mstEdges.emplace_back( src, dst, src->Dist( *dst ) );
+                if( m_tris[ii].m_alive && !m_tris[ii].IsGhost() )
+                    tri = (int) ii;
+            }
+
+            if( tri < 0 )
+                return -1;
+        }
+        else if( m_tris[tri].IsGhost() )
+        {
+            // The hint was recycled for a ghost triangle
+            tri = m_tris[tri].m_n[2];
+        }
+
+        // Walks in Delaunay triangulations don't loop, but stay on the safe side
+        for( size_t steps = 0; steps < m_tris.size() + 16; steps++ )
+        {
+            const TRIANGLE& t = m_tris[tri];
+
+            if( t.IsGhost() )
+                return tri;
 
-                src = anchors[triangles[i + 1]];
-                dst = anchors[triangles[i + 2]];
-                mstEdges.emplace_back( src, dst, src->Dist( *dst ) );
+            int next = -1;
 
-                src = anchors[triangles[i + 2]];
-                dst = anchors[triangles[i]];
-                mstEdges.emplace_back( src, dst, src->Dist( *dst ) );
+            for( int ii = 0; ii < 3; ii++ )
+            {
+                int edge = ( ii + (int) steps ) % 3;
+
+                if( orient( t.m_v[( edge + 1 ) % 3], t.m_v[( edge + 2 ) % 3], aP ) < 0 )
+                {
+                    next = t.m_n[edge];
+                    break;
+                }
             }
 
-            for( size_t i = 0; i < delaunator.halfedges.size(); i++ )
+            if( next < 0 )
+                return tri;
+
+            tri = next;
+        }
+
+        for( size_t ii = 0; ii < m_tris.size(); ii++ )
+        {
+            if( m_tris[ii].m_alive && conflicts( (int) ii, aP ) )
+                return (int) ii;
+        }
+
+        return -1;
+    }
+
+    /**
+     * Bowyer-Watson insertion: replaces the triangles whose circumcircle contains the vertex
+     * by a fan around it.
+     * @return false if the triangulation was found inconsistent.
+     */
+    bool insertVertex( int aVertex )
+    {
+        int first = locate( aVertex );
+
+        if( first < 0 || !conflicts( first, aVertex ) )
+            return false;
+
+        std::vector<int>                  cavity = { first };
+        std::vector<std::pair<int, int>>  boundary;
+        std::unordered_map<uint64_t, int> outside;
+
+        m_mark++;
+        m_tris[first].m_mark = m_mark;
+
+        for( size_t ii = 0; ii < cavity.size(); ii++ )
+        {
+            const TRIANGLE& t = m_tris[cavity[ii]];
+
+            for( int jj = 0; jj < 3; jj++ )
             {
-                if( delaunator.halfedges[i] == delaunator::INVALID_INDEX )
+                int n = t.m_n[jj];
+
+                if( m_tris[n].m_mark == m_mark )
                     continue;
 
-                auto src = anchors[triangles[i]];
-                auto dst = anchors[triangles[delaunator.halfedges[i]]];
-                mstEdges.emplace_back( src, dst, src->Dist( *dst ) );
+                if( conflicts( n, aVertex ) )
+                {
+                    m_tris[n].m_mark = m_mark;
+                    cavity.push_back( n );
+                }
+                else
+                {
+                    int a = t.m_v[( jj + 1 ) % 3];
+                    int b = t.m_v[( jj + 2 ) % 3];
+
+                    boundary.emplace_back( a, b );
+                    outside[directedKey( b, a )] = n;
+                }
             }
         }
 
-        for( size_t i = 0; i < anchorChains.size(); i++ )
+        // The cavity must be star-shaped from the new vertex, or the predicates disagree
+        for( const std::pair<int, int>& edge : boundary )
         {
-            auto& chain = anchorChains[i];
+            if( edge.first != INF_VERTEX && edge.second != INF_VERTEX
+                    && orient( edge.first, edge.second, aVertex ) <= 0 )
+            {
+                return false;
+            }
+        }
 
-            if( chain.size() < 2 )
-                continue;
+        for( int tri : cavity )
+            deleteTriangle( tri );
 
-            std::sort( chain.begin(), chain.end(),
-                    [] ( const CN_ANCHOR_PTR& a, const CN_ANCHOR_PTR& b ) {
-                return a->GetCluster().get() < b->GetCluster().get();
-            } );
+        std::vector<int> fan;
 
-            for( unsigned int j = 1; j < chain.size(); j++ )
+        for( const std::pair<int, int>& edge : boundary )
+            fan.push_back( newTriangle( edge.first, edge.second, aVertex ) );
+
+        linkTriangles( fan, outside );
+        return true;
+    }
+
+    /**
+     * Removes a vertex and fills the hole it leaves with Delaunay triangles, cutting "ears"
+     * off the polygon of its neighbours.
+     * @return false if the triangulation was found inconsistent.
+     */
+    bool removeVertex( int aVertex )
+    {
+        int start = m_vertexTri[aVertex];
+
+        if( start < 0 || !m_tris[start].m_alive || m_tris[start].IndexOf( aVertex ) < 0 )
+            return false;
+
+        // The neighbours of the vertex, counter-clockwise, and the triangles around it
+        std::vector<int>                  link;
+        std::vector<int>                  star;
+        std::unordered_map<uint64_t, int> outside;
+
+        int tri = start;
+
+        do
+        {
+            const TRIANGLE& t = m_tris[tri];
+            int             ii = t.IndexOf( aVertex );
+            int             a = t.m_v[( ii + 1 ) % 3];
+            int             b = t.m_v[( ii + 2 ) % 3];
+
+            link.push_back( a );
+            star.push_back( tri );
+            outside[directedKey( b, a )] = t.m_n[ii];
+
+            tri = t.m_n[( ii + 1 ) % 3];
+
+            if( star.size() > m_tris.size() )
+                return false;
+        } while( tri != start );
+
+        // Put the vertex at infinity, if any, last: the real neighbours then form a chain
+        auto inf = std::find( link.begin(), link.end(), (int) INF_VERTEX );
+        bool onHull = inf != link.end();
+
+        if( onHull )
+        {
+            std::rotate( link.begin(), inf + 1, link.end() );
+            link.pop_back();
+        }
+
+        // An ear is valid when it turns left and no other neighbour is inside its circumcircle
+        auto isEar =
+                [&]( size_t aPrev, size_t aCur, size_t aNext )
+                {
+                    if( orient( link[aPrev], link[aCur], link[aNext] ) <= 0 )
+                        return false;
+
+                    for( size_t kk = 0; kk < link.size(); kk++ )
+                    {
+                        if( kk != aPrev && kk != aCur && kk != aNext
+                                && inCircle( link[aPrev], link[aCur], link[aNext], link[kk] ) > 0 )
+                        {
+                            return false;
+                        }
+                    }
+
+                    return true;
+                };
+
+        std::vector<int> triangles;
+
+        for( int t : star )
+            deleteTriangle( t );
+
+        // The end points of the chain of a hull vertex are no ears: they stay on the hull
+        while( link.size() > ( onHull ? 2 : 3 ) )
+        {
+            size_t n = link.size();
+            size_t last = onHull ? n - 1 : n;
+            size_t ear = onHull ? 1 : 0;
+
+            while( ear < last && !isEar( ( ear + n - 1 ) % n, ear, ( ear + 1 ) % n ) )
+                ear++;
+
+            if( ear == last )
+                break;
+
+            triangles.push_back( newTriangle( link[( ear + n - 1 ) % n], link[ear],
+                                              link[( ear + 1 ) % n] ) );
+            link.erase( link.begin() + ear );
+        }
+
+        if( onHull )
+        {
+            // What is left of the chain is the new piece of hull
+            for( size_t ii = 0; ii + 1 < link.size(); ii++ )
+                triangles.push_back( newTriangle( link[ii], link[ii + 1], INF_VERTEX ) );
+        }
+        else if( link.size() == 3 && orient( link[0], link[1], link[2] ) > 0 )
+        {
+            triangles.push_back( newTriangle( link[0], link[1], link[2] ) );
+        }
+        else
+        {
+            return false;
+        }
+
+        linkTriangles( triangles, outside );
+
+        m_vertexTri[aVertex] = -1;
+        m_freeVertices.push_back( aVertex );
+        return true;
+    }
+
+    /**
+     * Triangulates from scratch.
+     * @return false if the triangulation was found inconsistent.
+     */
+    bool build( const std::vector<VECTOR2I>& aPositions )
+    {
+        Clear();
+
+        std::vector<double> coords;
+
+        coords.reserve( 2 * aPositions.size() );
+
+        for( const VECTOR2I& pos : aPositions )
+        {
+            m_sorted.emplace_back( pos, newVertex( pos ) );
+            coords.push_back( pos.x );
+            coords.push_back( pos.y );
+        }
+
+        delaunator::Delaunator     delaunator( coords );
+        const std::vector<size_t>& vertices = delaunator.triangles;
+        const std::vector<size_t>& halfedges = delaunator.halfedges;
+        bool                       ok = !vertices.empty();
+
+        m_tris.resize( vertices.size() / 3 );
+
+        for( size_t ii = 0; ok && ii < vertices.size(); ii += 3 )
+        {
+            TRIANGLE& t = m_tris[ii / 3];
+
+            for( int jj = 0; jj < 3; jj++ )
+                t.m_v[jj] = (int) vertices[ii + jj];
+
+            int turn = orient( t.m_v[0], t.m_v[1], t.m_v[2] );
+
+            if( turn < 0 )
+                std::swap( t.m_v[1], t.m_v[2] );
+
+            // Delaunator's halfedge ii + jj goes from its vertex jj to vertex jj + 1
+            for( int jj = 0; jj < 3; jj++ )
+            {
+                int    opposite = t.IndexOf( (int) vertices[ii + ( jj + 2 ) % 3] );
+                size_t twin = halfedges[ii + jj];
+
+                t.m_n[opposite] = twin == delaunator::INVALID_INDEX ? -1 : (int) ( twin / 3 );
+            }
+
+            t.m_alive = true;
+            t.m_mark = 0;
+
+            for( int jj = 0; jj < 3; jj++ )
+                m_vertexTri[t.m_v[jj]] = (int) ( ii / 3 );
+
+            // Zero area triangles happen with collinear points on the hull
+            ok = turn != 0;
+        }
+
+        if( ok )
+        {
+            // Close the hull with ghost triangles, (a, b, INF_VERTEX) for each hull edge (b, a)
+            std::vector<int> ghostFrom( m_points.size(), -1 );
+            size_t           realCount = m_tris.size();
+
+            for( size_t ii = 0; ii < realCount; ii++ )
+            {
+                for( int jj = 0; jj < 3; jj++ )
+                {
+                    if( m_tris[ii].m_n[jj] >= 0 )
+                        continue;
+
+                    TRIANGLE ghost;
+
+                    ghost.m_v[0] = m_tris[ii].m_v[( jj + 2 ) % 3];
+                    ghost.m_v[1] = m_tris[ii].m_v[( jj + 1 ) % 3];
+                    ghost.m_v[2] = INF_VERTEX;
+                    ghost.m_n[0] = ghost.m_n[1] = -1;
+                    ghost.m_n[2] = (int) ii;
+                    ghost.m_alive = true;
+                    ghost.m_mark = 0;
+
+                    m_tris[ii].m_n[jj] = (int) m_tris.size();
+                    ghostFrom[ghost.m_v[0]] = (int) m_tris.size();
+                    m_tris.push_back( ghost );
+                }
+            }
+
+            for( size_t ii = realCount; ii < m_tris.size(); ii++ )
+            {
+                int next = ghostFrom[m_tris[ii].m_v[1]];
+
+                m_tris[ii].m_n[0] = next;
+                m_tris[next].m_n[1] = (int) ii;
+            }
+
+            m_hint = 0;
+        }
+        else
+        {
+            ok = buildIncrementally();
+        }
+
+        // Each edge is in two triangles, once in either direction
+        m_edges.clear();
+
+        for( const TRIANGLE& t : m_tris )
+        {
+            for( int ii = 0; ok && t.m_alive && ii < 3; ii++ )
+            {
+                int a = t.m_v[ii];
+                int b = t.m_v[( ii + 1 ) % 3];
+
+                if( a != INF_VERTEX && b != INF_VERTEX && a < b )
+                    m_edges.push_back( makeEdge( a, b ) );
+            }
+        }
+
+        m_edgeDelta.clear();
+        std::sort( m_edges.begin(), m_edges.end() );
+
+        return ok;
+    }
+
+    /**
+     * Triangulates the points of m_sorted one at a time, for the (rare) point sets Delaunator
+     * doesn't triangulate cleanly.
+     */
+    bool buildIncrementally()
+    {
+        m_tris.clear();
+        m_freeTris.clear();
+        m_hint = -1;
+
+        // A first triangle, counter-clockwise.  The points are not all on a line.
+        int a = m_sorted[0].second;
+        int b = m_sorted[1].second;
+        int c = -1;
+
+        for( size_t ii = 2; ii < m_sorted.size() && c < 0; ii++ )
+        {
+            if( orient( a, b, m_sorted[ii].second ) != 0 )
+                c = m_sorted[ii].second;
+        }
+
+        if( c < 0 )
+            return false;
+
+        if( orient( a, b, c ) < 0 )
+            std::swap( b, c );
+
+        std::vector<int> first = { newTriangle( a, b, c ),
+                                   newTriangle( b, a, INF_VERTEX ),
+                                   newTriangle( c, b, INF_VERTEX ),
+                                   newTriangle( a, c, INF_VERTEX ) };
+
+        linkTriangles( first, std::unordered_map<uint64_t, int>() );
+
+        for( const std::pair<VECTOR2I, int>& vertex : m_sorted )
+        {
+            if( vertex.second != a && vertex.second != b && vertex.second != c
+                    && !insertVertex( vertex.second ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Applies the edge changes of the last update to the sorted edge list.
+     */
+    void updateEdges()
+    {
+        std::vector<EDGE> added;
+
+        for( const std::pair<const uint64_t, int>& delta : m_edgeDelta )
+        {
+            if( delta.second > 0 )
             {
-                const auto& prevNode    = chain[j - 1];
-                const auto& curNode     = chain[j];
-                int weight = prevNode->GetCluster() != curNode->GetCluster() ? 1 : 0;
-                mstEdges.emplace_back( prevNode, curNode, weight );
+                int a = (int) ( delta.first >> 32 );
+                int b = (int) ( delta.first & 0xFFFFFFFF );
+
+                added.push_back( makeEdge( a, b ) );
             }
         }
+
+        m_edges.erase( std::remove_if( m_edges.begin(), m_edges.end(),
+                                       [&]( const EDGE& aEdge )
+                                       {
+                                           auto it = m_edgeDelta.find( edgeKey( aEdge.m_a,
+                                                                                aEdge.m_b ) );
+                                           return it != m_edgeDelta.end() && it->second < 0;
+                                       } ),
+                       m_edges.end() );
+
+        std::sort( added.begin(), added.end() );
+
+        size_t middle = m_edges.size();
+        m_edges.insert( m_edges.end(), added.begin(), added.end() );
+        std::inplace_merge( m_edges.begin(), m_edges.begin() + middle, m_edges.end() );
+
+        m_edgeDelta.clear();
     }
+
+    std::vector<VECTOR2I>                 m_points;         ///< by vertex id
+    std::vector<int>                      m_vertexTri;      ///< a triangle of each vertex
+    std::vector<int>                      m_freeVertices;
+    std::vector<TRIANGLE>                 m_tris;
+    std::vector<int>                      m_freeTris;
+
+    ///> Positions and vertex ids, in CN_PTR_CMP order
+    std::vector<std::pair<VECTOR2I, int>> m_sorted;
+
+    std::vector<EDGE>                     m_edges;
+
+    ///> Net change in the number of triangles of each edge during an update: edges with a
+    ///> positive count are new, those with a negative one are gone
+    std::unordered_map<uint64_t, int>     m_edgeDelta;
+
+    unsigned                              m_mark = 0;
+    int                                   m_hint = -1;     ///< where to start walking from
+
+    ///> Not reset by Clear()
+    unsigned                              m_incrementalUpdates = 0;
 };
 
 
@@ -281,6 +1049,7 @@ void RN_NET::compute()
     if( m_nodes.size() <= 2 )
     {
         m_rnEdges.clear();
+        m_triangulator->Clear();
 
         // Check if the only possible connection exists
         if( m_boardEdges.size() == 0 && m_nodes.size() == 2 )
@@ -305,41 +1074,140 @@ void RN_NET::compute()
     }
 
 
-    m_triangulator->Clear();
+    using ANCHOR_LIST = std::vector<CN_ANCHOR_PTR>;
+
+    ANCHOR_LIST              anchors;
+    std::vector<VECTOR2I>    positions;
+    std::vector<ANCHOR_LIST> anchorChains( m_nodes.size() );
+
+    anchors.reserve( m_nodes.size() );
+    positions.reserve( m_nodes.size() );
+
+    CN_ANCHOR_PTR prev = nullptr;
+    int           tag = 0;
 
     for( const auto& n : m_nodes )
     {
-        m_triangulator->AddNode( n );
+        if( !prev || prev->Pos() != n->Pos() )
+        {
+            positions.push_back( n->Pos() );
+            anchors.push_back( n );
+            prev = n;
+        }
+
+        anchorChains[anchors.size() - 1].push_back( n );
+        n->SetTag( tag++ );
+    }
+
+    // Kruskal's algorithm: the edges are added shortest first, those of the board (weight 0),
+    // then the ones between anchors at the same position, then those of the triangulation.
+    disjoint_set dset( m_nodes.size() );
+    size_t       unions = 0;
+
+    m_rnEdges.clear();
+
+    auto addEdge =
+            [&]( const CN_ANCHOR_PTR& aSource, const CN_ANCHOR_PTR& aTarget, unsigned aWeight )
+            {
+                if( dset.unite( aSource->GetTag(), aTarget->GetTag() ) )
+                {
+                    unions++;
+
+                    if( aWeight > 0 )
+                        m_rnEdges.emplace_back( aSource, aTarget, aWeight );
+                }
+            };
+
+    for( const CN_EDGE& edge : m_boardEdges )
+        addEdge( edge.GetSourceNode(), edge.GetTargetNode(), edge.GetWeight() );
+
+    if( anchors.size() < 2 )
+    {
+        m_triangulator->Clear();
+        return;
+    }
+
+    for( ANCHOR_LIST& chain : anchorChains )
+    {
+        std::sort( chain.begin(), chain.end(),
+                [] ( const CN_ANCHOR_PTR& a, const CN_ANCHOR_PTR& b ) {
+            return a->GetCluster().get() < b->GetCluster().get();
+        } );
+
+        for( unsigned int j = 1; j < chain.size(); j++ )
+        {
+            if( chain[j - 1]->GetCluster() == chain[j]->GetCluster() )
+                addEdge( chain[j - 1], chain[j], 0 );
+        }
     }
 
-    std::vector<CN_EDGE> triangEdges;
-    triangEdges.reserve( m_nodes.size() + m_boardEdges.size() );
+    for( const ANCHOR_LIST& chain : anchorChains )
+    {
+        for( unsigned int j = 1; j < chain.size(); j++ )
+        {
+            if( chain[j - 1]->GetCluster() != chain[j]->GetCluster() )
+                addEdge( chain[j - 1], chain[j], 1 );
+        }
+    }
 
     #ifdef PROFILE
     PROF_COUNTER cnt("triangulate");
     #endif
-    m_triangulator->Triangulate( triangEdges );
+
+    std::vector<int> vertexIds;
+
+    if( areNodesColinear( anchors ) || !m_triangulator->Update( positions, vertexIds ) )
+    {
+        // special case: all nodes are on the same line - there's no
+        // triangulation for such set. In this case, we sort along any coordinate
+        // and chain the nodes together.
+        std::vector<CN_EDGE> chainEdges;
+
+        m_triangulator->Clear();
+
+        for( size_t i = 0; i < anchors.size() - 1; i++ )
+        {
+            const CN_ANCHOR_PTR& src = anchors[i];
+            const CN_ANCHOR_PTR& dst = anchors[i + 1];
+
+            chainEdges.emplace_back( src, dst, src->Dist( *dst ) );
+        }
+
+        std::sort( chainEdges.begin(), chainEdges.end() );
+
+        for( const CN_EDGE& edge : chainEdges )
+            addEdge( edge.GetSourceNode(), edge.GetTargetNode(), edge.GetWeight() );
+    }
+    else
+    {
+        std::vector<int> anchorIndex( m_triangulator->VertexCount(), -1 );
+
+        for( size_t i = 0; i < vertexIds.size(); i++ )
+            anchorIndex[vertexIds[i]] = (int) i;
+
+        // The edges come sorted; stop as soon as the tree spans all the nodes
+        for( const TRIANGULATOR_STATE::EDGE& edge : m_triangulator->Edges() )
+        {
+            if( unions + 1 >= m_nodes.size() )
+                break;
+
+            addEdge( anchors[anchorIndex[edge.m_a]], anchors[anchorIndex[edge.m_b]],
+                     edge.m_weight );
+        }
+    }
+
     #ifdef PROFILE
     cnt.Show();
     #endif
+}
 
-    for( const auto& e : m_boardEdges )
-        triangEdges.emplace_back( e );
-
-    std::sort( triangEdges.begin(), triangEdges.end() );
 
-// Get the minimal spanning tree
-#ifdef PROFILE
-    PROF_COUNTER cnt2("mst");
-#endif
-    kruskalMST( triangEdges );
-#ifdef PROFILE
-    cnt2.Show();
-#endif
+unsigned RN_NET::GetIncrementalUpdateCount() const
+{
+    return m_triangulator->IncrementalUpdateCount();
 }
 
 
-
 void RN_NET::Update()
 {
     compute();
@@ -392,71 +1260,84 @@ void RN_NET::AddCluster( CN_CLUSTER_PTR aCluster )
 }
 
 
-bool RN_NET::NearestBicoloredPair( const RN_NET& aOtherNet, CN_ANCHOR_PTR& aNode1,
-        CN_ANCHOR_PTR& aNode2 ) const
+std::vector<VECTOR2I> RN_NET::GetNodePositions() const
+{
+    std::vector<VECTOR2I> positions;
+
+    positions.reserve( m_nodes.size() );
+
+    for( const CN_ANCHOR_PTR& node : m_nodes )
+    {
+        if( !node->GetNoLine() )
+            positions.push_back( node->Pos() );
+    }
+
+    return positions;
+}
+
+
+bool RN_NET::NearestBicoloredPair( const std::vector<VECTOR2I>& aOtherNodes, VECTOR2I& aPos1,
+        VECTOR2I& aPos2 ) const
 {
     bool rv = false;
 
     VECTOR2I::extended_type distMax = VECTOR2I::ECOORD_MAX;
 
-    auto verify = [&]( auto& aTestNode1, auto& aTestNode2 )
+    auto verify = [&]( const VECTOR2I& aTestPos1, const VECTOR2I& aTestPos2 )
         {
-            auto squaredDist = ( aTestNode1->Pos() - aTestNode2->Pos() ).SquaredEuclideanNorm();
+            auto squaredDist = ( aTestPos1 - aTestPos2 ).SquaredEuclideanNorm();
 
             if( squaredDist < distMax )
             {
                 rv      = true;
                 distMax = squaredDist;
-                aNode1  = aTestNode1;
-                aNode2  = aTestNode2;
+                aPos1   = aTestPos1;
+                aPos2   = aTestPos2;
             }
         };
 
     /// Sweep-line algorithm to cut the number of comparisons to find the closest point
     ///
     /// Step 1: The outer loop needs to be the subset (selected nodes) as it is a linear search
-    for( const auto& nodeA : aOtherNet.m_nodes )
+    for( const VECTOR2I& posA : aOtherNodes )
     {
-        if( nodeA->GetNoLine() )
-            continue;
-
         /// Step 2: O( log n ) search to identify a close element ordered by x
         /// The fwd_it iterator will move forward through the elements while
         /// the rev_it iterator will move backward through the same set
-        auto fwd_it = m_nodes.lower_bound( nodeA );
+        auto fwd_it = m_nodes.lower_bound( posA );
         auto rev_it = std::make_reverse_iterator( fwd_it );
 
         for( ; fwd_it != m_nodes.end(); ++fwd_it )
         {
-            auto nodeB = *fwd_it;
+            const CN_ANCHOR_PTR& nodeB = *fwd_it;
 
             if( nodeB->GetNoLine() )
                 continue;
 
-            VECTOR2I::extended_type distX = nodeA->Pos().x - nodeB->Pos().x;
+            VECTOR2I::extended_type distX = posA.x - nodeB->Pos().x;
 
             /// As soon as the x distance (primary sort) is larger than the smallest distance,
             /// stop checking further elements
             if( distX * distX > distMax )
                 break;
 
-            verify( nodeA, nodeB );
+            verify( posA, nodeB->Pos() );
         }
 
         /// Step 3: using the same starting point, check points backwards for closer points
         for( ; rev_it != m_nodes.rend(); ++rev_it )
         {
-            auto nodeB = *rev_it;
+            const CN_ANCHOR_PTR& nodeB = *rev_it;
 
             if( nodeB->GetNoLine() )
                 continue;
 
-            VECTOR2I::extended_type distX = nodeA->Pos().x - nodeB->Pos().x;
+            VECTOR2I::extended_type distX = posA.x - nodeB->Pos().x;
 
             if( distX * distX > distMax )
                 break;
 
-            verify( nodeA, nodeB );
+            verify( posA, nodeB->Pos() );
         }
     }
 
@@ -45,12 +45,30 @@ class CN_CLUSTER;
 
 struct CN_PTR_CMP
 {
+    ///> Allows looking nodes up by position
+    typedef void is_transparent;
+
     bool operator()( const CN_ANCHOR_PTR& aItem, const CN_ANCHOR_PTR& bItem ) const
     {
-        if( aItem->Pos().x == bItem->Pos().x )
-            return aItem->Pos().y < bItem->Pos().y;
+        return less( aItem->Pos(), bItem->Pos() );
+    }
+
+    bool operator()( const CN_ANCHOR_PTR& aItem, const VECTOR2I& aPos ) const
+    {
+        return less( aItem->Pos(), aPos );
+    }
+
+    bool operator()( const VECTOR2I& aPos, const CN_ANCHOR_PTR& bItem ) const
+    {
+        return less( aPos, bItem->Pos() );
+    }
+
+    static bool less( const VECTOR2I& aA, const VECTOR2I& aB )
+    {
+        if( aA.x == aB.x )
+            return aA.y < aB.y;
         else
-            return aItem->Pos().x < bItem->Pos().x;
+            return aA.x < aB.x;
     }
 };
 
@@ -144,15 +162,33 @@ public:
      */
     const CN_ANCHOR_PTR GetClosestNode( const CN_ANCHOR_PTR& aNode ) const;
 
-    bool NearestBicoloredPair( const RN_NET& aOtherNet, CN_ANCHOR_PTR& aNode1, CN_ANCHOR_PTR& aNode2 ) const;
+    /**
+     * Returns the positions of the nodes that can have ratsnest lines, i.e. are not blocked,
+     * sorted by x and then y.
+     */
+    std::vector<VECTOR2I> GetNodePositions() const;
+
+    /**
+     * Finds the shortest connection between the nodes of this net and a set of other nodes.
+     * Only reads the net, so it can run in a thread while the other nodes keep moving.
+     * @param aOtherNodes are the positions of the other nodes.
+     * @param aPos1 receives the position of the other node of the connection.
+     * @param aPos2 receives the position of the node of this net.
+     * @return false if no connection was found.
+     */
+    bool NearestBicoloredPair( const std::vector<VECTOR2I>& aOtherNodes, VECTOR2I& aPos1,
+                               VECTOR2I& aPos2 ) const;
+
+    /**
+     * @return how many updates of the net edited its triangulation instead of building a
+     * new one.
+     */
+    unsigned GetIncrementalUpdateCount() const;
 
 protected:
-    ///> Recomputes ratsnest from scratch.
+    ///> Recomputes the minimum spanning tree of the net, updating its triangulation.
     void compute();
 
-    ///> Compute the minimum spanning tree using Kruskal's algorithm
-    void kruskalMST( const std::vector<CN_EDGE> &aEdges );
-
     ///> Vector of nodes
     std::multiset<CN_ANCHOR_PTR, CN_PTR_CMP> m_nodes;
 
@@ -167,6 +203,7 @@ protected:
 
     class TRIANGULATOR_STATE;
 
+    ///> Delaunay triangulation of the anchors, kept between updates of the net
     std::shared_ptr<TRIANGULATOR_STATE> m_triangulator;
 };
 
@@ -130,8 +130,7 @@ bool LENGTH_TUNER_TOOL::Init()
 
 void LENGTH_TUNER_TOOL::Reset( RESET_REASON aReason )
 {
-    if( aReason == RUN )
-        TOOL_BASE::Reset( aReason );
+    TOOL_BASE::Reset( aReason );
 }
 
 
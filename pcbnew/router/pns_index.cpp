@@ -32,9 +32,11 @@ void INDEX::Add( ITEM* aItem )
     if( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
         m_subIndices.resize( 2 * range.End() + 1 ); // +1 handles the 0 case
 
+    ROUTER_IFACE* iface = ROUTER::GetInstance()->GetInterface();
+
     for( int i = range.Start(); i <= range.End(); ++i )
     {
-        if( !ROUTER::GetInstance()->GetInterface()->IsOnLayer( aItem, i ) )
+        if( !iface->IsOnLayer( aItem, i ) )
         {
             if( aItem->AlternateShape() )
             {
@@ -60,7 +62,7 @@ void INDEX::Add( ITEM* aItem )
     int net = aItem->Net();
 
     if( net >= 0 )
-        m_netMap[net].push_back( aItem );
+        m_netMap[net].insert( aItem );
 }
 
 
@@ -77,8 +79,13 @@ void INDEX::Remove( ITEM* aItem )
     m_allItems.erase( aItem );
     int net = aItem->Net();
 
-    if( net >= 0 && m_netMap.find( net ) != m_netMap.end() )
-        m_netMap[net].remove( aItem );
+    if( net >= 0 )
+    {
+        auto it = m_netMap.find( net );
+
+        if( it != m_netMap.end() )
+            it->second.erase( aItem );
+    }
 }
 
 
@@ -91,10 +98,12 @@ void INDEX::Replace( ITEM* aOldItem, ITEM* aNewItem )
 
 INDEX::NET_ITEMS_LIST* INDEX::GetItemsForNet( int aNet )
 {
-    if( m_netMap.find( aNet ) == m_netMap.end() )
+    auto it = m_netMap.find( aNet );
+
+    if( it == m_netMap.end() )
         return NULL;
 
-    return &m_netMap[aNet];
+    return &it->second;
 }
 
 };
@@ -23,7 +23,6 @@
 #define __PNS_INDEX_H
 
 #include <deque>
-#include <list>
 #include <map>
 #include <unordered_set>
 
@@ -45,7 +44,7 @@ namespace PNS {
 class INDEX
 {
 public:
-    typedef std::list<ITEM*>            NET_ITEMS_LIST;
+    typedef std::unordered_set<ITEM*>   NET_ITEMS_LIST;
     typedef SHAPE_INDEX<ITEM*>          ITEM_SHAPE_INDEX;
     typedef std::unordered_set<ITEM*>   ITEM_SET;
 
@@ -55,7 +55,6 @@ bool ITEM::collideSimple( const ITEM* aOther, int aClearance, bool aNeedMTV, VEC
         else
         {
             shapeA = AlternateShape();
-            Mark( MK_ALT_SHAPE );
         }
     }
 
@@ -71,7 +70,6 @@ bool ITEM::collideSimple( const ITEM* aOther, int aClearance, bool aNeedMTV, VEC
         else
         {
             shapeB = aOther->AlternateShape();
-            aOther->Mark( MK_ALT_SHAPE );
         }
     }
 
@@ -46,8 +46,15 @@
 
 #include <drc/drc_rule.h>
 #include <drc/drc_engine.h>
+#include <hash_eda.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 
 #include <advanced_config.h>
 
@@ -87,26 +94,116 @@ public:
     virtual bool QueryConstraint( PNS::CONSTRAINT_TYPE aType, const PNS::ITEM* aItemA, const PNS::ITEM* aItemB, int aLayer, PNS::CONSTRAINT* aConstraint ) override;
     virtual wxString NetName( int aNet ) override;
 
+    void GetClearanceCacheStats( size_t& aHits, size_t& aMisses ) const
+    {
+        aHits = m_clearanceCacheHits;
+        aMisses = m_clearanceCacheMisses;
+    }
+
 private:
-    struct CLEARANCE_ENT
+    /**
+     * Clearances only depending on the kinds, parent types and nets of the items and on the
+     * layer are memoized under this key.  The netclasses follow from the nets.
+     */
+    struct CLEARANCE_CACHE_KEY
     {
-        int coupledNet;
-        int dpClearance;
-        int clearance;
+        int     kindA;
+        int     kindB;
+        KICAD_T typeA;
+        KICAD_T typeB;
+        int     netA;
+        int     netB;
+        int     layer;
+
+        bool operator==( const CLEARANCE_CACHE_KEY& aOther ) const
+        {
+            return kindA == aOther.kindA && kindB == aOther.kindB
+                    && typeA == aOther.typeA && typeB == aOther.typeB
+                    && netA == aOther.netA && netB == aOther.netB
+                    && layer == aOther.layer;
+        }
+    };
+
+    struct CLEARANCE_CACHE_KEY_HASH
+    {
+        std::size_t operator()( const CLEARANCE_CACHE_KEY& aKey ) const
+        {
+            return hash_val( aKey.kindA, aKey.kindB, (int) aKey.typeA, (int) aKey.typeB,
+                             aKey.netA, aKey.netB, aKey.layer );
+        }
+    };
+
+    typedef std::unordered_map<CLEARANCE_CACHE_KEY, int, CLEARANCE_CACHE_KEY_HASH> CLEARANCE_CACHE;
+
+    ///> The clearance cache is split in parts with a lock each, so that both threads of the
+    ///> walkaround search (see WALKAROUND::SetParallel()) can share it and rarely wait.
+    static constexpr int CLEARANCE_CACHE_SHARDS = 16;
+
+    struct CLEARANCE_CACHE_SHARD
+    {
+        std::mutex      lock;
+        CLEARANCE_CACHE cache;
+    };
+
+    ///> Stand-ins for routed items which have no BOARD_ITEM associated yet
+    struct DUMMY_ITEMS
+    {
+        DUMMY_ITEMS( BOARD* aBoard ) :
+                track( aBoard ),
+                arc( aBoard ),
+                via( aBoard )
+        {}
+
+        TRACK  track;
+        ARC    arc;
+        ::VIA  via;
     };
 
     int holeRadius( const PNS::ITEM* aItem ) const;
     int matchDpSuffix( const wxString& aNetName, wxString& aComplementNet, wxString& aBaseDpName );
+    int evalClearance( const PNS::ITEM* aA, const PNS::ITEM* aB );
+
+    ///> @return false if the clearance of aItem may depend on more than the cache key
+    bool isClearanceCacheable( const PNS::ITEM* aItem ) const;
 
     PNS::ROUTER_IFACE* m_routerIface;
     BOARD*       m_board;
+
+    ///> Whether the clearance and diff pair gap rules can be memoized at all
+    bool         m_cacheableRules;
+
+    CLEARANCE_CACHE_SHARD m_clearanceCache[CLEARANCE_CACHE_SHARDS];
+
+    ///> The thread which created the resolver (the one running the router) uses its own dummy
+    ///> items; any other thread has to take the lock of the second set.
+    std::thread::id     m_ownerThread;
+    DUMMY_ITEMS         m_ownerDummies;
+    DUMMY_ITEMS         m_workerDummies;
+    std::mutex          m_workerDummiesLock;
+
+    std::atomic<size_t> m_clearanceCacheHits;
+    std::atomic<size_t> m_clearanceCacheMisses;
 };
 
 
 PNS_PCBNEW_RULE_RESOLVER::PNS_PCBNEW_RULE_RESOLVER( BOARD* aBoard, PNS::ROUTER_IFACE* aRouterIface ) :
     m_routerIface( aRouterIface ),
-    m_board( aBoard )
+    m_board( aBoard ),
+    m_cacheableRules( true ),
+    m_ownerThread( std::this_thread::get_id() ),
+    m_ownerDummies( aBoard ),
+    m_workerDummies( aBoard ),
+    m_clearanceCacheHits( 0 ),
+    m_clearanceCacheMisses( 0 )
 {
+    // The resolver lives for one routing session, during which the rules can't change
+    std::shared_ptr<DRC_ENGINE> drcEngine = m_board->GetDesignSettings().m_DRCEngine;
+
+    if( drcEngine )
+    {
+        m_cacheableRules = drcEngine->HasOnlyCacheableRules( DRC_CONSTRAINT_TYPE_CLEARANCE )
+                && drcEngine->HasOnlyCacheableRules( DRC_CONSTRAINT_TYPE_DIFF_PAIR_GAP );
+    }
 }
 
 
@@ -226,30 +323,33 @@ bool PNS_PCBNEW_RULE_RESOLVER::QueryConstraint( PNS::CONSTRAINT_TYPE aType,
             return false; // should not happen
     }
 
-    // A track being routed may not have a BOARD_ITEM associated yet.
-    static TRACK dummyTrack( m_board );
-    static ARC   dummyArc( m_board );
-    static VIA   dummyVia( m_board );
-
     const BOARD_ITEM* parentA = aItemA ? aItemA->Parent() : nullptr;
     const BOARD_ITEM* parentB = aItemB ? aItemB->Parent() : nullptr;
     DRC_CONSTRAINT    hostConstraint;
 
+    // A track being routed may not have a BOARD_ITEM associated yet
+    bool                         onOwner = std::this_thread::get_id() == m_ownerThread;
+    DUMMY_ITEMS&                 dummies = onOwner ? m_ownerDummies : m_workerDummies;
+    std::unique_lock<std::mutex> dummiesLock( m_workerDummiesLock, std::defer_lock );
+
     if( !parentA )
     {
+        if( !onOwner )
+            dummiesLock.lock();
+
         switch( aItemA->Kind() )
         {
         case PNS::ITEM::ARC_T:
-            dummyArc.SetLayer( (PCB_LAYER_ID) aLayer );
-            parentA = &dummyArc;
+            dummies.arc.SetLayer( (PCB_LAYER_ID) aLayer );
+            parentA = &dummies.arc;
             break;
         case PNS::ITEM::VIA_T:
-            dummyVia.SetLayer( (PCB_LAYER_ID) aLayer );
-            parentA = &dummyVia;
+            dummies.via.SetLayer( (PCB_LAYER_ID) aLayer );
+            parentA = &dummies.via;
             break;
         default:
-            dummyTrack.SetLayer( (PCB_LAYER_ID) aLayer );
-            parentA = &dummyTrack;
+            dummies.track.SetLayer( (PCB_LAYER_ID) aLayer );
+            parentA = &dummies.track;
             break;
         }
     }
@@ -281,7 +381,67 @@ bool PNS_PCBNEW_RULE_RESOLVER::QueryConstraint( PNS::CONSTRAINT_TYPE aType,
 }
 
 
+bool PNS_PCBNEW_RULE_RESOLVER::isClearanceCacheable( const PNS::ITEM* aItem ) const
+{
+    const BOARD_ITEM* parent = aItem->Parent();
+
+    if( !parent )
+        return true;
+
+    // Keepouts are resolved from their own properties, and local clearances are per item
+    if( parent->Type() == PCB_ZONE_AREA_T || parent->Type() == PCB_FP_ZONE_AREA_T )
+        return false;
+
+    if( parent->IsConnected()
+            && static_cast<const BOARD_CONNECTED_ITEM*>( parent )->GetLocalClearance( nullptr ) > 0 )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
 int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* aB )
+{
+    if( !m_cacheableRules || !isClearanceCacheable( aA ) || !isClearanceCacheable( aB ) )
+        return evalClearance( aA, aB );
+
+    // Items without a parent are resolved as dummy board items of their kind
+    CLEARANCE_CACHE_KEY key = { aA->Kind(),
+                                aB->Kind(),
+                                aA->Parent() ? aA->Parent()->Type() : NOT_USED,
+                                aB->Parent() ? aB->Parent()->Type() : NOT_USED,
+                                aA->Net(),
+                                aB->Net(),
+                                aA->Layer() };
+
+    CLEARANCE_CACHE_SHARD& shard =
+            m_clearanceCache[ CLEARANCE_CACHE_KEY_HASH()( key ) % CLEARANCE_CACHE_SHARDS ];
+
+    {
+        std::lock_guard<std::mutex> lock( shard.lock );
+        auto                        it = shard.cache.find( key );
+
+        if( it != shard.cache.end() )
+        {
+            m_clearanceCacheHits++;
+            return it->second;
+        }
+    }
+
+    m_clearanceCacheMisses++;
+
+    // Evaluated unlocked; if both threads miss the same key they store the same value
+    int clearance = evalClearance( aA, aB );
+
+    std::lock_guard<std::mutex> lock( shard.lock );
+    shard.cache[ key ] = clearance;
+    return clearance;
+}
+
+
+int PNS_PCBNEW_RULE_RESOLVER::evalClearance( const PNS::ITEM* aA, const PNS::ITEM* aB )
 {
     PNS::CONSTRAINT constraint;
     bool ok = false;
@@ -686,6 +846,18 @@ public:
         }
     }
 
+    void AddText( const VECTOR2I& aPos, const std::vector<wxString>& aLines )
+    {
+        if( !m_view )
+            return;
+
+        ROUTER_PREVIEW_ITEM* pitem = new ROUTER_PREVIEW_ITEM( NULL, m_view );
+
+        pitem->Text( aPos, aLines );
+        m_items->Add( pitem );
+        m_view->Update( m_items );
+    }
+
     void AddLine( const SHAPE_LINE_CHAIN& aLine, int aType, int aWidth,  const std::string aName = "" ) override
     {
         if( !m_view )
@@ -725,6 +897,8 @@ PNS_KICAD_IFACE_BASE::PNS_KICAD_IFACE_BASE()
     m_board = nullptr;
     m_world = nullptr;
     m_debugDecorator = nullptr;
+    m_syncedSerial = 0;
+    m_worstPadClearance = 0;
 }
 
 
@@ -734,17 +908,18 @@ PNS_KICAD_IFACE::PNS_KICAD_IFACE()
     m_view = nullptr;
     m_previewItems = nullptr;
     m_dispOptions = nullptr;
+    m_debugCountersShown = false;
 }
 
 
 PNS_KICAD_IFACE_BASE::~PNS_KICAD_IFACE_BASE()
 {
+    delete m_ruleResolver;
 }
 
 
 PNS_KICAD_IFACE::~PNS_KICAD_IFACE()
 {
-    delete m_ruleResolver;
     delete m_debugDecorator;
 
      if( m_previewItems )
@@ -1158,29 +1333,132 @@ bool PNS_KICAD_IFACE::IsItemVisible( const PNS::ITEM* aItem ) const
 }
 
 
-void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
+void PNS_KICAD_IFACE_BASE::syncModule( PNS::NODE* aWorld, MODULE* aModule,
+                                       SHAPE_POLY_SET* aBoardOutline )
 {
-    int worstPadClearance = 0;
+    std::vector<BOARD_ITEM*>& children = m_moduleItems[ aModule ];
 
-    m_world = aWorld;
+    children.clear();
 
-    if( !m_board )
+    for( D_PAD* pad : aModule->Pads() )
     {
-        wxLogTrace( "PNS", "No board attached, aborting sync." );
-        return;
+        if( std::unique_ptr<PNS::SOLID> solid = syncPad( pad ) )
+            aWorld->Add( std::move( solid ) );
+
+        m_worstPadClearance = std::max( m_worstPadClearance, pad->GetLocalClearance() );
+        children.push_back( pad );
     }
 
-    for( BOARD_ITEM* gitem : m_board->Drawings() )
+    syncTextItem( aWorld, &aModule->Reference(), aModule->Reference().GetLayer() );
+    syncTextItem( aWorld, &aModule->Value(), aModule->Value().GetLayer() );
+    children.push_back( &aModule->Reference() );
+    children.push_back( &aModule->Value() );
+
+    for( MODULE_ZONE_CONTAINER* zone : aModule->Zones() )
+    {
+        syncZone( aWorld, zone, aBoardOutline );
+        children.push_back( zone );
+    }
+
+    for( BOARD_ITEM* mgitem : aModule->GraphicalItems() )
     {
-        if ( gitem->Type() == PCB_SHAPE_T )
+        if( mgitem->GetLayer() == Edge_Cuts )
+            m_outlineItems.insert( aModule );
+
+        children.push_back( mgitem );
+
+        if( aModule->IsNetTie() )
+            continue;
+
+        if( mgitem->Type() == PCB_FP_SHAPE_T )
         {
-            syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( gitem ) );
+            syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( mgitem ) );
         }
-        else if( gitem->Type() == PCB_TEXT_T )
+        else if( mgitem->Type() == PCB_FP_TEXT_T )
         {
-            syncTextItem( aWorld, static_cast<PCB_TEXT*>( gitem ), gitem->GetLayer() );
+            syncTextItem( aWorld, static_cast<FP_TEXT*>( mgitem ), mgitem->GetLayer() );
         }
     }
+}
+
+
+void PNS_KICAD_IFACE_BASE::syncBoardItem( PNS::NODE* aWorld, BOARD_ITEM* aItem,
+                                          SHAPE_POLY_SET* aBoardOutline )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_SHAPE_T:
+        if( aItem->GetLayer() == Edge_Cuts )
+            m_outlineItems.insert( aItem );
+
+        syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( aItem ) );
+        break;
+
+    case PCB_TEXT_T:
+        syncTextItem( aWorld, static_cast<PCB_TEXT*>( aItem ), aItem->GetLayer() );
+        break;
+
+    case PCB_ZONE_AREA_T:
+        syncZone( aWorld, static_cast<ZONE_CONTAINER*>( aItem ), aBoardOutline );
+        break;
+
+    case PCB_MODULE_T:
+        syncModule( aWorld, static_cast<MODULE*>( aItem ), aBoardOutline );
+        break;
+
+    case PCB_TRACE_T:
+        if( auto segment = syncTrack( static_cast<TRACK*>( aItem ) ) )
+            aWorld->Add( std::move( segment ) );
+
+        break;
+
+    case PCB_ARC_T:
+        if( auto arc = syncArc( static_cast<ARC*>( aItem ) ) )
+            aWorld->Add( std::move( arc ) );
+
+        break;
+
+    case PCB_VIA_T:
+        if( auto via = syncVia( static_cast<VIA*>( aItem ) ) )
+            aWorld->Add( std::move( via ) );
+
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void PNS_KICAD_IFACE_BASE::syncRules( PNS::NODE* aWorld )
+{
+    int worstRuleClearance = m_board->GetDesignSettings().GetBiggestClearanceValue();
+
+    delete m_ruleResolver;
+    m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, this );
+
+    aWorld->SetRuleResolver( m_ruleResolver );
+    aWorld->SetMaxClearance( 4 * std::max( m_worstPadClearance, worstRuleClearance ) );
+}
+
+
+void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
+{
+    m_world = aWorld;
+    m_moduleItems.clear();
+    m_outlineItems.clear();
+    m_worstPadClearance = 0;
+
+    if( !m_board )
+    {
+        wxLogTrace( "PNS", "No board attached, aborting sync." );
+        return;
+    }
+
+    m_syncedSerial = m_board->GetChangeLogSerial();
+
+    for( BOARD_ITEM* gitem : m_board->Drawings() )
+        syncBoardItem( aWorld, gitem, nullptr );
 
     SHAPE_POLY_SET  buffer;
     SHAPE_POLY_SET* boardOutline = nullptr;
@@ -1189,73 +1467,161 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
         boardOutline = &buffer;
 
     for( ZONE_CONTAINER* zone : m_board->Zones() )
-    {
-        syncZone( aWorld, zone, boardOutline );
-    }
+        syncBoardItem( aWorld, zone, boardOutline );
 
     for( MODULE* module : m_board->Modules() )
-    {
-        for( D_PAD* pad : module->Pads() )
-        {
-            if( std::unique_ptr<PNS::SOLID> solid = syncPad( pad ) )
-                aWorld->Add( std::move( solid ) );
+        syncBoardItem( aWorld, module, boardOutline );
 
-            worstPadClearance = std::max( worstPadClearance, pad->GetLocalClearance() );
-        }
+    for( TRACK* t : m_board->Tracks() )
+        syncBoardItem( aWorld, t, nullptr );
 
-        syncTextItem( aWorld, &module->Reference(), module->Reference().GetLayer() );
-        syncTextItem( aWorld, &module->Value(), module->Value().GetLayer() );
+    syncRules( aWorld );
+}
 
-        for( MODULE_ZONE_CONTAINER* zone : module->Zones() )
-            syncZone( aWorld, zone, boardOutline );
 
-        if( module->IsNetTie() )
-            continue;
+bool PNS_KICAD_IFACE_BASE::UpdateWorld( PNS::NODE* aWorld )
+{
+    std::vector<BOARD_ITEM_CHANGE> changes;
 
-        for( BOARD_ITEM* mgitem : module->GraphicalItems() )
-        {
-            if( mgitem->Type() == PCB_FP_SHAPE_T )
-            {
-                syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( mgitem ) );
-            }
-            else if( mgitem->Type() == PCB_FP_TEXT_T )
+    if( !m_board || aWorld != m_world || !m_board->GetChangesSince( m_syncedSerial, changes ) )
+        return false;
+
+    // Only the latest state of each item matters
+    std::unordered_map<BOARD_ITEM*, bool> onBoard;
+
+    for( const BOARD_ITEM_CHANGE& change : changes )
+        onBoard[ change.m_item ] = change.m_onBoard;
+
+    auto isOutline =
+            []( BOARD_ITEM* aItem )
             {
-                syncTextItem( aWorld, static_cast<FP_TEXT*>( mgitem ), mgitem->GetLayer() );
-            }
-        }
-    }
+                if( aItem->Type() == PCB_MODULE_T )
+                {
+                    for( BOARD_ITEM* mgitem : static_cast<MODULE*>( aItem )->GraphicalItems() )
+                    {
+                        if( mgitem->GetLayer() == Edge_Cuts )
+                            return true;
+                    }
 
-    for( TRACK* t : m_board->Tracks() )
+                    return false;
+                }
+
+                return aItem->Type() == PCB_SHAPE_T && aItem->GetLayer() == Edge_Cuts;
+            };
+
+    std::unordered_set<const BOARD_ITEM*> staleParents;
+    bool                                  needOutline = false;
+
+    for( const std::pair<BOARD_ITEM* const, bool>& entry : onBoard )
     {
-        KICAD_T type = t->Type();
+        BOARD_ITEM* item = entry.first;
 
-        if( type == PCB_TRACE_T )
-        {
-            if( auto segment = syncTrack( t ) )
-                aWorld->Add( std::move( segment ) );
-        }
-        else if( type == PCB_ARC_T )
-        {
-            if( auto arc = syncArc( static_cast<ARC*>( t ) ) )
-                aWorld->Add( std::move( arc ) );
-        }
-        else if( type == PCB_VIA_T )
+        // The board outline clips all the keepout zones: not worth patching
+        if( m_outlineItems.count( item ) || ( entry.second && isOutline( item ) ) )
+            return false;
+
+        staleParents.insert( item );
+
+        // Footprint items have the footprint children as parents.  These are only known from
+        // the last sync (the footprint may be gone, or have had its children swapped since).
+        auto children = m_moduleItems.find( item );
+
+        if( children != m_moduleItems.end() )
         {
-            if( auto via = syncVia( static_cast<VIA*>( t ) ) )
-                aWorld->Add( std::move( via ) );
+            staleParents.insert( children->second.begin(), children->second.end() );
+            m_moduleItems.erase( children );
         }
+
+        if( entry.second && ( item->Type() == PCB_MODULE_T || item->Type() == PCB_ZONE_AREA_T ) )
+            needOutline = true;
     }
 
-    int worstRuleClearance = m_board->GetDesignSettings().GetBiggestClearanceValue();
+    std::vector<PNS::ITEM*> items;
+    aWorld->AllItems( items );
 
-    delete m_ruleResolver;
-    m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, this );
+    for( PNS::ITEM* item : items )
+    {
+        if( staleParents.count( item->Parent() ) )
+            aWorld->Remove( item );
+    }
 
-    aWorld->SetRuleResolver( m_ruleResolver );
-    aWorld->SetMaxClearance( 4 * std::max(worstPadClearance, worstRuleClearance ) );
+    SHAPE_POLY_SET  buffer;
+    SHAPE_POLY_SET* boardOutline = nullptr;
+
+    if( needOutline && m_board->GetBoardPolygonOutlines( buffer ) )
+        boardOutline = &buffer;
+
+    for( const std::pair<BOARD_ITEM* const, bool>& entry : onBoard )
+    {
+        if( entry.second )
+            syncBoardItem( aWorld, entry.first, boardOutline );
+    }
+
+    syncRules( aWorld );
+    m_syncedSerial = m_board->GetChangeLogSerial();
+
+    wxLogTrace( "PNS", "Patched the world with %d changes to %d items", (int) changes.size(),
+                (int) onBoard.size() );
+
+#ifdef DEBUG
+    if( !checkWorld( aWorld ) )
+    {
+        wxFAIL_MSG( wxT( "Patched router world differs from the board; resyncing." ) );
+        return false;
+    }
+#endif
+
+    return true;
 }
 
 
+#ifdef DEBUG
+bool PNS_KICAD_IFACE_BASE::checkWorld( PNS::NODE* aWorld )
+{
+    typedef std::tuple<int, int, int, int, const BOARD_ITEM*, int, int, int, int> SIGNATURE;
+
+    auto signatures =
+            []( PNS::NODE* aNode )
+            {
+                std::vector<PNS::ITEM*> items;
+                std::vector<SIGNATURE>  sigs;
+
+                aNode->AllItems( items );
+
+                for( PNS::ITEM* item : items )
+                {
+                    BOX2I bbox = item->Shape() ? item->Shape()->BBox() : BOX2I();
+
+                    sigs.emplace_back( item->Kind(), item->Net(), item->Layers().Start(),
+                                       item->Layers().End(), item->Parent(), bbox.GetX(),
+                                       bbox.GetY(), bbox.GetWidth(), bbox.GetHeight() );
+                }
+
+                std::sort( sigs.begin(), sigs.end() );
+                return sigs;
+            };
+
+    PNS_KICAD_IFACE_BASE reference;
+    PNS::NODE            referenceWorld;
+
+    reference.SetBoard( m_board );
+    reference.SyncWorld( &referenceWorld );
+
+    std::vector<SIGNATURE> patched = signatures( aWorld );
+    std::vector<SIGNATURE> expected = signatures( &referenceWorld );
+
+    if( patched != expected )
+    {
+        wxLogTrace( "PNS", "World check failed: %d items, %d expected", (int) patched.size(),
+                    (int) expected.size() );
+        return false;
+    }
+
+    return true;
+}
+#endif
+
+
 void PNS_KICAD_IFACE::EraseView()
 {
     for( auto item : m_hiddenItems )
@@ -1271,6 +1637,8 @@ void PNS_KICAD_IFACE::EraseView()
 
     if( m_debugDecorator )
         m_debugDecorator->Clear();
+
+    m_debugCountersShown = false;
 }
 
 void PNS_KICAD_IFACE_BASE::SetDebugDecorator( PNS::DEBUG_DECORATOR *aDec )
@@ -1318,6 +1686,30 @@ void PNS_KICAD_IFACE::DisplayItem( const PNS::ITEM* aItem, int aColor, int aClea
 
     m_previewItems->Add( pitem );
     m_view->Update( m_previewItems );
+
+    if( ADVANCED_CFG::GetCfg().m_ShowRouterDebugGraphics && !m_debugCountersShown )
+        showDebugCounters( aItem );
+}
+
+
+void PNS_KICAD_IFACE::showDebugCounters( const PNS::ITEM* aItem )
+{
+    auto dec = dynamic_cast<PNS_PCBNEW_DEBUG_DECORATOR*>( m_debugDecorator );
+
+    if( !dec || !m_ruleResolver || !aItem->Shape() )
+        return;
+
+    size_t hits, misses;
+    m_ruleResolver->GetClearanceCacheStats( hits, misses );
+
+    double hitRate = hits + misses ? 100.0 * hits / ( hits + misses ) : 0.0;
+
+    dec->AddText( aItem->Shape()->BBox().GetEnd(),
+                  { wxString::Format( "Clearance cache: %d hits, %d misses", (int) hits,
+                                    (int) misses ),
+                    wxString::Format( "Hit rate: %.1f%%", hitRate ) } );
+
+    m_debugCountersShown = true;
 }
 
 
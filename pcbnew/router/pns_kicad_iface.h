@@ -22,6 +22,7 @@
 #ifndef __PNS_KICAD_IFACE_H
 #define __PNS_KICAD_IFACE_H
 
+#include <unordered_map>
 #include <unordered_set>
 
 #include "pns_router.h"
@@ -31,10 +32,12 @@ class PNS_PCBNEW_DEBUG_DECORATOR;
 
 class BOARD;
 class BOARD_COMMIT;
+class BOARD_ITEM;
 class PCB_DISPLAY_OPTIONS;
 class PCB_TOOL_BASE;
 class MODULE;
 class D_PAD;
+class SHAPE_POLY_SET;
 
 namespace PNS
 {
@@ -57,6 +60,7 @@ public:
     void EraseView() override {};
     void SetBoard( BOARD* aBoard );
     void SyncWorld( PNS::NODE* aWorld ) override;
+    bool UpdateWorld( PNS::NODE* aWorld ) override;
     bool IsAnyLayerVisible( const LAYER_RANGE& aLayer ) const override { return true; };
     bool IsOnLayer( const PNS::ITEM* aItem, int aLayer ) const override { return true; };
     bool IsItemVisible( const PNS::ITEM* aItem ) const override { return true; }
@@ -96,11 +100,29 @@ protected:
     bool syncTextItem( PNS::NODE* aWorld, EDA_TEXT* aText, PCB_LAYER_ID aLayer );
     bool syncGraphicalItem( PNS::NODE* aWorld, PCB_SHAPE* aItem );
     bool syncZone( PNS::NODE* aWorld, ZONE_CONTAINER* aZone, SHAPE_POLY_SET* aBoardOutline );
+    void syncModule( PNS::NODE* aWorld, MODULE* aModule, SHAPE_POLY_SET* aBoardOutline );
+    void syncBoardItem( PNS::NODE* aWorld, BOARD_ITEM* aItem, SHAPE_POLY_SET* aBoardOutline );
+    void syncRules( PNS::NODE* aWorld );
     bool inheritTrackWidth( PNS::ITEM* aItem, int* aInheritedWidth );
 
+#ifdef DEBUG
+    ///> Compares aWorld against a world built from scratch
+    bool checkWorld( PNS::NODE* aWorld );
+#endif
 
     PNS::NODE* m_world;
     BOARD* m_board;
+
+    ///> Board change log serial of the last sync (see BOARD::GetChangesSince())
+    uint64_t m_syncedSerial;
+
+    ///> Footprint children, the parents of the footprints' world items, as of the last sync
+    std::unordered_map<BOARD_ITEM*, std::vector<BOARD_ITEM*>> m_moduleItems;
+
+    ///> Items making up the board outline, which clips the keepout zones
+    std::unordered_set<BOARD_ITEM*> m_outlineItems;
+
+    int m_worstPadClearance;
 };
 
 class PNS_KICAD_IFACE : public PNS_KICAD_IFACE_BASE {
@@ -131,6 +153,9 @@ private:
         VECTOR2I p_old, p_new;
     };
 
+    ///> Adds the clearance cache counters to the debug overlay, next to aItem
+    void showDebugCounters( const PNS::ITEM* aItem );
+
     std::map<D_PAD*, OFFSET>        m_moduleOffsets;
     KIGFX::VIEW*                    m_view;
     KIGFX::VIEW_GROUP*              m_previewItems;
@@ -139,6 +164,7 @@ private:
     PCB_TOOL_BASE*                  m_tool;
     std::unique_ptr<BOARD_COMMIT>   m_commit;
     const PCB_DISPLAY_OPTIONS*      m_dispOptions;
+    bool                            m_debugCountersShown;
 };
 
 
@@ -25,6 +25,7 @@
 #include "pns_debug_decorator.h"
 #include "pns_line_placer.h"
 #include "pns_node.h"
+#include "pns_optimizer.h"
 #include "pns_router.h"
 #include "pns_shove.h"
 #include "pns_topology.h"
@@ -34,6 +35,7 @@
 #include <class_board_item.h>
 
 #include <memory>
+#include <thread>
 
 namespace PNS {
 
@@ -404,6 +406,7 @@ bool LINE_PLACER::rhWalkOnly( const VECTOR2I& aP, LINE& aNewHead )
     walkaround.SetDebugDecorator( Dbg() );
     walkaround.SetLogger( Logger() );
     walkaround.SetIterationLimit( Settings().WalkaroundIterationLimit() );
+    walkaround.SetParallel( std::thread::hardware_concurrency() > 1 );
 
     WALKAROUND::RESULT wr = walkaround.Route( initTrack );
     //WALKAROUND::WALKAROUND_STATUS wf = walkaround.Route( initTrack, walkFull, false );
@@ -433,7 +436,17 @@ bool LINE_PLACER::rhWalkOnly( const VECTOR2I& aP, LINE& aNewHead )
 
     }
 
-    walkFull.SetShape( l_ccw.Length() < l_cw.Length() ? l_ccw : l_cw );
+    LINE           cand_cw( m_head, l_cw ), cand_ccw( m_head, l_ccw );
+    COST_ESTIMATOR cost_cw, cost_ccw;
+
+    cost_cw.Add( cand_cw );
+    cost_ccw.Add( cand_ccw );
+
+    // Take the shorter path, unless the longer one is within 5% and has a lower corner cost
+    bool pick_ccw = cost_cw.IsBetter( cost_ccw, 1.05, 1.0 )
+                    || ( !cost_ccw.IsBetter( cost_cw, 1.05, 1.0 ) && l_ccw.Length() < l_cw.Length() );
+
+    walkFull.SetShape( pick_ccw ? l_ccw : l_cw );
 
     Dbg()->AddLine( walkFull.CLine(), 2, 100000, "walk-full" );
 
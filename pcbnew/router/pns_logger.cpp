@@ -32,6 +32,8 @@
 #include <geometry/shape_circle.h>
 #include <geometry/shape_simple.h>
 
+#include <cstring>
+
 namespace PNS {
 
 LOGGER::LOGGER( )
@@ -56,17 +58,53 @@ void LOGGER::Save( const std::string& aFilename )
 
     wxLogTrace( "PNS", "Saving to '%s' [%p]", aFilename.c_str(), f );
 
-    for( const auto evt : m_events )
+    if( !f )
+        return;
+
+    for( const EVENT_ENTRY& evt : m_events )
     {
-        uint64_t id = 0;
-        if( evt.item && evt.item->Parent() )
+        wxString id = evt.uuid == niluuid ? wxString( "null" ) : evt.uuid.AsString();
+
+        fprintf( f, "event %d %d %d %s\n", evt.p.x, evt.p.y, evt.type, (const char*) id.c_str() );
+    }
+
+    fclose( f );
+}
+
+
+bool LOGGER::Load( const std::string& aFilename )
+{
+    FILE* f = fopen( aFilename.c_str(), "rb" );
+
+    if( !f )
+        return false;
+
+    char line[256];
+    bool ok = true;
+
+    m_events.clear();
+
+    while( fgets( line, sizeof( line ), f ) )
+    {
+        EVENT_ENTRY evt;
+        int         type;
+        char        id[64];
+
+        if( sscanf( line, "event %d %d %d %63s", &evt.p.x, &evt.p.y, &type, id ) != 4
+                || type < EVT_START_ROUTE || type > EVT_ABORT )
         {
-            const char* idString = evt.item->Parent()->m_Uuid.AsString().c_str();
-            fprintf( f, "event %d %d %d %s\n", evt.type, evt.p.x, evt.p.y, idString );
+            ok = false;
+            break;
         }
+
+        evt.type = static_cast<EVENT_TYPE>( type );
+        evt.uuid = strcmp( id, "null" ) ? KIID( wxString( id ) ) : niluuid;
+
+        m_events.push_back( evt );
     }
 
     fclose( f );
+    return ok;
 }
 
 
@@ -76,10 +114,11 @@ void LOGGER::Log( LOGGER::EVENT_TYPE evt, VECTOR2I pos, const ITEM* item )
 
     ent.type = evt;
     ent.p = pos;
-    ent.item = item;
 
-    m_events.push_back( ent );
+    // The items may be gone by the time the log is saved; keep the id of their board items
+    ent.uuid = item && item->Parent() ? item->Parent()->m_Uuid : niluuid;
 
+    m_events.push_back( ent );
 }
 
 }
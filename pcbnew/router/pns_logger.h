@@ -27,6 +27,7 @@
 #include <string>
 #include <sstream>
 
+#include <kiid.h>
 #include <math/vector2d.h>
 
 class SHAPE_LINE_CHAIN;
@@ -51,13 +52,21 @@ public:
     struct EVENT_ENTRY {
         VECTOR2I p;
         EVENT_TYPE type;
-        const ITEM* item;
+        KIID uuid;      ///< board item the event refers to, niluuid if none
     };
 
     LOGGER();
     ~LOGGER();
 
     void Save( const std::string& aFilename );
+
+    /**
+     * Reads back the events written by Save().
+     *
+     * @return false if the file couldn't be opened or isn't a routing log
+     */
+    bool Load( const std::string& aFilename );
+
     void Clear();
     void Log( EVENT_TYPE evt, VECTOR2I pos, const ITEM* item = nullptr );
 
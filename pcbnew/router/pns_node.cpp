@@ -19,6 +19,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <list>
 #include <vector>
 #include <cassert>
 #include <utility>
@@ -36,6 +37,7 @@
 #include "pns_solid.h"
 #include "pns_joint.h"
 #include "pns_index.h"
+#include "pns_perf_counters.h"
 
 
 namespace PNS {
@@ -107,6 +109,8 @@ NODE* NODE::Branch()
 {
     NODE* child = new NODE;
 
+    PERF_COUNTERS::Count( PERF_COUNTERS::Get().m_branches );
+
     wxLogTrace( "PNS", "NODE::branch %p (parent %p)", child, this );
 
     m_children.insert( child );
@@ -261,6 +265,8 @@ struct NODE::DEFAULT_OBSTACLE_VISITOR : public OBSTACLE_VISITOR
 
 int NODE::QueryColliding( const ITEM* aItem, OBSTACLE_VISITOR& aVisitor )
 {
+    PERF_COUNTERS::Count( PERF_COUNTERS::Get().m_collisionQueries );
+
     aVisitor.SetWorld( this, NULL );
     m_index->Query( aItem, m_maxClearance, aVisitor );
 
@@ -280,6 +286,8 @@ int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles, int aK
 {
     DEFAULT_OBSTACLE_VISITOR visitor( aObstacles, aItem, aKindMask, aDifferentNetsOnly );
 
+    PERF_COUNTERS::Count( PERF_COUNTERS::Get().m_collisionQueries );
+
 #ifdef DEBUG
     assert( allocNodes.find( this ) != allocNodes.end() );
 #endif
@@ -1445,6 +1453,15 @@ int NODE::QueryJoints( const BOX2I& aBox,
 }
 
 
+void NODE::AllItems( std::vector<ITEM*>& aItems ) const
+{
+    aItems.reserve( aItems.size() + m_index->Size() );
+
+    for( ITEM* item : *m_index )
+        aItems.push_back( item );
+}
+
+
 ITEM *NODE::FindItemByParent( const BOARD_ITEM* aParent )
 {
     if( aParent->IsConnected() )
@@ -441,6 +441,9 @@ public:
 
     void RemoveByMarker( int aMarker );
 
+    ///> Appends the items stored in this node itself (not in its ancestors) to aItems
+    void AllItems( std::vector<ITEM*>& aItems ) const;
+
     ITEM* FindItemByParent( const BOARD_ITEM* aParent );
 
     bool HasChildren() const
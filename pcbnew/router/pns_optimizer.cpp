@@ -32,6 +32,7 @@
 #include "pns_node.h"
 #include "pns_solid.h"
 #include "pns_optimizer.h"
+#include "pns_perf_counters.h"
 
 #include "pns_utils.h"
 #include "pns_router.h"
@@ -492,6 +493,8 @@ bool OPTIMIZER::mergeObtuse( LINE* aLine )
     while( 1 )
     {
         iter++;
+        PERF_COUNTERS::Count( PERF_COUNTERS::Get().m_optimizerIterations );
+
         int n_segs = current_path.SegmentCount();
         int max_step = n_segs - 2;
 
@@ -572,6 +575,8 @@ bool OPTIMIZER::mergeFull( LINE* aLine )
 
     while( 1 )
     {
+        PERF_COUNTERS::Count( PERF_COUNTERS::Get().m_optimizerIterations );
+
         int n_segs = current_path.SegmentCount();
         int max_step = n_segs - 2;
 
@@ -1264,6 +1269,8 @@ bool OPTIMIZER::mergeDpSegments( DIFF_PAIR* aPair )
 
     while( 1 )
     {
+        PERF_COUNTERS::Count( PERF_COUNTERS::Get().m_optimizerIterations );
+
         int n_segs_p = aPair->CP().SegmentCount();
         int n_segs_n = aPair->CN().SegmentCount();
 
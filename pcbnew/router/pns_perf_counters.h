@@ -0,0 +1,78 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_PERF_COUNTERS_H
+#define __PNS_PERF_COUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace PNS {
+
+/**
+ * PERF_COUNTERS
+ *
+ * Counts the basic operations of the router, so that replays of logged routing sessions can
+ * report more than the time taken.  The counters are updated from the walkaround worker
+ * threads too, hence the atomics.
+ */
+struct PERF_COUNTERS
+{
+    struct SNAPSHOT
+    {
+        uint64_t m_branches;
+        uint64_t m_collisionQueries;
+        uint64_t m_optimizerIterations;
+    };
+
+    PERF_COUNTERS() :
+        m_branches( 0 ),
+        m_collisionQueries( 0 ),
+        m_optimizerIterations( 0 )
+    {}
+
+    ///> NODE::Branch() calls
+    std::atomic<uint64_t> m_branches;
+
+    ///> NODE::QueryColliding() calls
+    std::atomic<uint64_t> m_collisionQueries;
+
+    ///> passes of the OPTIMIZER segment merging loops
+    std::atomic<uint64_t> m_optimizerIterations;
+
+    SNAPSHOT Snapshot() const
+    {
+        return { m_branches.load(), m_collisionQueries.load(), m_optimizerIterations.load() };
+    }
+
+    static PERF_COUNTERS& Get()
+    {
+        static PERF_COUNTERS counters;
+        return counters;
+    }
+
+    static void Count( std::atomic<uint64_t>& aCounter )
+    {
+        aCounter.fetch_add( 1, std::memory_order_relaxed );
+    }
+};
+
+}
+
+#endif    // __PNS_PERF_COUNTERS_H
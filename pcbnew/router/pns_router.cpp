@@ -92,11 +92,24 @@ ROUTER::~ROUTER()
 
 void ROUTER::SyncWorld()
 {
+    // Routers outlive the routing sessions; the items ask the current one for the interface
+    theRouter = this;
+
+    // Patching the world of the previous session is much cheaper than rebuilding it
+    if( m_world )
+    {
+        m_placer.reset();
+        m_world->KillChildren();
+        m_world->ClearRanks();
+
+        if( m_iface->UpdateWorld( m_world.get() ) )
+            return;
+    }
+
     ClearWorld();
 
     m_world = std::make_unique<NODE>( );
     m_iface->SyncWorld( m_world.get() );
-
 }
 
 void ROUTER::ClearWorld()
@@ -156,6 +169,13 @@ bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM_SET aStartItems, int aDragM
     m_dragger->SetLogger( m_logger );
     m_dragger->SetDebugDecorator ( m_iface->GetDebugDecorator () );
 
+    if( m_logger )
+    {
+        // The router outlives the tool activations: log only the current operation
+        m_logger->Clear();
+        m_logger->Log( LOGGER::EVT_START_DRAG, aP, aStartItems[0] );
+    }
+
     if( m_dragger->Start ( aP, aStartItems ) )
         m_state = DRAG_SEGMENT;
     else
@@ -226,6 +246,8 @@ bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 
     if( m_logger )
     {
+        // The router outlives the tool activations: log only the current operation
+        m_logger->Clear();
         m_logger->Log( LOGGER::EVT_START_ROUTE, aP, aStartItem );
     }
 
@@ -307,7 +329,18 @@ void ROUTER::markViolations( NODE* aNode, ITEM_SET& aCurrent, NODE::ITEM_VECTOR&
         {
             int clearance = aNode->GetClearance( item, obs.m_item );
             std::unique_ptr<ITEM> tmp( obs.m_item->Clone() );
-            tmp->Mark( tmp->Marker() | MK_VIOLATION );
+            int                   marker = tmp->Marker() | MK_VIOLATION;
+
+            // Collisions are tested against the alternate shape of an obstacle which isn't
+            // on the item's layer; show that one.  This used to be recorded on the obstacle
+            // itself by ITEM::Collide(), which the concurrent walkaround search can't allow.
+            if( !item->Layers().IsMultilayer() && !m_iface->IsOnLayer( obs.m_item, item->Layer() )
+                    && obs.m_item->AlternateShape() )
+            {
+                marker |= MK_ALT_SHAPE;
+            }
+
+            tmp->Mark( marker );
             m_iface->DisplayItem( tmp.get(), -1, clearance );
             aRemoved.push_back( obs.m_item );
         }
@@ -460,6 +493,11 @@ void ROUTER::StopRouting()
     if( !RoutingInProgress() )
         return;
 
+    if( m_logger )
+    {
+        m_logger->Log( LOGGER::EVT_ABORT, m_currentEnd );
+    }
+
     m_placer.reset();
     m_dragger.reset();
 
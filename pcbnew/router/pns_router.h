@@ -96,6 +96,8 @@ enum DRAG_MODE
         virtual ~ROUTER_IFACE() {};
 
         virtual void SyncWorld( NODE* aNode ) = 0;
+        ///> Brings a world built by SyncWorld() up to date; false if it has to be rebuilt instead
+        virtual bool UpdateWorld( NODE* aNode ) = 0;
         virtual void AddItem( ITEM* aItem ) = 0;
         virtual void RemoveItem( ITEM* aItem ) = 0;
         virtual bool IsAnyLayerVisible( const LAYER_RANGE& aLayer ) const = 0;
@@ -80,19 +80,35 @@ TOOL_BASE::~TOOL_BASE()
 
 void TOOL_BASE::Reset( RESET_REASON aReason )
 {
+    if( aReason != RUN )
+    {
+        // The board or the view went away: start from scratch on the next run
+        if( m_router )
+            m_router->ClearWorld();
+
+        return;
+    }
+
+    // Later runs on the same board keep the router and its world, which SyncWorld() then
+    // patches with the changes made to the board in the meantime
+    if( !m_router || !m_router->GetWorld() || m_iface->GetBoard() != board() )
+    {
+        delete m_iface;
+        delete m_router;
+
+        m_iface = new PNS_KICAD_IFACE;
+        m_iface->SetBoard( board() );
+        m_iface->SetView( getView() );
+        m_iface->SetHostTool( this );
+
+        m_router = new ROUTER;
+        m_router->SetInterface( m_iface );
+        m_router->ClearWorld();
+    }
+
     delete m_gridHelper;
-    delete m_iface;
-    delete m_router;
 
-    m_iface = new PNS_KICAD_IFACE;
-    m_iface->SetBoard( board() );
-    m_iface->SetView( getView() );
-    m_iface->SetHostTool( this );
     m_iface->SetDisplayOptions( &( frame()->GetDisplayOptions() ) );
-
-    m_router = new ROUTER;
-    m_router->SetInterface( m_iface );
-    m_router->ClearWorld();
     m_router->SyncWorld();
 
     m_router->UpdateSizes( m_savedSizes );
@@ -19,6 +19,8 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <future>
+
 #include <core/optional.h>
 
 #include <geometry/shape_line_chain.h>
@@ -157,7 +159,7 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
 
 
 
-bool clipToLoopStart( SHAPE_LINE_CHAIN& l )
+bool clipToLoopStart( SHAPE_LINE_CHAIN& l, DEBUG_DECORATOR* aDbg )
 {
     auto ip = l.SelfIntersecting();
 
@@ -170,8 +172,8 @@ bool clipToLoopStart( SHAPE_LINE_CHAIN& l )
 
         int pidx2 = tail.Split( ip->p );
 
-        auto dbg = ROUTER::GetInstance()->GetInterface()->GetDebugDecorator();
-        dbg->AddPoint( ip->p, 5 );
+        if( aDbg )
+            aDbg->AddPoint( ip->p, 5 );
 
         l = lead;
         l.Append( tail.Slice( 0, pidx2 ) );
@@ -184,6 +186,38 @@ bool clipToLoopStart( SHAPE_LINE_CHAIN& l )
 
 
 
+const WALKAROUND::RESULT WALKAROUND::routeParallel( const LINE& aInitialPath )
+{
+    // Each direction gets its own walker; they only share the (read-only) world.  The debug
+    // decorator and the logger aren't thread-safe, so only the calling thread gets them.
+    WALKAROUND ccw( *this );
+
+    ccw.SetParallel( false );
+    ccw.SetForceWinding( true, false );
+    ccw.SetDebugDecorator( nullptr );
+    ccw.SetLogger( nullptr );
+
+    std::future<RESULT> ccwResult = std::async( std::launch::async,
+                                                [&]()
+                                                {
+                                                    return ccw.Route( aInitialPath );
+                                                } );
+
+    WALKAROUND cw( *this );
+
+    cw.SetParallel( false );
+    cw.SetForceWinding( true, true );
+
+    RESULT result = cw.Route( aInitialPath );
+    RESULT resultCcw = ccwResult.get();
+
+    result.statusCcw = resultCcw.statusCcw;
+    result.lineCcw = resultCcw.lineCcw;
+
+    return result;
+}
+
+
 const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
 {
     LINE path_cw( aInitialPath ), path_ccw( aInitialPath );
@@ -200,6 +234,9 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
         return RESULT( DONE, DONE, aInitialPath, aInitialPath );
     }
 
+    if( m_parallel && !m_forceWinding )
+        return routeParallel( aInitialPath );
+
     start( aInitialPath );
 
     m_currentObstacle[0] = m_currentObstacle[1] = nearestObstacle( aInitialPath );
@@ -227,12 +264,12 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
 
         auto old = path_cw.CLine();
 
-        if( clipToLoopStart( path_cw.Line() ))
+        if( clipToLoopStart( path_cw.Line(), Dbg() ))
         {
             s_cw = ALMOST_DONE;
         }
 
-        if( clipToLoopStart( path_ccw.Line() ))
+        if( clipToLoopStart( path_ccw.Line(), Dbg() ))
         {
             s_ccw = ALMOST_DONE;
         }
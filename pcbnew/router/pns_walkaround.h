@@ -54,6 +54,7 @@ public:
         m_iteration = 0;
         m_forceCw = false;
         m_forceUniqueWindingDirection = false;
+        m_parallel = false;
     }
 
     ~WALKAROUND() {};
@@ -126,6 +127,15 @@ public:
         m_forceWinding = aEnabled;
     }
 
+    /**
+     * Lets Route() search the clockwise and counter-clockwise paths on separate threads.
+     * The world must not be modified while routing.
+     */
+    void SetParallel( bool aEnabled )
+    {
+        m_parallel = aEnabled;
+    }
+
     void RestrictToSet( bool aEnabled, const std::set<ITEM*>& aSet )
     {
         if( aEnabled )
@@ -142,6 +152,8 @@ public:
 private:
     void start( const LINE& aInitialPath );
 
+    const RESULT routeParallel( const LINE& aInitialPath );
+
     WALKAROUND_STATUS singleStep( LINE& aPath, bool aWindingDirection );
     NODE::OPT_OBSTACLE nearestObstacle( const LINE& aPath );
 
@@ -156,6 +168,7 @@ private:
     bool m_forceWinding;
     bool m_forceCw;
     bool m_forceUniqueWindingDirection;
+    bool m_parallel;
     VECTOR2I m_cursorPos;
     NODE::OPT_OBSTACLE m_currentObstacle[2];
     bool m_recursiveCollision[2];
@@ -27,6 +27,7 @@
 #include <geometry/shape_simple.h>
 #include "class_track.h"
 #include <pcb_painter.h>
+#include <preview_items/preview_utils.h>
 
 #include "router_preview_item.h"
 
@@ -148,6 +149,11 @@ const BOX2I ROUTER_PREVIEW_ITEM::ViewBBox() const
         bbox = BOX2I ( m_pos - VECTOR2I( 100000, 100000 ), VECTOR2I( 200000, 200000 ) );
         return bbox;
 
+    case PR_TEXT:
+        // The text keeps a constant size on screen
+        bbox.SetMaximum();
+        return bbox;
+
     default:
         break;
     }
@@ -386,6 +392,11 @@ void ROUTER_PREVIEW_ITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
             drawShape( m_shape, gal );
         }
     }
+    else if( m_type == PR_TEXT )
+    {
+        gal->SetLayerDepth( BaseOverlayDepth );
+        KIGFX::PREVIEW::DrawTextNextToCursor( aView, m_pos, VECTOR2D( -1, 1 ), m_text, false );
+    }
 }
 
 
@@ -409,6 +420,14 @@ void ROUTER_PREVIEW_ITEM::Box( const BOX2I& aBox, int aStyle )
 }
 
 
+void ROUTER_PREVIEW_ITEM::Text( const VECTOR2I& aPos, const std::vector<wxString>& aLines )
+{
+    m_pos = aPos;
+    m_text = aLines;
+    m_type = PR_TEXT;
+}
+
+
 const COLOR4D ROUTER_PREVIEW_ITEM::getLayerColor( int aLayer ) const
 {
     auto settings = static_cast<PCB_RENDER_SETTINGS*>( m_view->GetPainter()->GetSettings() );
@@ -53,7 +53,8 @@ public:
     {
         PR_STUCK_MARKER = 0,
         PR_POINT,
-        PR_SHAPE
+        PR_SHAPE,
+        PR_TEXT
     };
 
     ROUTER_PREVIEW_ITEM( const PNS::ITEM* aItem = NULL, KIGFX::VIEW* aView = NULL);
@@ -66,6 +67,7 @@ public:
     void Line( const SHAPE_LINE_CHAIN& aLine, int aWidth = 0, int aStyle = 0 );
     void Box( const BOX2I& aBox, int aStyle = 0 );
     void Point ( const VECTOR2I& aPos, int aStyle = 0);
+    void Text( const VECTOR2I& aPos, const std::vector<wxString>& aLines );
 
     void SetColor( const KIGFX::COLOR4D& aColor )
     {
@@ -142,6 +144,7 @@ private:
 
     KIGFX::COLOR4D m_color;
     VECTOR2I m_pos;
+    std::vector<wxString> m_text;
 };
 
 #endif
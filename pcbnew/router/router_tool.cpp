@@ -473,8 +473,7 @@ bool ROUTER_TOOL::Init()
 
 void ROUTER_TOOL::Reset( RESET_REASON aReason )
 {
-    if( aReason == RUN )
-        TOOL_BASE::Reset( aReason );
+    TOOL_BASE::Reset( aReason );
 }
 
 
@@ -491,21 +490,9 @@ void ROUTER_TOOL::handleCommonEvents( const TOOL_EVENT& aEvent )
             if( ! logger )
                 return;
 
-            FILE *f = fopen("/tmp/pns.log", "wb");
             wxLogTrace( "PNS", "saving drag/route log...\n" );
 
-            const auto& events = logger->GetEvents();
-
-            for( auto evt : events)
-            {
-                wxString id = "null";
-                if( evt.item && evt.item->Parent() )
-                    id = evt.item->Parent()->m_Uuid.AsString();
-
-                fprintf(f, "event %d %d %d %s\n", evt.p.x, evt.p.y, evt.type, (const char*) id.c_str() );
-            }
-
-            fclose(f);
+            logger->Save( "/tmp/pns.log" );
 
             // Export as *.kicad_pcb format, using a strategy which is specifically chosen
             // as an example on how it could also be used to send it to the system clipboard.
@@ -331,7 +331,11 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
         THROW_IO_ERROR( _("Session file is missing the \"library_out\" section") );
 
     // delete all the old tracks and vias
+    for( TRACK* track : aBoard->Tracks() )
+        aBoard->UncacheItemById( track );
+
     aBoard->Tracks().clear();
+    aBoard->ResetChangeLog();
 
     aBoard->DeleteMARKERs();
 
@@ -249,6 +249,9 @@ void PCB_EDIT_FRAME::RunActionPlugin( ACTION_PLUGIN* aActionPlugin )
     aActionPlugin->Run();
     ACTION_PLUGINS::SetActionRunning( false );
 
+    // The plugin edits the board directly, without telling what it changed
+    currentPcb->OnUntrackedChanges();
+
     // Get back the undo buffer to fix some modifications
     PICKED_ITEMS_LIST* oldBuffer = NULL;
 
@@ -320,6 +320,7 @@ void Refresh()
     {
         auto board = s_PcbEditFrame->GetBoard();
         board->BuildConnectivity();
+        board->OnUntrackedChanges();
 
         // Re-init everything: this is the easy way to do that
         s_PcbEditFrame->ActivateGalCanvas();
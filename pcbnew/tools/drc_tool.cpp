@@ -40,13 +40,16 @@ DRC_TOOL::DRC_TOOL() :
         m_editFrame( nullptr ),
         m_pcb( nullptr ),
         m_drcDialog( nullptr ),
-        m_drcRunning( false )
+        m_drcRunning( false ),
+        m_incrementalTestsPending( false )
 {
 }
 
 
 DRC_TOOL::~DRC_TOOL()
 {
+    if( m_incrementalTestsPending )
+        m_editFrame->Unbind( wxEVT_IDLE, &DRC_TOOL::onIdleIncrementalTests, this );
 }
 
 
@@ -226,6 +229,98 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aTestTracksA
 }
 
 
+void DRC_TOOL::ScheduleIncrementalTests()
+{
+    if( m_incrementalTestsPending )
+        return;
+
+    m_incrementalTestsPending = true;
+    m_editFrame->Bind( wxEVT_IDLE, &DRC_TOOL::onIdleIncrementalTests, this );
+}
+
+
+void DRC_TOOL::onIdleIncrementalTests( wxIdleEvent& aEvent )
+{
+    m_editFrame->Unbind( wxEVT_IDLE, &DRC_TOOL::onIdleIncrementalTests, this );
+    m_incrementalTestsPending = false;
+
+    RunIncrementalTests();
+}
+
+
+bool DRC_TOOL::RunIncrementalTests( PROGRESS_REPORTER* aProgressReporter )
+{
+    // Our own commits (and the zone refills of a full run) get here too
+    if( m_drcRunning || !m_drcEngine || !m_drcEngine->CanRunIncrementally() )
+        return false;
+
+    if( !m_drcEngine->HasDirtyItems() )
+        return true;
+
+    BOARD_COMMIT                           commit( m_editFrame );
+    std::vector<std::shared_ptr<DRC_ITEM>> unconnected;
+
+    m_drcRunning = true;
+
+    // The markers about to be replaced may have been excluded
+    m_editFrame->RecordDRCExclusions();
+
+    // Drop the markers of everything which is about to be re-tested (or is gone)
+    for( MARKER_PCB* marker : m_pcb->Markers() )
+    {
+        std::shared_ptr<RC_ITEM> rcItem = marker->GetRCItem();
+
+        if(    m_drcEngine->IsDirtyItem( rcItem->GetMainItemID() )
+            || m_drcEngine->IsDirtyItem( rcItem->GetAuxItemID() )
+            || m_drcEngine->IsDirtyItem( rcItem->GetAuxItem2ID() )
+            || m_drcEngine->IsDirtyItem( rcItem->GetAuxItem3ID() ) )
+        {
+            commit.Remove( marker );
+        }
+    }
+
+    m_drcEngine->SetWorksheet( m_editFrame->GetCanvas()->GetWorksheet() );
+    m_drcEngine->SetProgressReporter( aProgressReporter );
+
+    m_drcEngine->SetViolationHandler(
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, wxPoint aPos )
+            {
+                // Footprint issues are board-wide; they're left to full runs.
+                if( aItem->GetErrorCode() == DRCE_UNCONNECTED_ITEMS )
+                {
+                    unconnected.push_back( aItem );
+                }
+                else if(    aItem->GetErrorCode() != DRCE_MISSING_FOOTPRINT
+                         && aItem->GetErrorCode() != DRCE_DUPLICATE_FOOTPRINT
+                         && aItem->GetErrorCode() != DRCE_EXTRA_FOOTPRINT
+                         && aItem->GetErrorCode() != DRCE_NET_CONFLICT )
+                {
+                    MARKER_PCB* marker = new MARKER_PCB( aItem, aPos );
+                    commit.Add( marker );
+                }
+            } );
+
+    bool ok = m_drcEngine->RunIncrementalTests( m_editFrame->GetUserUnits(),
+                                                m_drcEngine->GetTestTracksAgainstZones(),
+                                                m_drcEngine->GetReportAllTrackErrors() );
+
+    m_drcEngine->SetProgressReporter( nullptr );
+    m_drcEngine->ClearViolationHandler();
+
+    // The unconnected items were all reported again
+    if( ok )
+        m_unconnected = std::move( unconnected );
+
+    commit.Push( _( "DRC" ), false );
+
+    m_drcRunning = false;
+
+    updatePointers();
+
+    return ok;
+}
+
+
 void DRC_TOOL::updatePointers()
 {
     // update my pointers, m_editFrame is the only unchangeable one
@@ -56,6 +56,7 @@ private:
     BOARD*           m_pcb;
     DIALOG_DRC*      m_drcDialog;
     bool             m_drcRunning;
+    bool             m_incrementalTestsPending;
 
     std::shared_ptr<DRC_ENGINE>            m_drcEngine;
 
@@ -73,6 +74,8 @@ private:
 
     EDA_UNITS userUnits() const { return m_editFrame->GetUserUnits(); }
 
+    void onIdleIncrementalTests( wxIdleEvent& aEvent );
+
 public:
     /**
      * Open a dialog and prompts the user, then if a test run button is
@@ -117,6 +120,22 @@ public:
      */
     void RunTests( PROGRESS_REPORTER* aProgressReporter, bool aTestTracksAgainstZones,
                    bool aRefillZones, bool aReportAllTrackErrors, bool aTestFootprints );
+
+    /**
+     * Bring the markers of the last DRC run up to date with the changes committed since,
+     * re-testing only the changed items and their neighbourhood with the options of that run.
+     * The list of unconnected items is refreshed from the ratsnest.
+     *
+     * @return false if no incremental update was possible; a full run is then required.
+     */
+    bool RunIncrementalTests( PROGRESS_REPORTER* aProgressReporter = nullptr );
+
+    /**
+     * Run RunIncrementalTests() once the editor is idle, so that the edits don't wait for it
+     * and the changes of several commits are tested together.  Called after each commit, undo
+     * and redo when the IncrementalDrc advanced config option is set.
+     */
+    void ScheduleIncrementalTests();
 };
 
 
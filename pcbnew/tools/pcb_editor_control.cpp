@@ -385,8 +385,14 @@ int PCB_EDITOR_CONTROL::RepairBoard( const TOOL_EVENT& aEvent )
             {
                 if( ids.count( aItem->m_Uuid ) )
                 {
+                    BOARD_ITEM* boardItem = static_cast<BOARD_ITEM*>( aItem );
+
                     duplicates++;
+
+                    // Keep the board's KIID index in step
+                    board()->UncacheItemById( boardItem );
                     const_cast<KIID&>( aItem->m_Uuid ) = KIID();
+                    board()->CacheItemById( boardItem );
                 }
 
                 ids.insert( aItem->m_Uuid );
@@ -1012,7 +1012,18 @@ void PCB_INSPECTION_TOOL::calculateSelectionRatsnest( const VECTOR2I& aDelta )
         m_dynamicData->Move( aDelta );
     }
 
-    connectivity->ComputeDynamicRatsnest( items, m_dynamicData );
+    PCB_EDIT_FRAME* frame = m_frame;
+
+    connectivity->ComputeDynamicRatsnest( items, m_dynamicData,
+            [frame]()
+            {
+                // Called from the ratsnest worker: redraw once back in the UI thread
+                frame->CallAfter( [frame]()
+                                  {
+                                      frame->GetCanvas()->RedrawRatsnest();
+                                      frame->GetCanvas()->Refresh();
+                                  } );
+            } );
 }
 
 
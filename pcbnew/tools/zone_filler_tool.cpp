@@ -50,6 +50,10 @@ ZONE_FILLER_TOOL::~ZONE_FILLER_TOOL()
 
 void ZONE_FILLER_TOOL::Reset( RESET_REASON aReason )
 {
+    // A new board, or new rules: the fills can't be patched until they've been refilled
+    // entirely (see ZONE_FILLER::SetIncremental())
+    if( aReason == MODEL_RELOAD )
+        board()->OnUntrackedChanges();
 }
 
 
@@ -103,6 +107,7 @@ void ZONE_FILLER_TOOL::FillAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRepo
         toFill.push_back( zone );
 
     ZONE_FILLER filler( board(), &commit );
+    filler.SetIncremental( true );
 
     if( !board()->GetDesignSettings().m_DRCEngine->RulesValid() )
     {
@@ -167,6 +172,7 @@ int ZONE_FILLER_TOOL::ZoneFill( const TOOL_EVENT& aEvent )
     }
 
     ZONE_FILLER filler( board(), &commit );
+    filler.SetIncremental( true );
     filler.InstallNewProgressReporter( frame(), _( "Fill Zone" ), 4 );
 
     if( filler.Fill( toFill ) )
@@ -36,12 +36,15 @@ using namespace std::placeholders;
 #include <class_dimension.h>
 #include <origin_viewitem.h>
 #include <connectivity/connectivity_data.h>
+#include <drc/drc_engine.h>
 #include <pcbnew_settings.h>
 #include <tool/tool_manager.h>
 #include <tool/actions.h>
 #include <tools/selection_tool.h>
 #include <tools/pcbnew_control.h>
 #include <tools/pcb_editor_control.h>
+#include <tools/drc_tool.h>
+#include <advanced_config.h>
 #include <page_layout/ws_proxy_undo_item.h>
 
 /* Functions to undo and redo edit commands.
@@ -389,6 +392,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
 
     auto view = GetCanvas()->GetView();
     auto connectivity = GetBoard()->GetConnectivity();
+    auto drcEngine = GetBoard()->GetDesignSettings().m_DRCEngine;
 
     PCB_GROUP* group = nullptr;
 
@@ -456,6 +460,27 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
             break;
         }
 
+        // Let the DRC engine know what to re-test
+        if( drcEngine && ( status == UNDO_REDO::CHANGED || status == UNDO_REDO::NEWITEM
+                           || status == UNDO_REDO::DELETED ) )
+        {
+            drcEngine->MarkItemDirty( (BOARD_ITEM*) eda_item );
+
+            if( status == UNDO_REDO::CHANGED )
+                drcEngine->MarkItemDirty( (BOARD_ITEM*) aList->GetPickedItemLink( ii ) );
+        }
+
+        // And which parts of the zone fills may be out of date.  An undone zone fill is seen as
+        // a zone change, so the zone will be refilled entirely.
+        if( status == UNDO_REDO::CHANGED || status == UNDO_REDO::NEWITEM
+                || status == UNDO_REDO::DELETED )
+        {
+            GetBoard()->MarkZoneFillsDirty( (BOARD_ITEM*) eda_item );
+
+            if( status == UNDO_REDO::CHANGED )
+                GetBoard()->MarkZoneFillsDirty( (BOARD_ITEM*) aList->GetPickedItemLink( ii ) );
+        }
+
         switch( aList->GetPickedItemStatus( ii ) )
         {
         case UNDO_REDO::CHANGED:    /* Exchange old and new data for each item */
@@ -594,6 +619,12 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
     selTool->RebuildSelection();
 
     GetBoard()->SanitizeNetcodes();
+
+    if( IsType( FRAME_PCB_EDITOR ) && ADVANCED_CFG::GetCfg().m_IncrementalDrc )
+    {
+        if( DRC_TOOL* drcTool = m_toolManager->GetTool<DRC_TOOL>() )
+            drcTool->ScheduleIncrementalTests();
+    }
 }
 
 
@@ -25,7 +25,10 @@
 
 #include <thread>
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <future>
+#include <map>
 
 #include <advanced_config.h>
 #include <class_board.h>
@@ -44,8 +47,11 @@
 #include <geometry/convex_hull.h>
 #include <geometry/geometry_utils.h>
 #include <confirm.h>
+#include <hash_eda.h>
 #include <convert_to_biu.h>
 #include <math/util.h>      // for KiROUND
+#include <profile.h>
+#include <trace_helpers.h>
 #include "zone_filler.h"
 
 static const double s_RoundPadThermalSpokeAngle = 450;      // in deci-degrees
@@ -57,7 +63,11 @@ ZONE_FILLER::ZONE_FILLER(  BOARD* aBoard, COMMIT* aCommit ) :
         m_commit( aCommit ),
         m_progressReporter( nullptr ),
         m_maxError( ARC_HIGH_DEF ),
-        m_worstClearance( 0 )
+        m_worstClearance( 0 ),
+        m_worstPadThermal( 0 ),
+        m_fillSettingsHash( 0 ),
+        m_incremental( false ),
+        m_booleanThreads( 1 )
 {
     // To enable add "DebugZoneFiller=1" to kicad_advanced settings file.
     m_debugZoneFiller = ADVANCED_CFG::GetCfg().m_DebugZoneFiller;
@@ -88,6 +98,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
 {
     std::vector<std::pair<ZONE_CONTAINER*, PCB_LAYER_ID>> toFill;
     std::vector<CN_ZONE_ISOLATED_ISLAND_LIST> islandsList;
+    std::map<std::pair<ZONE_CONTAINER*, PCB_LAYER_ID>, SHAPE_POLY_SET> previousFills;
 
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
     std::unique_lock<std::mutex> lock( connectivity->GetLock(), std::try_to_lock );
@@ -95,6 +106,9 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
     BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
 
     m_worstClearance = bds.GetBiggestClearanceValue();
+    m_worstPadThermal = 0;
+    m_maxError = bds.m_MaxError;
+    m_fillSettingsHash = fillSettingsHash();
 
     if( !lock )
         return false;
@@ -125,6 +139,9 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
         {
             if( pad->IsDirty() )
                 pad->BuildEffectiveShapes( UNDEFINED_LAYER );
+
+            m_worstPadThermal = std::max( m_worstPadThermal,
+                                          pad->GetThermalGap() + pad->GetThermalSpokeWidth() );
         }
 
         for( ZONE_CONTAINER* zone : module->Zones() )
@@ -158,6 +175,10 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
 
             // Add the zone to the list of zones to test or refill
             toFill.emplace_back( std::make_pair( zone, layer ) );
+
+            // Keep what's needed to patch the current fill, before it's cleared
+            if( m_incremental && !aCheck && canRefillIncrementally( zone, layer ) )
+                previousFills[ { zone, layer } ] = zone->RawPolysList( layer );
         }
 
         islandsList.emplace_back( CN_ZONE_ISOLATED_ISLAND_LIST( zone ) );
@@ -167,10 +188,10 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
         zone->UnFill();
 
         zone->SetFillVersion( bds.m_ZoneFillVersion );
+        zone->SetFillSettingsHash( m_fillSettingsHash );
     }
 
     size_t cores = std::thread::hardware_concurrency();
-    std::atomic<size_t> nextItem;
 
     auto check_fill_dependency =
             [&]( ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer, ZONE_CONTAINER* aOtherZone ) -> bool
@@ -206,95 +227,306 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
                 return inflatedBBox.Intersects( aOtherZone->GetCachedBoundingBox() );
             };
 
+    // Each (zone, layer) pair is filled in two stages.  The clearances of the board's copper
+    // items don't depend on anything, but knocking out higher-priority zones needs their fill,
+    // so the second stage of a pair can only start once those zones are done.
+    //
+    // When refilling incrementally, only the parts of the previous fill near the changes made
+    // since are recomputed (and only the items near them are knocked out).
+    struct FILL_TASK
+    {
+        ZONE_CONTAINER*       zone = nullptr;
+        PCB_LAYER_ID          layer = UNDEFINED_LAYER;
+        SHAPE_POLY_SET        itemClearances;
+        std::vector<size_t>   dependents;     // tasks waiting for this one's fill
+        size_t                blockers = 0;   // own clearances + unfilled higher-priority zones
+
+        bool                  incremental = false;
+        SHAPE_POLY_SET        previousFill;
+        std::vector<EDA_RECT> dirtyRects;     // changes to take into account
+        SHAPE_POLY_SET        dirtyArea;      // part of previousFill to recompute
+        SHAPE_POLY_SET        window;         // area to fill to recompute it
+    };
+
+    std::vector<FILL_TASK> tasks( toFill.size() );
+    std::map<std::pair<ZONE_CONTAINER*, PCB_LAYER_ID>, size_t> taskIndex;
+
+    for( size_t ii = 0; ii < toFill.size(); ++ii )
+    {
+        tasks[ii].zone = toFill[ii].first;
+        tasks[ii].layer = toFill[ii].second;
+        tasks[ii].blockers = 1;
+        taskIndex[ toFill[ii] ] = ii;
+
+        auto previous = previousFills.find( toFill[ii] );
+
+        if( previous != previousFills.end() )
+        {
+            tasks[ii].incremental = true;
+            tasks[ii].previousFill = std::move( previous->second );
+            tasks[ii].dirtyRects = toFill[ii].first->GetFillDirtyAreas();
+        }
+    }
+
+    for( size_t ii = 0; ii < tasks.size(); ++ii )
+    {
+        for( ZONE_CONTAINER* otherZone : aZones )
+        {
+            if( otherZone == tasks[ii].zone )
+                continue;
+
+            if( check_fill_dependency( tasks[ii].zone, tasks[ii].layer, otherZone ) )
+            {
+                auto it = taskIndex.find( { otherZone, tasks[ii].layer } );
+
+                if( it != taskIndex.end() )
+                {
+                    tasks[ it->second ].dependents.push_back( ii );
+                    tasks[ii].blockers++;
+                }
+            }
+        }
+    }
+
+    // Higher-priority zones come first, so by the time a zone is reached the changes to the
+    // fills which it knocks out are known.
+    for( FILL_TASK& task : tasks )
+    {
+        if( task.incremental )
+        {
+            task.incremental = buildDirtyArea( task.zone, task.dirtyRects, task.dirtyArea,
+                                               task.window );
+        }
+
+        for( size_t dependent : task.dependents )
+        {
+            if( task.incremental )
+            {
+                for( EDA_RECT rect : task.dirtyRects )
+                {
+                    rect.Inflate( dirtyAreaMargin( task.zone ) );
+                    tasks[dependent].dirtyRects.push_back( rect );
+                }
+            }
+            else
+            {
+                tasks[dependent].dirtyRects.push_back( task.zone->GetCachedBoundingBox() );
+            }
+        }
+
+        if( !task.incremental )
+            task.previousFill.RemoveAllContours();
+    }
+
+    std::mutex              queueLock;
+    std::condition_variable queueChanged;
+    std::deque<size_t>      readyToFill;
+    size_t                  nextClearances = 0;
+    size_t                  filled = 0;
+    bool                    cancelled = false;
+
+    std::atomic<long long>  clearancesTime( 0 );
+    std::atomic<long long>  fillTime( 0 );
+
+    auto unblock =
+            [&]( size_t aTask )
+            {
+                if( --tasks[aTask].blockers == 0 )
+                    readyToFill.push_back( aTask );
+            };
+
     auto fill_lambda =
-            [&]( PROGRESS_REPORTER* aReporter )
+            [&]( PROGRESS_REPORTER* aReporter ) -> size_t
             {
                 size_t num = 0;
+                std::unique_lock<std::mutex> lock( queueLock );
 
-                for( size_t i = nextItem++; i < toFill.size(); i = nextItem++ )
+                while( true )
                 {
-                    PCB_LAYER_ID    layer = toFill[i].second;
-                    ZONE_CONTAINER* zone = toFill[i].first;
-                    bool            canFill = true;
+                    queueChanged.wait( lock,
+                            [&]()
+                            {
+                                return cancelled || filled == tasks.size()
+                                        || !readyToFill.empty()
+                                        || nextClearances < tasks.size();
+                            } );
+
+                    if( cancelled || filled == tasks.size() )
+                        break;
 
-                    // Check for any fill dependencies.  If our zone needs to be clipped by
-                    // another zone then we can't fill until that zone is filled.
-                    for( ZONE_CONTAINER* otherZone : aZones )
+                    if( aReporter && aReporter->IsCancelled() )
                     {
-                        if( otherZone == zone )
-                            continue;
+                        cancelled = true;
+                        queueChanged.notify_all();
+                        break;
+                    }
 
-                        if( check_fill_dependency( zone, layer, otherZone ) )
+                    // Fills unblock other tasks, so they go first
+                    if( !readyToFill.empty() )
+                    {
+                        FILL_TASK& task = tasks[ readyToFill.front() ];
+                        readyToFill.pop_front();
+                        lock.unlock();
+
+                        PROF_COUNTER   timer;
+                        SHAPE_POLY_SET rawPolys, finalPolys;
+
+                        if( task.incremental )
                         {
-                            canFill = false;
-                            break;
+                            refillDirtyArea( task.zone, task.layer, task.itemClearances,
+                                             task.dirtyArea, task.window, task.previousFill,
+                                             rawPolys, finalPolys );
+
+                            task.previousFill.RemoveAllContours();
+                        }
+                        else
+                        {
+                            fillSingleZone( task.zone, task.layer, task.itemClearances,
+                                            rawPolys, finalPolys );
                         }
+
+                        {
+                            std::unique_lock<std::mutex> zoneLock( task.zone->GetLock() );
+
+                            task.zone->SetRawPolysList( task.layer, rawPolys );
+                            task.zone->SetFilledPolysList( task.layer, finalPolys );
+                            task.zone->SetFillFlag( task.layer, true );
+                        }
+
+                        task.itemClearances.RemoveAllContours();
+                        fillTime += timer.SinceStart<std::chrono::microseconds>().count();
+
+                        if( aReporter )
+                            aReporter->AdvanceProgress();
+
+                        num++;
+
+                        lock.lock();
+                        filled++;
+
+                        for( size_t dependent : task.dependents )
+                            unblock( dependent );
                     }
+                    else
+                    {
+                        size_t     taskId = nextClearances++;
+                        FILL_TASK& task = tasks[ taskId ];
+                        lock.unlock();
 
-                    if( m_progressReporter && m_progressReporter->IsCancelled() )
-                        break;
+                        PROF_COUNTER timer;
+                        PCB_LAYER_ID layer = task.layer;
 
-                    if( !canFill )
-                        continue;
+                        // Match the layer substitution done by computeRawFilledArea()
+                        if( m_debugZoneFiller && LSET::InternalCuMask().Contains( layer ) )
+                            layer = F_Cu;
 
-                    // Now we're ready to fill.
-                    SHAPE_POLY_SET rawPolys, finalPolys;
-                    fillSingleZone( zone, layer, rawPolys, finalPolys );
+                        EDA_RECT area = task.zone->GetCachedBoundingBox();
 
-                    std::unique_lock<std::mutex> zoneLock( zone->GetLock() );
+                        if( task.incremental )
+                        {
+                            BOX2I window = task.window.BBox();
 
-                    zone->SetRawPolysList( layer, rawPolys );
-                    zone->SetFilledPolysList( layer, finalPolys );
-                    zone->SetFillFlag( layer, true );
+                            area = EDA_RECT( (wxPoint) window.GetPosition(),
+                                             wxSize( window.GetWidth(), window.GetHeight() ) );
+                        }
 
-                    if( m_progressReporter )
-                        m_progressReporter->AdvanceProgress();
+                        if( task.zone->IsOnCopperLayer()
+                                && !( task.incremental && task.dirtyArea.IsEmpty() ) )
+                        {
+                            buildCopperItemClearances( task.zone, layer, area,
+                                                       task.itemClearances );
+                        }
 
-                    num++;
+                        clearancesTime += timer.SinceStart<std::chrono::microseconds>().count();
+
+                        lock.lock();
+                        unblock( taskId );
+                    }
+
+                    queueChanged.notify_all();
                 }
 
                 return num;
             };
 
-    while( !toFill.empty() )
+    PROF_COUNTER fillWallTime;
+    size_t fillThreadCount = std::min( cores, tasks.size() );
+
+    // When there are fewer zone layers than cores, the spare ones go to the large boolean ops
+    // inside each fill
+    size_t threadsPerFill = cores / std::max<size_t>( fillThreadCount, 1 );
+    m_booleanThreads = (int) std::max<size_t>( threadsPerFill, 1 );
+
+    if( fillThreadCount <= 1 )
+    {
+        fill_lambda( m_progressReporter );
+    }
+    else
     {
-        size_t parallelThreadCount = std::min( cores, toFill.size() );
-        std::vector<std::future<size_t>> returns( parallelThreadCount );
+        std::vector<std::future<size_t>> returns( fillThreadCount );
 
-        nextItem = 0;
+        for( size_t ii = 0; ii < fillThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, fill_lambda, m_progressReporter );
 
-        if( parallelThreadCount <= 1 )
-            fill_lambda( m_progressReporter );
-        else
+        for( size_t ii = 0; ii < fillThreadCount; ++ii )
         {
-            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-                returns[ii] = std::async( std::launch::async, fill_lambda, m_progressReporter );
-
-            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            // Here we balance returns with a 100ms timeout to allow UI updating
+            std::future_status status;
+            do
             {
-                // Here we balance returns with a 100ms timeout to allow UI updating
-                std::future_status status;
-                do
-                {
-                    if( m_progressReporter )
-                        m_progressReporter->KeepRefreshing();
+                if( m_progressReporter )
+                    m_progressReporter->KeepRefreshing();
 
-                    status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
-                } while( status != std::future_status::ready );
-            }
+                status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+            } while( status != std::future_status::ready );
         }
+    }
 
-        toFill.erase( std::remove_if( toFill.begin(), toFill.end(),
-                      [&] ( const std::pair<ZONE_CONTAINER*, PCB_LAYER_ID> pair ) -> bool
-                      {
-                          return pair.first->GetFillFlag( pair.second );
-                      } ),
-                      toFill.end() );
+    fillWallTime.Stop();
 
-        if( m_progressReporter && m_progressReporter->IsCancelled() )
-            break;
+    int patched = std::count_if( tasks.begin(), tasks.end(),
+                                 []( const FILL_TASK& aTask )
+                                 {
+                                     return aTask.incremental;
+                                 } );
+
+    wxLogTrace( traceZoneFiller, "Filled %d zone layers (%d patched) on %d threads in %0.1f ms "
+                "(clearances %0.1f ms, fills %0.1f ms of thread time)",
+                (int) tasks.size(), patched, (int) std::max<size_t>( fillThreadCount, 1 ),
+                fillWallTime.msecs(), clearancesTime / 1000.0, fillTime / 1000.0 );
+
+    // The zones knocked out by the new fills but which weren't refilled with them will have
+    // to take the changes into account the next time
+    for( const FILL_TASK& task : tasks )
+    {
+        for( ZONE_CONTAINER* otherZone : m_board->Zones() )
+        {
+            if( otherZone->GetIsRuleArea() || !otherZone->GetLayerSet().test( task.layer )
+                    || otherZone->GetPriority() >= task.zone->GetPriority()
+                    || otherZone->GetNetCode() == task.zone->GetNetCode()
+                    || std::find( aZones.begin(), aZones.end(), otherZone ) != aZones.end() )
+            {
+                continue;
+            }
+
+            if( task.incremental )
+            {
+                for( EDA_RECT rect : task.dirtyRects )
+                {
+                    rect.Inflate( dirtyAreaMargin( task.zone ) );
+                    otherZone->AddFillDirtyArea( rect );
+                }
+            }
+            else
+            {
+                otherZone->AddFillDirtyArea( task.zone->GetCachedBoundingBox() );
+            }
+        }
     }
 
+    for( ZONE_CONTAINER* zone : aZones )
+        zone->ClearFillDirtyAreas();
+
     // Now update the connectivity to check for copper islands
     if( m_progressReporter )
     {
@@ -306,6 +538,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
         m_progressReporter->KeepRefreshing();
     }
 
+    PROF_COUNTER islandsTime;
+
     connectivity->SetProgressReporter( m_progressReporter );
     connectivity->FindIsolatedCopperIslands( islandsList );
     connectivity->SetProgressReporter( nullptr );
@@ -363,6 +597,10 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
         }
     }
 
+    wxLogTrace( traceZoneFiller, "Removed insulated islands in %0.1f ms", islandsTime.msecs() );
+
+    PROF_COUNTER boardEdgeTime;
+
     // Now remove islands outside the board edge
     for( ZONE_CONTAINER* zone : aZones )
     {
@@ -391,6 +629,9 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
         }
     }
 
+    wxLogTrace( traceZoneFiller, "Removed islands outside the board edge in %0.1f ms",
+                boardEdgeTime.msecs() );
+
     if( aCheck )
     {
         bool outOfDate = false;
@@ -432,7 +673,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
         m_progressReporter->SetMaxProgress( islandsList.size() );
     }
 
-    nextItem = 0;
+    std::atomic<size_t> nextItem( 0 );
 
     auto tri_lambda =
             [&]( PROGRESS_REPORTER* aReporter ) -> size_t
@@ -694,7 +935,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE_CONTAINER* aZone, PCB_LAYER
  * not connected to it.
  */
 void ZONE_FILLER::buildCopperItemClearances( const ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
-                                             SHAPE_POLY_SET& aHoles )
+                                             const EDA_RECT& aArea, SHAPE_POLY_SET& aHoles )
 {
     long ticker = 0;
 
@@ -716,7 +957,7 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE_CONTAINER* aZone, PCB_LA
 
     BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
     int                    zone_clearance = aZone->GetLocalClearance();
-    EDA_RECT               zone_boundingbox = aZone->GetCachedBoundingBox();
+    EDA_RECT               zone_boundingbox = aArea;
 
     // Items outside the zone bounding box are skipped, so it needs to be inflated by the
     // largest clearance value found in the netclasses and rules
@@ -883,6 +1124,39 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE_CONTAINER* aZone, PCB_LA
         knockoutGraphic( item );
     }
 
+    aHoles.Simplify( SHAPE_POLY_SET::PM_FAST );
+}
+
+
+/**
+ * Adds the clearances of higher-priority zones with other nets and of copper pour keepouts.
+ * Unlike the other copper items, the former have to be filled first.
+ */
+void ZONE_FILLER::buildZoneClearances( const ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
+                                       SHAPE_POLY_SET& aHoles )
+{
+    long ticker = 0;
+
+    auto checkForCancel =
+            [&ticker]( PROGRESS_REPORTER* aReporter ) -> bool
+            {
+                return aReporter && ( ticker++ % 50 ) == 0 && aReporter->IsCancelled();
+            };
+
+    int                    extra_margin = Millimeter2iu( ADVANCED_CFG::GetCfg().m_ExtraClearance );
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    EDA_RECT               zone_boundingbox = aZone->GetCachedBoundingBox();
+
+    zone_boundingbox.Inflate( m_worstClearance + extra_margin );
+
+    auto evalRulesForItems =
+            [&]( DRC_CONSTRAINT_TYPE_T aConstraint, const BOARD_ITEM* a, const BOARD_ITEM* b,
+                 PCB_LAYER_ID aCtLayer ) -> int
+            {
+                DRC_CONSTRAINT c = bds.m_DRCEngine->EvalRulesForItems( aConstraint, a, b, aCtLayer );
+                return c.Value().HasMin() ? c.Value().Min() : 0;
+            };
+
     // Add non-connected zone clearances
     //
     auto knockoutZone =
@@ -1030,6 +1304,7 @@ void ZONE_FILLER::subtractHigherPriorityZones( const ZONE_CONTAINER* aZone, PCB_
  */
 void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
                                         const SHAPE_POLY_SET& aSmoothedOutline,
+                                        const SHAPE_POLY_SET& aItemClearances,
                                         SHAPE_POLY_SET& aRawPolys,
                                         SHAPE_POLY_SET& aFinalPolys )
 {
@@ -1061,7 +1336,7 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone, PCB_LAYER_I
     SHAPE_POLY_SET::CORNER_STRATEGY cornerStrategy = SHAPE_POLY_SET::ROUND_ALL_CORNERS;
 
     std::deque<SHAPE_LINE_CHAIN> thermalSpokes;
-    SHAPE_POLY_SET clearanceHoles;
+    SHAPE_POLY_SET clearanceHoles = aItemClearances;
 
     aRawPolys = aSmoothedOutline;
     DUMP_POLYS_TO_COPPER_LAYER( aRawPolys, In1_Cu, "smoothed-outline" );
@@ -1075,7 +1350,7 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone, PCB_LAYER_I
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return;
 
-    buildCopperItemClearances( aZone, aLayer, clearanceHoles );
+    buildZoneClearances( aZone, aLayer, clearanceHoles );
     DUMP_POLYS_TO_COPPER_LAYER( clearanceHoles, In3_Cu, "clearance-holes" );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1090,7 +1365,7 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone, PCB_LAYER_I
     // because the "real" subtract-clearance-holes has to be done after the spokes are added.
     static const bool USE_BBOX_CACHES = true;
     SHAPE_POLY_SET testAreas = aRawPolys;
-    testAreas.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    testAreas.BooleanSubtractTiled( clearanceHoles, SHAPE_POLY_SET::PM_FAST, m_booleanThreads );
     DUMP_POLYS_TO_COPPER_LAYER( testAreas, In4_Cu, "minus-clearance-holes" );
 
     // Prune features that don't meet minimum-width criteria
@@ -1154,7 +1429,7 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone, PCB_LAYER_I
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return;
 
-    aRawPolys.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    aRawPolys.BooleanSubtractTiled( clearanceHoles, SHAPE_POLY_SET::PM_FAST, m_booleanThreads );
     DUMP_POLYS_TO_COPPER_LAYER( aRawPolys, In8_Cu, "after-spoke-trimming" );
 
     // Prune features that don't meet minimum-width criteria
@@ -1192,7 +1467,7 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone, PCB_LAYER_I
     // add copper outside the zone boundary or inside the clearance holes
     aRawPolys.BooleanIntersection( aSmoothedOutline, SHAPE_POLY_SET::PM_FAST );
     DUMP_POLYS_TO_COPPER_LAYER( aRawPolys, In12_Cu, "after-trim-to-outline" );
-    aRawPolys.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    aRawPolys.BooleanSubtractTiled( clearanceHoles, SHAPE_POLY_SET::PM_FAST, m_booleanThreads );
     DUMP_POLYS_TO_COPPER_LAYER( aRawPolys, In13_Cu, "after-trim-to-clearance-holes" );
 
     // Lastly give any same-net but higher-priority zones control over their own area.
@@ -1210,6 +1485,7 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone, PCB_LAYER_I
  * ( holes are linked by overlapping segments to the main outline)
  */
 bool ZONE_FILLER::fillSingleZone( ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
+                                  const SHAPE_POLY_SET& aItemClearances,
                                   SHAPE_POLY_SET& aRawPolys, SHAPE_POLY_SET& aFinalPolys )
 {
     SHAPE_POLY_SET* boardOutline = m_brdOutlinesValid ? &m_boardOutline : nullptr;
@@ -1228,7 +1504,8 @@ bool ZONE_FILLER::fillSingleZone( ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
 
     if( aZone->IsOnCopperLayer() )
     {
-        computeRawFilledArea( aZone, aLayer, smoothedPoly, aRawPolys, aFinalPolys );
+        computeRawFilledArea( aZone, aLayer, smoothedPoly, aItemClearances, aRawPolys,
+                              aFinalPolys );
     }
     else
     {
@@ -1265,6 +1542,171 @@ bool ZONE_FILLER::fillSingleZone( ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
 }
 
 
+bool ZONE_FILLER::canRefillIncrementally( ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer ) const
+{
+    // Hatch patterns are laid out from the bounding box of the whole fill, so they can't be
+    // patched.  Neither can the dumps of the zone filler's debug mode.
+    //
+    // Rule, netclass and design settings changes don't mark any zone dirty, so the fills
+    // made with other ones have to be refilled entirely.
+    return !m_debugZoneFiller
+            && aZone->IsFilled() && !aZone->NeedRefill()
+            && aZone->GetFillVersion() == m_board->GetDesignSettings().m_ZoneFillVersion
+            && aZone->GetFillSettingsHash() == m_fillSettingsHash
+            && aZone->IsOnCopperLayer()
+            && aZone->GetFillMode() == ZONE_FILL_MODE::POLYGONS
+            && aZone->HasRawPolysForLayer( aLayer )
+            && !aZone->RawPolysList( aLayer ).IsEmpty();
+}
+
+
+size_t ZONE_FILLER::fillSettingsHash() const
+{
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    size_t                 hash = hash_val( bds.m_MaxError, bds.GetHolePlatingThickness() );
+
+    // The clearances come from the rules, which include those of the netclasses and of the
+    // design settings
+    if( bds.m_DRCEngine )
+        hash_combine( hash, bds.m_DRCEngine->GetRulesHash() );
+
+    return hash;
+}
+
+
+int ZONE_FILLER::dirtyAreaMargin( const ZONE_CONTAINER* aZone ) const
+{
+    int extra_margin = Millimeter2iu( ADVANCED_CFG::GetCfg().m_ExtraClearance );
+    int thermal = std::max( aZone->GetThermalReliefGap() + aZone->GetThermalReliefSpokeWidth(),
+                            m_worstPadThermal );
+
+    return m_worstClearance + extra_margin + thermal + aZone->GetMinThickness();
+}
+
+
+bool ZONE_FILLER::buildDirtyArea( const ZONE_CONTAINER* aZone,
+                                  const std::vector<EDA_RECT>& aDirtyRects,
+                                  SHAPE_POLY_SET& aDirtyArea, SHAPE_POLY_SET& aWindow ) const
+{
+    EDA_RECT zoneBBox = aZone->GetCachedBoundingBox();
+    int      margin = dirtyAreaMargin( aZone );
+    int      tileSize = std::max( margin, Millimeter2iu( 1 ) );
+
+    // Tiles are aligned on the zone's bounding box
+    auto snap =
+            [&]( int aCoord, int aOrigin, bool aUp ) -> int
+            {
+                long long offset = (long long) aCoord - aOrigin;
+                long long tiles = offset / tileSize;
+
+                if( offset % tileSize != 0 && ( offset > 0 ) == aUp )
+                    tiles += aUp ? 1 : -1;
+
+                return (int) ( aOrigin + tiles * tileSize );
+            };
+
+    auto addRect =
+            []( SHAPE_POLY_SET& aSet, int aLeft, int aTop, int aRight, int aBottom )
+            {
+                aSet.NewOutline();
+                aSet.Append( aLeft, aTop );
+                aSet.Append( aRight, aTop );
+                aSet.Append( aRight, aBottom );
+                aSet.Append( aLeft, aBottom );
+            };
+
+    aDirtyArea.RemoveAllContours();
+    aWindow.RemoveAllContours();
+
+    for( EDA_RECT rect : aDirtyRects )
+    {
+        rect.Normalize();
+        rect.Inflate( margin );
+
+        if( !rect.Intersects( zoneBBox ) )
+            continue;
+
+        int left = snap( rect.GetLeft(), zoneBBox.GetX(), false );
+        int top = snap( rect.GetTop(), zoneBBox.GetY(), false );
+        int right = snap( rect.GetRight(), zoneBBox.GetX(), true );
+        int bottom = snap( rect.GetBottom(), zoneBBox.GetY(), true );
+
+        addRect( aDirtyArea, left, top, right, bottom );
+
+        // Clipping the zone outline to the window changes the fill up to a margin inside it,
+        // which must stay clear of the dirty area
+        addRect( aWindow, left - 2 * margin, top - 2 * margin, right + 2 * margin,
+                 bottom + 2 * margin );
+    }
+
+    aDirtyArea.Simplify( SHAPE_POLY_SET::PM_FAST );
+    aWindow.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    double dirtyArea = 0.0;
+
+    for( int ii = 0; ii < aDirtyArea.OutlineCount(); ++ii )
+        dirtyArea += std::abs( aDirtyArea.Outline( ii ).Area() );
+
+    // Beyond half of the zone the bookkeeping costs more than it saves
+    return dirtyArea < 0.5 * (double) zoneBBox.GetWidth() * zoneBBox.GetHeight();
+}
+
+
+bool ZONE_FILLER::refillDirtyArea( ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
+                                   const SHAPE_POLY_SET& aItemClearances,
+                                   const SHAPE_POLY_SET& aDirtyArea,
+                                   const SHAPE_POLY_SET& aWindow,
+                                   const SHAPE_POLY_SET& aPreviousFill,
+                                   SHAPE_POLY_SET& aRawPolys, SHAPE_POLY_SET& aFinalPolys )
+{
+    SHAPE_POLY_SET* boardOutline = m_brdOutlinesValid ? &m_boardOutline : nullptr;
+    SHAPE_POLY_SET  smoothedPoly;
+
+    if( aDirtyArea.IsEmpty() )
+    {
+        aRawPolys = aPreviousFill;
+        aFinalPolys = aRawPolys;
+        aZone->SetNeedRefill( false );
+        return true;
+    }
+
+    if( !aZone->BuildSmoothedPoly( smoothedPoly, aLayer, boardOutline ) )
+        return false;
+
+    smoothedPoly.BooleanIntersection( aWindow, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET patch;
+    SHAPE_POLY_SET finalPatch;
+
+    if( !smoothedPoly.IsEmpty() )
+    {
+        computeRawFilledArea( aZone, aLayer, smoothedPoly, aItemClearances, patch, finalPatch );
+
+        if( m_progressReporter && m_progressReporter->IsCancelled() )
+            return false;
+    }
+
+    // Let the patch overlap the previous fill a little so that no slivers are left where they
+    // meet.  Both are exact there.
+    SHAPE_POLY_SET patchArea = aDirtyArea;
+    patchArea.Inflate( Millimeter2iu( 0.01 ), 4, SHAPE_POLY_SET::CHAMFER_ALL_CORNERS );
+    patch.BooleanIntersection( patchArea, SHAPE_POLY_SET::PM_FAST );
+
+    // Patch the previous fill with its holes back, and fracture the result like
+    // computeRawFilledArea() does
+    aRawPolys = aPreviousFill;
+    aRawPolys.Unfracture( SHAPE_POLY_SET::PM_FAST );
+    aRawPolys.BooleanSubtract( aDirtyArea, SHAPE_POLY_SET::PM_FAST );
+    aRawPolys.BooleanAdd( patch, SHAPE_POLY_SET::PM_FAST );
+    aRawPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    aFinalPolys = aRawPolys;
+
+    aZone->SetNeedRefill( false );
+    return true;
+}
+
+
 /**
  * Function buildThermalSpokes
  */
@@ -47,6 +47,14 @@ public:
     bool Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck = false,
                wxWindow* aParent = nullptr );
 
+    /**
+     * Allows Fill() to only recompute the parts of the zones marked as dirty since their last
+     * fill (see BOARD::MarkZoneFillsDirty()).  Zones which can't be refilled that way are still
+     * refilled entirely.  Only valid when all the changes since then went through commits or
+     * were followed by BOARD::OnUntrackedChanges().
+     */
+    void SetIncremental( bool aIncremental ) { m_incremental = aIncremental; }
+
 private:
 
     void addKnockout( D_PAD* aPad, PCB_LAYER_ID aLayer, int aGap, SHAPE_POLY_SET& aHoles );
@@ -57,8 +65,19 @@ private:
     void knockoutThermalReliefs( const ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
                                  SHAPE_POLY_SET& aFill );
 
+    /**
+     * Builds the clearance holes of the copper items (pads, tracks, graphics, text and board
+     * edges) near aArea on aLayer.  Doesn't depend on the fill of any other zone.
+     */
     void buildCopperItemClearances( const ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
-                                    SHAPE_POLY_SET& aHoles );
+                                    const EDA_RECT& aArea, SHAPE_POLY_SET& aHoles );
+
+    /**
+     * Adds the clearance holes of keepouts and of higher-priority zones with other nets to
+     * aHoles.  The latter must have been filled first.
+     */
+    void buildZoneClearances( const ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
+                              SHAPE_POLY_SET& aHoles );
 
     void subtractHigherPriorityZones( const ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
                                       SHAPE_POLY_SET& aRawFill );
@@ -76,6 +95,7 @@ private:
      */
     void computeRawFilledArea( const ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
                                const SHAPE_POLY_SET& aSmoothedOutline,
+                               const SHAPE_POLY_SET& aItemClearances,
                                SHAPE_POLY_SET& aRawPolys, SHAPE_POLY_SET& aFinalPolys );
 
     /**
@@ -92,6 +112,7 @@ private:
      * in order to have drawable (and plottable) filled polygons.
      * @return true if OK, false if the solid polygons cannot be built
      * @param aZone is the zone to fill
+     * @param aItemClearances are the copper item clearances built by buildCopperItemClearances()
      * @param aRawPolys: A reference to a SHAPE_POLY_SET buffer to store
      * filled solid areas polygons (with holes)
      * @param aFinalPolys: A reference to a SHAPE_POLY_SET buffer to store polygons with no holes
@@ -99,9 +120,49 @@ private:
      * by aZone->GetMinThickness() / 2 to be drawn with a outline thickness = aZone->GetMinThickness()
      * aFinalPolys are polygons that will be drawn on screen and plotted
      */
-    bool fillSingleZone( ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aRawPolys,
+    bool fillSingleZone( ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
+                         const SHAPE_POLY_SET& aItemClearances, SHAPE_POLY_SET& aRawPolys,
                          SHAPE_POLY_SET& aFinalPolys );
 
+    /**
+     * @return true if the previous fill of aZone on aLayer can be patched rather than
+     * recomputed from scratch.
+     */
+    bool canRefillIncrementally( ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer ) const;
+
+    /**
+     * @return a hash of what the fills depend on besides the board's items and zones: the
+     * rules, the netclasses and the design settings.
+     */
+    size_t fillSettingsHash() const;
+
+    /**
+     * @return how far from a changed item the fill of aZone can change: a clearance, a thermal
+     * relief and the pruning of features narrower than the minimum width.
+     */
+    int dirtyAreaMargin( const ZONE_CONTAINER* aZone ) const;
+
+    /**
+     * Works out the part of the fill of aZone which has to be recomputed because of the
+     * changes in aDirtyRects, and the larger window which has to be filled to recompute it
+     * exactly.  Both are unions of tiles so that nearby changes get merged.
+     * @return false if that's most of the zone, which is then better refilled entirely.
+     */
+    bool buildDirtyArea( const ZONE_CONTAINER* aZone, const std::vector<EDA_RECT>& aDirtyRects,
+                         SHAPE_POLY_SET& aDirtyArea, SHAPE_POLY_SET& aWindow ) const;
+
+    /**
+     * Recomputes aPreviousFill, the previous raw fill of aZone, inside aDirtyArea.  Gives the
+     * same aRawPolys and aFinalPolys as fillSingleZone().
+     * @param aItemClearances are the copper item clearances built over aWindow
+     * @param aWindow is the area to fill to get an exact result in aDirtyArea
+     */
+    bool refillDirtyArea( ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
+                          const SHAPE_POLY_SET& aItemClearances,
+                          const SHAPE_POLY_SET& aDirtyArea, const SHAPE_POLY_SET& aWindow,
+                          const SHAPE_POLY_SET& aPreviousFill, SHAPE_POLY_SET& aRawPolys,
+                          SHAPE_POLY_SET& aFinalPolys );
+
     /**
      * for zones having the ZONE_FILL_MODE::ZONE_FILL_MODE::HATCH_PATTERN, create a grid pattern
      * in filled areas of aZone, giving to the filled polygons a fill style like a grid
@@ -122,8 +183,12 @@ private:
 
     int                   m_maxError;
     int                   m_worstClearance;
+    int                   m_worstPadThermal;    // largest pad thermal gap + spoke width
+    size_t                m_fillSettingsHash;
 
     bool                  m_debugZoneFiller;
+    bool                  m_incremental;
+    int                   m_booleanThreads;     // threads for each tiled boolean op of a fill
 };
 
 #endif
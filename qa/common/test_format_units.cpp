@@ -26,7 +26,10 @@
 #include <base_units.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
+#include <vector>
 
 struct UnitFixture
 {
@@ -71,6 +74,82 @@ BOOST_AUTO_TEST_CASE( wxPointUnitFormat )
     BOOST_CHECK_EQUAL( strOddNeg, "-0.35 0" );
 #endif
 
+    // The buffer version writes the same text
+    char buf[2 * FMT_IU_BUFZ];
+    int  len = FormatInternalUnits( VECTOR2I( std::numeric_limits<int>::min(),
+                                              std::numeric_limits<int>::max() ), buf );
+
+    BOOST_CHECK_EQUAL( std::string( buf, len ), strMax );
+    BOOST_CHECK_EQUAL( buf[len], '\0' );
+}
+
+
+/**
+ * The formatting that FormatInternalUnits() and FormatAngle() used to do with snprintf(),
+ * which the files already written depend on.
+ */
+static std::string snprintfUnits( int aValue )
+{
+    char   buf[50];
+    double engUnits = aValue / IU_PER_MM;
+    int    len;
+
+    if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+    {
+        len = snprintf( buf, sizeof( buf ), "%.10f", engUnits );
+
+        while( --len > 0 && buf[len] == '0' )
+            buf[len] = '\0';
+
+        if( buf[len] == '.' )
+            buf[len] = '\0';
+        else
+            ++len;
+    }
+    else
+    {
+        len = snprintf( buf, sizeof( buf ), "%.10g", engUnits );
+    }
+
+    return std::string( buf, len );
+}
+
+
+static std::string snprintfAngle( double aAngle )
+{
+    char buf[50];
+    int  len = snprintf( buf, sizeof( buf ), "%.10g", aAngle / 10.0 );
+
+    return std::string( buf, len );
+}
+
+
+/**
+ * Check the formatting without snprintf() gives the same text, byte for byte
+ */
+BOOST_AUTO_TEST_CASE( SnprintfCompatibility )
+{
+    std::vector<int> values = { 0, 1, -1, 9, 10, 99, 100, 101, 999, 1000, 1001, 12345, -12345,
+                                100000, 1000000, 1234567, -1000001, 2147483647, -2147483647 - 1 };
+
+    for( int ii = 1; ii < 200000; ii += 7 )
+    {
+        values.push_back( ii * 13 );
+        values.push_back( -ii * 10 );
+        values.push_back( ii * 10007 );
+    }
+
+    for( int value : values )
+    {
+        char buf[FMT_IU_BUFZ];
+        int  len = FormatInternalUnits( value, buf );
+
+        BOOST_CHECK_EQUAL( std::string( buf, len ), snprintfUnits( value ) );
+        BOOST_CHECK_EQUAL( FormatAngle( (double) value ), snprintfAngle( value ) );
+    }
+
+    for( double angle : { 0.5, -0.5, 12.25, 450.0001, -0.0, 1e12, -1e-3 } )
+        BOOST_CHECK_EQUAL( FormatAngle( angle ), snprintfAngle( angle ) );
 }
 
 
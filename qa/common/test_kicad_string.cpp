@@ -28,6 +28,10 @@
 
 #include <unit_test_utils/unit_test_utils.h>
 
+#include <cerrno>
+#include <climits>
+#include <cmath>
+
 // Code under test
 #include <kicad_string.h>
 
@@ -107,4 +111,55 @@ BOOST_AUTO_TEST_CASE( NaturalNumberCompare )
     }
 }
 
+/**
+ * Test the #StrToDouble method against strtod() in the "C" locale.
+ */
+BOOST_AUTO_TEST_CASE( StringToDouble )
+{
+    const std::vector<std::string> cases = {
+        "0", "-0", "42", "-1.27", "+.5", "1.", "0.000001", "123.4567", "1e-05", "-2.5E3",
+        "1e", "1e+", "3.14159265358979323846", "12345678901234567890", "1e300", "4.9e-324",
+        "0.1x", " 7", ".", "-", "", "abc",
+    };
+
+    for( const std::string& c : cases )
+    {
+        char*       expectedEnd;
+        const char* end;
+        double      expected = strtod( c.c_str(), &expectedEnd );
+
+        BOOST_CHECK_EQUAL( StrToDouble( c.c_str(), &end ), expected );
+        BOOST_CHECK_MESSAGE( end == expectedEnd, "'" + c + "' wrong end" );
+    }
+
+    errno = 0;
+    BOOST_CHECK_EQUAL( StrToDouble( "-1e400", nullptr ), -HUGE_VAL );
+    BOOST_CHECK_EQUAL( errno, ERANGE );
+}
+
+/**
+ * Test the #StrToLong method against strtol() in the "C" locale.
+ */
+BOOST_AUTO_TEST_CASE( StringToLong )
+{
+    const std::vector<std::pair<std::string, int>> cases = {
+        { "0", 10 }, { "-42", 10 }, { "+7", 10 }, { "12a", 10 }, { "-", 10 }, { "", 10 },
+        { "ff", 16 }, { "0x1F", 16 }, { "0x", 16 }, { "7FFFFFFF", 16 }, { "g", 16 },
+    };
+
+    for( const auto& c : cases )
+    {
+        char*       expectedEnd;
+        const char* end;
+        long        expected = strtol( c.first.c_str(), &expectedEnd, c.second );
+
+        BOOST_CHECK_EQUAL( StrToLong( c.first.c_str(), &end, c.second ), expected );
+        BOOST_CHECK_MESSAGE( end == expectedEnd, "'" + c.first + "' wrong end" );
+    }
+
+    errno = 0;
+    BOOST_CHECK_EQUAL( StrToLong( "99999999999999999999", nullptr ), LONG_MAX );
+    BOOST_CHECK_EQUAL( errno, ERANGE );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
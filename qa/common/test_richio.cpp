@@ -0,0 +1,162 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <dsnlexer.h>
+#include <richio.h>
+
+#include <wx/filename.h>
+
+#include <fstream>
+#include <vector>
+
+
+struct RichioFixture
+{
+    ~RichioFixture()
+    {
+        for( const wxString& fileName : m_fileNames )
+            wxRemoveFile( fileName );
+    }
+
+    wxString writeFile( const std::string& aContents )
+    {
+        wxString fileName = wxFileName::CreateTempFileName( "richio" );
+
+        std::ofstream out( fileName.fn_str(), std::ios::binary );
+        out << aContents;
+
+        m_fileNames.push_back( fileName );
+        return fileName;
+    }
+
+    std::vector<wxString> m_fileNames;
+};
+
+
+static std::vector<std::string> readLines( LINE_READER& aReader )
+{
+    std::vector<std::string> lines;
+
+    while( aReader.ReadLine() )
+        lines.emplace_back( aReader.Line(), aReader.Length() );
+
+    return lines;
+}
+
+
+static std::vector<std::string> readLinesInPlace( LINE_READER& aReader )
+{
+    std::vector<std::string> lines;
+
+    while( const char* line = aReader.ReadLineInPlace() )
+        lines.emplace_back( line, aReader.Length() );
+
+    return lines;
+}
+
+
+static std::vector<std::string> lex( LINE_READER& aReader )
+{
+    DSNLEXER                 lexer( nullptr, 0, &aReader );
+    std::vector<std::string> tokens;
+
+    while( lexer.NextTok() != DSN_EOF )
+        tokens.push_back( lexer.CurStr() );
+
+    return tokens;
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( Richio, RichioFixture )
+
+
+/**
+ * The mapped reader gives the lines of the file, copied or in place
+ */
+BOOST_AUTO_TEST_CASE( MappedFileLines )
+{
+    const std::vector<std::string> contents = {
+        "",
+        "\n",
+        "(kicad_pcb (version 20201002)\n  (net 0 \"\")\n\n)\n",
+        "no newline at the end",
+        "crlf\r\nline endings\r\n",
+    };
+
+    for( const std::string& text : contents )
+    {
+        wxString                fileName = writeFile( text );
+        MAPPED_FILE_LINE_READER mappedReader( fileName );
+        MAPPED_FILE_LINE_READER inPlaceReader( fileName );
+        STRING_LINE_READER      stringReader( text, "test" );
+        STRING_LINE_READER      inPlaceStringReader( text, "test" );
+
+        // The file is read in binary mode, like a string
+        std::vector<std::string> expected = readLines( stringReader );
+
+        BOOST_CHECK( readLines( mappedReader ) == expected );
+        BOOST_CHECK( readLinesInPlace( inPlaceReader ) == expected );
+        BOOST_CHECK( readLinesInPlace( inPlaceStringReader ) == expected );
+        BOOST_CHECK_EQUAL( inPlaceReader.LineNumber(), stringReader.LineNumber() );
+    }
+}
+
+
+/**
+ * DSNLEXER gives the same tokens from lines read in place, and reports errors on them
+ */
+BOOST_AUTO_TEST_CASE( LexInPlace )
+{
+    const std::string text = "(module \"R_0805\" (layer F.Cu)\n"
+                             "  (fp_text value \"a \\\"quoted\\\" \\x41\\101\" (at 1.5 -2))\n"
+                             ")";
+
+    wxString                fileName = writeFile( text );
+    FILE_LINE_READER        fileReader( fileName );
+    MAPPED_FILE_LINE_READER mappedReader( fileName );
+
+    std::vector<std::string> tokens = lex( mappedReader );
+
+    BOOST_CHECK( tokens == lex( fileReader ) );
+    BOOST_CHECK_EQUAL( tokens[10], "a \"quoted\" AA" );
+
+    MAPPED_FILE_LINE_READER badReader( writeFile( "(a \"unterminated\n(b)\n" ) );
+    DSNLEXER                lexer( nullptr, 0, &badReader );
+
+    lexer.NextTok();
+    lexer.NextTok();
+
+    try
+    {
+        lexer.NextTok();
+        BOOST_ERROR( "no error on an unterminated string" );
+    }
+    catch( const PARSE_ERROR& error )
+    {
+        BOOST_CHECK_EQUAL( error.inputLine, "(a \"unterminated\n" );
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
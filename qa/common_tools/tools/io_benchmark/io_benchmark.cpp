@@ -22,6 +22,7 @@
  */
 
 #include <wx/wx.h>
+#include <dsnlexer.h>
 #include <richio.h>
 
 #include <chrono>
@@ -156,6 +157,73 @@ static void bench_line_reader_reuse( const wxFileName& aFile, int aReps, BENCH_R
 }
 
 
+/**
+ * Benchmark using a given LINE_READER implementation, taking the lines in place
+ * where the reader can.
+ * The LINE_READER is recreated for each cycle.
+ */
+template<typename LR>
+static void bench_line_reader_in_place( const wxFileName& aFile, int aReps,
+                                        BENCH_REPORT& report )
+{
+    for( int i = 0; i < aReps; ++i)
+    {
+        LR fstr( aFile.GetFullPath() );
+
+        while( const char* line = fstr.ReadLineInPlace() )
+        {
+            report.linesRead++;
+            report.charAcc += (unsigned char) line[0];
+        }
+    }
+}
+
+
+/**
+ * Benchmark the lexing of the file with a DSNLEXER, without keywords, over a given
+ * LINE_READER implementation.  The accumulator sums the first character of the tokens.
+ * The LINE_READER is recreated for each cycle.
+ */
+template<typename LR>
+static void bench_lexer( const wxFileName& aFile, int aReps, BENCH_REPORT& report )
+{
+    for( int i = 0; i < aReps; ++i)
+    {
+        LR       fstr( aFile.GetFullPath() );
+        DSNLEXER lexer( nullptr, 0, &fstr );
+
+        while( lexer.NextTok() != DSN_EOF )
+            report.charAcc += (unsigned char) lexer.CurText()[0];
+
+        // the last line number is one past the end of the file
+        report.linesRead += lexer.CurLineNumber() - 1;
+    }
+}
+
+
+/**
+ * STRING_LINE_READER over the file contents, read with std::ifstream, as a LINE_READER
+ * constructed from a file name.
+ */
+class FILE_STRING_LINE_READER : public STRING_LINE_READER
+{
+public:
+    FILE_STRING_LINE_READER( const wxString& aFileName ) :
+            STRING_LINE_READER( readFile( aFileName ), aFileName )
+    {
+    }
+
+private:
+    static std::string readFile( const wxString& aFileName )
+    {
+        std::ifstream ifs( aFileName.ToStdString() );
+
+        return std::string( ( std::istreambuf_iterator<char>( ifs ) ),
+                            std::istreambuf_iterator<char>() );
+    }
+};
+
+
 /**
  * Benchmark using STRING_LINE_READER on string data read into memory from a file
  * using std::ifstream, but read the data fresh from the file each time
@@ -314,6 +382,9 @@ static std::vector<BENCHMARK> benchmarkList =
     { 'R', bench_line_reader_reuse<FILE_LINE_READER>, "RichIO FILE_L_R, reused" },
     { 'n', bench_line_reader<IFSTREAM_LINE_READER>, "std::ifstream L_R" },
     { 'N', bench_line_reader_reuse<IFSTREAM_LINE_READER>, "std::ifstream L_R, reused" },
+    { 'm', bench_line_reader<MAPPED_FILE_LINE_READER>, "RichIO MAPPED_L_R" },
+    { 'M', bench_line_reader_reuse<MAPPED_FILE_LINE_READER>, "RichIO MAPPED_L_R, reused" },
+    { 'i', bench_line_reader_in_place<MAPPED_FILE_LINE_READER>, "RichIO MAPPED_L_R, in place" },
     { 's', bench_string_lr, "RichIO STRING_L_R"},
     { 'S', bench_string_lr_reuse, "RichIO STRING_L_R, reused"},
     { 'w', bench_wxis<wxFileInputStream>, "wxFileIStream" },
@@ -324,6 +395,9 @@ static std::vector<BENCHMARK> benchmarkList =
     { 'B', bench_wxbis_reuse<wxFileInputStream>, "wxFileIStream, buf'd, reused" },
     { 'c', bench_wxbis<wxFFileInputStream>, "wxFFileIStream. buf'd" },
     { 'C', bench_wxbis_reuse<wxFFileInputStream>, "wxFFileIStream, buf'd, reused" },
+    { 'x', bench_lexer<FILE_LINE_READER>, "DSNLEXER, FILE_L_R" },
+    { 'y', bench_lexer<FILE_STRING_LINE_READER>, "DSNLEXER, STRING_L_R" },
+    { 'z', bench_lexer<MAPPED_FILE_LINE_READER>, "DSNLEXER, MAPPED_L_R" },
 };
 
 
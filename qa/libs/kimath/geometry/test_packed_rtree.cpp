@@ -0,0 +1,184 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/packed_rtree.h>
+
+#include <climits>
+#include <random>
+#include <set>
+
+
+using TEST_TREE = PACKED_RTREE<int, 2>;
+
+
+struct PackedRTreeFixture
+{
+    PackedRTreeFixture()
+    {
+        std::mt19937 rng( 42 );
+
+        // Enough entries for a few levels, and not a multiple of the node size
+        for( int ii = 0; ii < 5000; ++ii )
+        {
+            TEST_TREE::ENTRY entry;
+
+            for( int dim = 0; dim < 2; ++dim )
+            {
+                entry.min[dim] = rng() % 1000000;
+                entry.max[dim] = entry.min[dim] + rng() % 10000;
+            }
+
+            entry.data = ii;
+            m_entries.push_back( entry );
+        }
+
+        std::vector<TEST_TREE::ENTRY> entries( m_entries );
+        m_tree.Build( entries );
+    }
+
+    std::set<int> search( const int aMin[2], const int aMax[2] ) const
+    {
+        std::set<int> found;
+
+        auto visitor =
+                [&]( int aData ) -> bool
+                {
+                    found.insert( aData );
+                    return true;
+                };
+
+        m_tree.Search( aMin, aMax, visitor );
+        return found;
+    }
+
+    std::set<int> bruteForce( const int aMin[2], const int aMax[2] ) const
+    {
+        std::set<int> found;
+
+        for( const TEST_TREE::ENTRY& entry : m_entries )
+        {
+            if( !m_removed.count( entry.data )
+                    && entry.min[0] <= aMax[0] && entry.max[0] >= aMin[0]
+                    && entry.min[1] <= aMax[1] && entry.max[1] >= aMin[1] )
+            {
+                found.insert( entry.data );
+            }
+        }
+
+        return found;
+    }
+
+    std::vector<TEST_TREE::ENTRY> m_entries;
+    std::set<int>                 m_removed;
+    TEST_TREE                     m_tree;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( PackedRTree, PackedRTreeFixture )
+
+
+/**
+ * Every entry should be found by a search of its own box.
+ */
+BOOST_AUTO_TEST_CASE( FindsAllEntries )
+{
+    BOOST_CHECK_EQUAL( m_tree.Size(), m_entries.size() );
+
+    for( const TEST_TREE::ENTRY& entry : m_entries )
+        BOOST_CHECK( search( entry.min, entry.max ).count( entry.data ) );
+}
+
+
+/**
+ * Searches should return the same entries as a linear scan.
+ */
+BOOST_AUTO_TEST_CASE( MatchesBruteForce )
+{
+    std::mt19937 rng( 7 );
+
+    for( int ii = 0; ii < 200; ++ii )
+    {
+        const int min[2] = { (int) ( rng() % 1000000 ), (int) ( rng() % 1000000 ) };
+        const int max[2] = { min[0] + (int) ( rng() % 50000 ), min[1] + (int) ( rng() % 50000 ) };
+
+        BOOST_CHECK( search( min, max ) == bruteForce( min, max ) );
+    }
+}
+
+
+/**
+ * Removed entries aren't returned any more, whether found through their box or not.
+ */
+BOOST_AUTO_TEST_CASE( Remove )
+{
+    for( size_t ii = 0; ii < m_entries.size(); ii += 3 )
+    {
+        const TEST_TREE::ENTRY& entry = m_entries[ii];
+
+        if( ii % 2 )
+            BOOST_CHECK( m_tree.Remove( entry.min, entry.max, entry.data ) );
+        else
+            BOOST_CHECK( m_tree.Remove( entry.data ) );
+
+        m_removed.insert( entry.data );
+    }
+
+    BOOST_CHECK( !m_tree.Remove( m_entries[0].data ) );
+    BOOST_CHECK_EQUAL( m_tree.Size(), m_entries.size() - m_removed.size() );
+    BOOST_CHECK_EQUAL( m_tree.RemovedCount(), m_removed.size() );
+
+    const int everywhere[2][2] = { { INT_MIN, INT_MIN }, { INT_MAX, INT_MAX } };
+
+    BOOST_CHECK( search( everywhere[0], everywhere[1] )
+                 == bruteForce( everywhere[0], everywhere[1] ) );
+
+    std::vector<TEST_TREE::ENTRY> remaining;
+    m_tree.GetEntries( remaining );
+
+    BOOST_CHECK_EQUAL( remaining.size(), m_tree.Size() );
+}
+
+
+/**
+ * The visitor can stop a search early.
+ */
+BOOST_AUTO_TEST_CASE( StopSearch )
+{
+    const int everywhere[2][2] = { { INT_MIN, INT_MIN }, { INT_MAX, INT_MAX } };
+    int       visited = 0;
+
+    auto visitor =
+            [&]( int aData ) -> bool
+            {
+                return ++visited < 10;
+            };
+
+    m_tree.Search( everywhere[0], everywhere[1], visitor );
+
+    BOOST_CHECK_EQUAL( visited, 10 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -25,6 +25,12 @@
 
 #include <pcbnew_utils/board_file_utils.h>
 
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <convert_to_biu.h>
+
 // For the temp directory logic: can be std::filesystem in C++17
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
@@ -50,4 +56,84 @@ void BOARD_DUMPER::DumpBoardToFile( BOARD& aBoard, const std::string& aName ) co
     ::KI_TEST::DumpBoardToFile( aBoard, path.string() );
 }
 
+
+wxPoint MmPoint( double aX, double aY )
+{
+    return wxPoint( Millimeter2iu( aX ), Millimeter2iu( aY ) );
+}
+
+
+NETINFO_ITEM* AddNet( BOARD& aBoard, const wxString& aName, int aNetCode )
+{
+    NETINFO_ITEM* net = new NETINFO_ITEM( &aBoard, aName, aNetCode );
+    aBoard.Add( net );
+    return net;
+}
+
+
+D_PAD* AddPad( MODULE& aModule, const wxPoint& aPos, int aSize, int aNetCode )
+{
+    D_PAD* pad = new D_PAD( &aModule );
+    pad->SetSize( wxSize( aSize, aSize ) );
+    pad->SetPosition( aPos );
+    pad->SetNetCode( aNetCode );
+    aModule.Add( pad );
+    return pad;
+}
+
+
+TRACK* AddTrack( BOARD& aBoard, const wxPoint& aStart, const wxPoint& aEnd, int aWidth,
+                 int aNetCode, PCB_LAYER_ID aLayer )
+{
+    TRACK* track = new TRACK( &aBoard );
+    track->SetStart( aStart );
+    track->SetEnd( aEnd );
+    track->SetWidth( aWidth );
+    track->SetLayer( aLayer );
+    track->SetNetCode( aNetCode );
+    aBoard.Add( track );
+    return track;
+}
+
+
+VIA* AddVia( BOARD& aBoard, const wxPoint& aPos, int aWidth, int aDrill, int aNetCode )
+{
+    VIA* via = new VIA( &aBoard );
+    via->SetPosition( aPos );
+    via->SetWidth( aWidth );
+    via->SetDrill( aDrill );
+    via->SetNetCode( aNetCode );
+    aBoard.Add( via );
+    return via;
+}
+
+
+BOARD_FIXTURE::BOARD_FIXTURE() :
+        m_board( std::make_unique<BOARD>() ),
+        m_trackWidth( Millimeter2iu( 0.25 ) )
+{
+}
+
+
+BOARD_FIXTURE::~BOARD_FIXTURE()
+{
+}
+
+
+MODULE* BOARD_FIXTURE::addModule( const wxString& aReference, const wxPoint& aPos )
+{
+    MODULE* module = new MODULE( m_board.get() );
+    module->SetReference( aReference );
+    module->SetPosition( aPos );
+    m_board->Add( module );
+    return module;
+}
+
+
+TRACK* BOARD_FIXTURE::addTrack( const wxPoint& aStart, const wxPoint& aEnd, int aNetCode,
+                                PCB_LAYER_ID aLayer )
+{
+    return AddTrack( *m_board, aStart, aEnd, m_trackWidth, aNetCode, aLayer );
+}
+
 } // namespace KI_TEST
\ No newline at end of file
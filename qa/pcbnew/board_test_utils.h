@@ -29,10 +29,20 @@
 #ifndef QA_PCBNEW_BOARD_TEST_UTILS__H
 #define QA_PCBNEW_BOARD_TEST_UTILS__H
 
+#include <memory>
 #include <string>
 
+#include <layers_id_colors_and_visibility.h>
+#include <wx/gdicmn.h>
+#include <wx/string.h>
+
 class BOARD;
 class BOARD_ITEM;
+class D_PAD;
+class MODULE;
+class NETINFO_ITEM;
+class TRACK;
+class VIA;
 
 
 namespace KI_TEST
@@ -58,6 +68,65 @@ public:
     const bool m_dump_boards;
 };
 
+
+/**
+ * @return the point at \a aX, \a aY millimeters, in internal units.
+ */
+wxPoint MmPoint( double aX, double aY );
+
+/**
+ * Add a net to a board.
+ * @return the new net.
+ */
+NETINFO_ITEM* AddNet( BOARD& aBoard, const wxString& aName, int aNetCode );
+
+/**
+ * Add a square SMD pad to a footprint.
+ * @param aPos    The position of the pad on the board
+ * @param aSize   The side of the pad
+ * @param aNetCode The net of the pad
+ * @return the new pad.
+ */
+D_PAD* AddPad( MODULE& aModule, const wxPoint& aPos, int aSize, int aNetCode = 0 );
+
+/**
+ * Add a track segment to a board.
+ * @return the new track.
+ */
+TRACK* AddTrack( BOARD& aBoard, const wxPoint& aStart, const wxPoint& aEnd, int aWidth,
+                 int aNetCode = 0, PCB_LAYER_ID aLayer = F_Cu );
+
+/**
+ * Add a through via to a board.
+ * @return the new via.
+ */
+VIA* AddVia( BOARD& aBoard, const wxPoint& aPos, int aWidth, int aDrill, int aNetCode = 0 );
+
+
+/**
+ * A base for the fixtures of tests on a small board built in code.
+ */
+struct BOARD_FIXTURE
+{
+    BOARD_FIXTURE();
+    ~BOARD_FIXTURE();
+
+    /**
+     * Add a footprint without pads to the board.
+     */
+    MODULE* addModule( const wxString& aReference = wxEmptyString,
+                       const wxPoint& aPos = wxPoint( 0, 0 ) );
+
+    /**
+     * Add a track segment of m_trackWidth to the board.
+     */
+    TRACK* addTrack( const wxPoint& aStart, const wxPoint& aEnd, int aNetCode = 0,
+                     PCB_LAYER_ID aLayer = F_Cu );
+
+    std::unique_ptr<BOARD> m_board;
+    int                    m_trackWidth;    ///< 0.25mm unless changed by the fixture
+};
+
 } // namespace KI_TEST
 
 #endif // QA_PCBNEW_BOARD_TEST_UTILS__H
\ No newline at end of file
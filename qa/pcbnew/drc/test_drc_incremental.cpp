@@ -0,0 +1,224 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <pcbnew_utils/board_construction_utils.h>
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <connectivity/connectivity_data.h>
+#include <drc/drc_item.h>
+#include <drc/drc_engine.h>
+
+#include "../board_test_utils.h"
+
+
+struct INCREMENTAL_DRC_FIXTURE : public KI_TEST::BOARD_FIXTURE
+{
+    INCREMENTAL_DRC_FIXTURE()
+    {
+        BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+
+        bds.m_DRCSeverities[ DRCE_OVERLAPPING_FOOTPRINTS ] = RPT_SEVERITY_ERROR;
+
+        m_u1 = addTestModule( "U1", { 0, 0 } );
+        m_u2 = addTestModule( "U2", KI_TEST::MmPoint( 1, 0 ) );
+        m_u3 = addTestModule( "U3", KI_TEST::MmPoint( 50, 0 ) );
+        m_u4 = addTestModule( "U4", KI_TEST::MmPoint( 51, 0 ) );
+
+        m_engine = std::make_unique<DRC_ENGINE>( m_board.get(), &bds );
+        m_engine->InitEngine( wxFileName() );
+
+        m_engine->SetViolationHandler(
+                [&]( const std::shared_ptr<DRC_ITEM>& aItem, wxPoint aPos )
+                {
+                    if( aItem->GetErrorCode() == DRCE_OVERLAPPING_FOOTPRINTS )
+                        m_overlaps.push_back( aItem );
+                    else if( aItem->GetErrorCode() == DRCE_UNCONNECTED_ITEMS )
+                        m_unconnected.push_back( aItem );
+                } );
+    }
+
+    /**
+     * Add a footprint with a 2mm square front courtyard to the board.
+     */
+    MODULE* addTestModule( const wxString& aRefdes, const VECTOR2I& aPos )
+    {
+        MODULE* module = addModule( aRefdes );
+
+        KI_TEST::DrawRect( *module, { 0, 0 }, { Millimeter2iu( 2 ), Millimeter2iu( 2 ) }, 0,
+                           Millimeter2iu( 0.1 ), F_CrtYd );
+
+        module->SetPosition( (wxPoint) aPos );
+        return module;
+    }
+
+    bool involves( const std::shared_ptr<DRC_ITEM>& aItem, const MODULE* aModule ) const
+    {
+        return aItem->GetMainItemID() == aModule->m_Uuid
+                || aItem->GetAuxItemID() == aModule->m_Uuid;
+    }
+
+    /// Move a footprint, marking it dirty the way BOARD_COMMIT::Push() does.
+    void move( MODULE* aModule, const VECTOR2I& aPos )
+    {
+        m_engine->MarkItemDirty( aModule );
+        aModule->SetPosition( (wxPoint) aPos );
+        m_engine->MarkItemDirty( aModule );
+    }
+
+    std::unique_ptr<DRC_ENGINE>            m_engine;
+    std::vector<std::shared_ptr<DRC_ITEM>> m_overlaps;
+    std::vector<std::shared_ptr<DRC_ITEM>> m_unconnected;
+
+    MODULE* m_u1;
+    MODULE* m_u2;
+    MODULE* m_u3;
+    MODULE* m_u4;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( DrcIncremental, INCREMENTAL_DRC_FIXTURE )
+
+
+/**
+ * Without a full run there are no markers to update.
+ */
+BOOST_AUTO_TEST_CASE( NeedsBaseline )
+{
+    BOOST_CHECK( !m_engine->CanRunIncrementally() );
+    BOOST_CHECK( !m_engine->RunIncrementalTests() );
+
+    m_engine->RunTests();
+
+    BOOST_CHECK_EQUAL( m_overlaps.size(), 2 );
+    BOOST_CHECK( m_engine->CanRunIncrementally() );
+}
+
+
+/**
+ * Only violations involving the moved footprint are reported again.
+ */
+BOOST_AUTO_TEST_CASE( OnlyDirtyItemsReported )
+{
+    m_engine->RunTests();
+    m_overlaps.clear();
+
+    // Move U2 away from U1: its violation is gone and U3/U4's isn't reported again
+    move( m_u2, KI_TEST::MmPoint( 20, 0 ) );
+
+    BOOST_CHECK( m_engine->IsDirtyItem( m_u2->m_Uuid ) );
+    BOOST_CHECK( !m_engine->IsDirtyItem( m_u3->m_Uuid ) );
+
+    BOOST_CHECK( m_engine->RunIncrementalTests() );
+    BOOST_CHECK_EQUAL( m_overlaps.size(), 0 );
+    BOOST_CHECK( !m_engine->IsDirtyItem( m_u2->m_Uuid ) );
+
+    // Now drop it onto U3
+    move( m_u2, KI_TEST::MmPoint( 48.5, 1 ) );
+
+    BOOST_CHECK( m_engine->RunIncrementalTests() );
+    BOOST_REQUIRE_EQUAL( m_overlaps.size(), 1 );
+    BOOST_CHECK( involves( m_overlaps[0], m_u2 ) );
+    BOOST_CHECK( involves( m_overlaps[0], m_u3 ) );
+}
+
+
+/**
+ * Rule and severity changes invalidate the markers of the last run; reloading the same rules
+ * doesn't.
+ */
+BOOST_AUTO_TEST_CASE( RuleReloadNeedsFullRun )
+{
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+
+    m_engine->RunTests();
+    m_engine->InitEngine( wxFileName() );
+
+    BOOST_CHECK( m_engine->CanRunIncrementally() );
+
+    bds.GetDefault()->SetClearance( bds.GetDefault()->GetClearance() + Millimeter2iu( 0.1 ) );
+    m_engine->InitEngine( wxFileName() );
+
+    BOOST_CHECK( !m_engine->CanRunIncrementally() );
+
+    m_engine->RunTests();
+    bds.m_DRCSeverities[ DRCE_OVERLAPPING_FOOTPRINTS ] = RPT_SEVERITY_WARNING;
+
+    BOOST_CHECK( !m_engine->CanRunIncrementally() );
+}
+
+
+/**
+ * The unconnected items are all reported again, from the ratsnest kept up to date by the
+ * commits.
+ */
+BOOST_AUTO_TEST_CASE( ReportsAllUnconnectedItems )
+{
+    KI_TEST::AddNet( *m_board, "N1", 1 );
+
+    D_PAD* pad1 = KI_TEST::AddPad( *m_u1, KI_TEST::MmPoint( 1, 1 ), Millimeter2iu( 0.5 ), 1 );
+    D_PAD* pad3 = KI_TEST::AddPad( *m_u3, KI_TEST::MmPoint( 51, 1 ), Millimeter2iu( 0.5 ), 1 );
+
+    m_board->BuildConnectivity();
+    m_engine->RunTests();
+
+    BOOST_CHECK_EQUAL( m_unconnected.size(), 1 );
+
+    // Neither pad is dirty, but the unconnected items are reported anyway
+    m_unconnected.clear();
+    move( m_u2, KI_TEST::MmPoint( 20, 0 ) );
+
+    BOOST_CHECK( m_engine->RunIncrementalTests() );
+    BOOST_CHECK_EQUAL( m_unconnected.size(), 1 );
+
+    // Connecting the pads heals it
+    TRACK* track = addTrack( pad1->GetPosition(), pad3->GetPosition(), 1 );
+
+    m_board->GetConnectivity()->Add( track );
+    m_board->GetConnectivity()->RecalculateRatsnest();
+    m_engine->MarkItemDirty( track );
+
+    m_unconnected.clear();
+
+    BOOST_CHECK( m_engine->RunIncrementalTests() );
+    BOOST_CHECK( m_unconnected.empty() );
+}
+
+
+/**
+ * Changes which weren't recorded leave the markers to the next full run.
+ */
+BOOST_AUTO_TEST_CASE( DiscardBaseline )
+{
+    m_engine->RunTests();
+    move( m_u2, KI_TEST::MmPoint( 20, 0 ) );
+    m_engine->DiscardBaseline();
+
+    BOOST_CHECK( !m_engine->CanRunIncrementally() );
+    BOOST_CHECK( !m_engine->HasDirtyItems() );
+    BOOST_CHECK( !m_engine->RunIncrementalTests() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+
+#include "board_test_utils.h"
+
+
+struct BOARD_ITEM_INDEX_FIXTURE : public KI_TEST::BOARD_FIXTURE
+{
+    BOARD_ITEM_INDEX_FIXTURE()
+    {
+        m_track = addTrack( KI_TEST::MmPoint( 0, 0 ), KI_TEST::MmPoint( 5, 0 ) );
+        m_module = addModule( "U1" );
+        m_pad = KI_TEST::AddPad( *m_module, KI_TEST::MmPoint( 0, 5 ), Millimeter2iu( 1 ) );
+    }
+
+    bool isDeleted( BOARD_ITEM* aItem )
+    {
+        return aItem && aItem->Type() == NOT_USED;
+    }
+
+    TRACK*  m_track;
+    MODULE* m_module;
+    D_PAD*  m_pad;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( BoardItemIndex, BOARD_ITEM_INDEX_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( FindsItemsAndFootprintChildren )
+{
+    BOOST_CHECK( m_board->GetItem( m_track->m_Uuid ) == m_track );
+    BOOST_CHECK( m_board->GetItem( m_module->m_Uuid ) == m_module );
+    BOOST_CHECK( m_board->GetItem( m_pad->m_Uuid ) == m_pad );
+    BOOST_CHECK( m_board->GetItem( m_module->Reference().m_Uuid ) == &m_module->Reference() );
+    BOOST_CHECK( m_board->GetItem( m_board->m_Uuid ) == m_board.get() );
+    BOOST_CHECK( m_board->GetItem( niluuid ) == nullptr );
+    BOOST_CHECK( isDeleted( m_board->GetItem( KIID() ) ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( FollowsAddAndRemove )
+{
+    D_PAD* pad = new D_PAD( m_module );
+    m_module->Add( pad );
+
+    BOOST_CHECK( m_board->IsCachedById( pad ) );
+    BOOST_CHECK( m_board->GetItem( pad->m_Uuid ) == pad );
+
+    KIID padId = pad->m_Uuid;
+    m_module->Remove( pad );
+    delete pad;
+
+    BOOST_CHECK( isDeleted( m_board->GetItem( padId ) ) );
+
+    KIID trackId = m_track->m_Uuid;
+    KIID childId = m_pad->m_Uuid;
+    m_board->Remove( m_track );
+    m_board->Remove( m_module );
+
+    BOOST_CHECK( isDeleted( m_board->GetItem( trackId ) ) );
+    BOOST_CHECK( isDeleted( m_board->GetItem( childId ) ) );
+
+    delete m_track;
+    delete m_module;
+}
+
+
+BOOST_AUTO_TEST_CASE( IgnoresFootprintCopies )
+{
+    // Copies keep the KIIDs of the original, but mustn't take over its entries
+    MODULE copy( *m_module );
+
+    BOOST_CHECK( !m_board->IsCachedById( &copy ) );
+    BOOST_CHECK( m_board->GetItem( m_pad->m_Uuid ) == m_pad );
+}
+
+
+BOOST_AUTO_TEST_CASE( FollowsFootprintAssignment )
+{
+    // Assignment replaces the children; the index must point at the new ones
+    MODULE copy( *m_module );
+    KIID   padId = m_pad->m_Uuid;
+
+    *m_module = copy;
+
+    D_PAD* newPad = m_module->Pads().front();
+
+    BOOST_CHECK( newPad != m_pad );
+    BOOST_CHECK( m_board->IsCachedById( m_module ) );
+    BOOST_CHECK( m_board->GetItem( padId ) == newPad );
+}
+
+
+BOOST_AUTO_TEST_CASE( FillItemMap )
+{
+    std::map<KIID, EDA_ITEM*> itemMap;
+    m_board->FillItemMap( itemMap );
+
+    BOOST_CHECK( itemMap.at( m_track->m_Uuid ) == m_track );
+    BOOST_CHECK( itemMap.at( m_pad->m_Uuid ) == m_pad );
+    BOOST_CHECK( itemMap.at( m_board->m_Uuid ) == m_board.get() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
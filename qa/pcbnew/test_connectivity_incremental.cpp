@@ -0,0 +1,112 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <connectivity/connectivity_data.h>
+
+#include "board_test_utils.h"
+
+
+struct INCREMENTAL_CONNECTIVITY_FIXTURE : public KI_TEST::BOARD_FIXTURE
+{
+    INCREMENTAL_CONNECTIVITY_FIXTURE()
+    {
+        KI_TEST::AddNet( *m_board, "A", 1 );
+        KI_TEST::AddNet( *m_board, "B", 2 );
+
+        MODULE* module = addModule();
+
+        // Two pads on each net, in two rows
+        for( int ii = 0; ii < 4; ++ii )
+        {
+            m_pads.push_back( KI_TEST::AddPad( *module,
+                                               KI_TEST::MmPoint( 10 * ( ii % 2 ), 5 * ( ii / 2 ) ),
+                                               Millimeter2iu( 1 ), 1 + ii / 2 ) );
+        }
+
+        m_track = addTrack( m_pads[0]->GetPosition(), m_pads[1]->GetPosition(), 1 );
+
+        m_board->BuildConnectivity();
+    }
+
+    /**
+     * Update the ratsnest incrementally and check it against one built from scratch.
+     */
+    void checkRatsnest( unsigned int aExpectedUnconnected )
+    {
+        m_board->GetConnectivity()->RecalculateRatsnest();
+
+        CONNECTIVITY_DATA reference;
+        reference.Build( m_board.get() );
+
+        BOOST_CHECK_EQUAL( m_board->GetConnectivity()->GetUnconnectedCount(),
+                           aExpectedUnconnected );
+        BOOST_CHECK_EQUAL( reference.GetUnconnectedCount(), aExpectedUnconnected );
+    }
+
+    std::vector<D_PAD*> m_pads;
+    TRACK*              m_track;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ConnectivityIncremental, INCREMENTAL_CONNECTIVITY_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( MoveTrack )
+{
+    BOOST_CHECK_EQUAL( m_board->GetConnectivity()->GetUnconnectedCount(), 1 );
+
+    // Disconnect net A
+    m_track->SetEnd( KI_TEST::MmPoint( 5, 0 ) );
+    m_board->GetConnectivity()->Update( m_track );
+
+    checkRatsnest( 2 );
+
+    // ... and connect it again
+    m_track->SetEnd( m_pads[1]->GetPosition() );
+    m_board->GetConnectivity()->Update( m_track );
+
+    checkRatsnest( 1 );
+}
+
+
+/**
+ * A new track without a net gets the net of the pads it connects, leaving the other nets alone.
+ */
+BOOST_AUTO_TEST_CASE( PropagateToNewTrack )
+{
+    TRACK* track = addTrack( m_pads[2]->GetPosition(), m_pads[3]->GetPosition(), 0 );
+    m_board->GetConnectivity()->Add( track );
+
+    checkRatsnest( 0 );
+
+    BOOST_CHECK_EQUAL( track->GetNetCode(), 2 );
+    BOOST_CHECK_EQUAL( m_track->GetNetCode(), 1 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,148 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <connectivity/connectivity_data.h>
+#include <connectivity/from_to_cache.h>
+
+#include "board_test_utils.h"
+
+
+struct FROM_TO_CACHE_FIXTURE : public KI_TEST::BOARD_FIXTURE
+{
+    FROM_TO_CACHE_FIXTURE()
+    {
+        m_trackWidth = Millimeter2iu( 0.2 );
+
+        KI_TEST::AddNet( *m_board, "A", 1 );
+
+        m_from = addPad( "U1", KI_TEST::MmPoint( 0, 0 ) );
+        m_to = addPad( "J1", KI_TEST::MmPoint( 10, 0 ) );
+
+        // U1-1 -> J1-1, and a stub off U1-1 that leads nowhere
+        m_path.push_back( addTrack( KI_TEST::MmPoint( 0, 0 ), KI_TEST::MmPoint( 5, 0 ), 1 ) );
+        m_path.push_back( addTrack( KI_TEST::MmPoint( 5, 0 ), KI_TEST::MmPoint( 10, 0 ), 1 ) );
+        m_stub = addTrack( KI_TEST::MmPoint( 0, 0.3 ), KI_TEST::MmPoint( 0, 5 ), 1 );
+
+        m_board->BuildConnectivity();
+    }
+
+    /// A footprint with a single pad "1" on net A
+    D_PAD* addPad( const wxString& aReference, const wxPoint& aPos )
+    {
+        D_PAD* pad = KI_TEST::AddPad( *addModule( aReference ), aPos, Millimeter2iu( 1 ), 1 );
+        pad->SetName( "1" );
+        return pad;
+    }
+
+    std::set<BOARD_CONNECTED_ITEM*> pathItems() const
+    {
+        std::set<BOARD_CONNECTED_ITEM*> items( m_path.begin(), m_path.end() );
+        items.insert( m_from );
+        items.insert( m_to );
+        return items;
+    }
+
+    D_PAD*              m_from;
+    D_PAD*              m_to;
+    std::vector<TRACK*> m_path;
+    TRACK*              m_stub;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( FromToCache, FROM_TO_CACHE_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( UniquePath )
+{
+    FROM_TO_CACHE cache;
+    cache.Rebuild( m_board.get() );
+
+    for( BOARD_CONNECTED_ITEM* item : pathItems() )
+        BOOST_CHECK( cache.IsOnFromToPath( item, "U1-1", "J1*" ) );
+
+    BOOST_CHECK( !cache.IsOnFromToPath( m_stub, "U1-1", "J1*" ) );
+    BOOST_CHECK( !cache.IsOnFromToPath( m_path[0], "U1-1", "X1" ) );
+
+    FROM_TO_CACHE::FT_PATH* path = cache.QueryFromToPath( pathItems() );
+
+    BOOST_REQUIRE( path );
+    BOOST_CHECK( path->from == m_from );
+    BOOST_CHECK( path->to == m_to );
+    BOOST_CHECK( path->isUnique );
+}
+
+
+/**
+ * With a detour around the direct route there is more than one path; the shortest is used.
+ */
+BOOST_AUTO_TEST_CASE( AmbiguousPath )
+{
+    std::vector<TRACK*> detour = {
+        addTrack( KI_TEST::MmPoint( 0, 0 ), KI_TEST::MmPoint( 0, -3 ), 1 ),
+        addTrack( KI_TEST::MmPoint( 0, -3 ), KI_TEST::MmPoint( 10, -3 ), 1 ),
+        addTrack( KI_TEST::MmPoint( 10, -3 ), KI_TEST::MmPoint( 10, 0 ), 1 )
+    };
+
+    m_board->BuildConnectivity();
+
+    FROM_TO_CACHE cache;
+    cache.Rebuild( m_board.get() );
+
+    BOOST_CHECK( cache.IsOnFromToPath( m_path[1], "U1", "J1" ) );
+    BOOST_CHECK( !cache.IsOnFromToPath( detour[1], "U1", "J1" ) );
+
+    FROM_TO_CACHE::FT_PATH* path = cache.QueryFromToPath( pathItems() );
+
+    BOOST_REQUIRE( path );
+    BOOST_CHECK( !path->isUnique );
+}
+
+
+
+/**
+ * Pairs resolved up front answer the same as those resolved on first use.
+ */
+BOOST_AUTO_TEST_CASE( PreparedPairs )
+{
+    FROM_TO_CACHE cache;
+    cache.Rebuild( m_board.get() );
+    cache.Prepare( { { "U1-1", "J1*" }, { "U1-1", "X1" } } );
+
+    for( BOARD_CONNECTED_ITEM* item : pathItems() )
+        BOOST_CHECK( cache.IsOnFromToPath( item, "U1-1", "J1*" ) );
+
+    BOOST_CHECK( !cache.IsOnFromToPath( m_stub, "U1-1", "J1*" ) );
+    BOOST_CHECK( !cache.IsOnFromToPath( m_path[0], "U1-1", "X1" ) );
+
+    // Pairs which weren't prepared are still resolved on demand
+    BOOST_CHECK( cache.IsOnFromToPath( m_path[0], "U1", "J1" ) );
+    BOOST_CHECK( cache.QueryFromToPath( pathItems() ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
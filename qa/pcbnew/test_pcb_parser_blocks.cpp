@@ -0,0 +1,273 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pcb_group.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <plugins/kicad/pcb_parser.h>
+#include <richio.h>
+
+#include <wx/log.h>
+
+
+/**
+ * Footprints, tracks and zones are parsed on worker threads once there are enough of them,
+ * so the boards here have a few hundred.
+ */
+static const int ITEM_COUNT = 300;
+
+
+static std::string boardText( const std::string& aItems )
+{
+    return "(kicad_pcb (version 20201002) (generator pcbnew)\n"
+           "  (net 0 \"\")\n"
+           "  (net 1 \"A\")\n"
+           + aItems + ")\n";
+}
+
+
+static std::unique_ptr<BOARD> parseBoard( const std::string& aText, bool aDeferZoneFills = false )
+{
+    STRING_LINE_READER reader( aText, "test" );
+    PCB_PARSER         parser( &reader );
+
+    parser.SetDeferZoneFills( aDeferZoneFills );
+
+    return std::unique_ptr<BOARD>( static_cast<BOARD*>( parser.Parse() ) );
+}
+
+
+static std::string segment( int aX, const std::string& aExtra = "" )
+{
+    return "  (segment (start " + std::to_string( aX ) + " 0) (end " + std::to_string( aX )
+           + " 1) (width 0.25) (layer F.Cu) (net 1)" + aExtra + ")\n";
+}
+
+
+BOOST_AUTO_TEST_SUITE( PcbParserBlocks )
+
+
+/**
+ * The items are added to the board in file order, with what follows them
+ */
+BOOST_AUTO_TEST_CASE( FileOrder )
+{
+    std::string items;
+
+    for( int ii = 0; ii < ITEM_COUNT; ++ii )
+    {
+        items += "  (module \"R_" + std::to_string( ii ) + "\" (layer F.Cu) (at "
+                 + std::to_string( ii ) + " 0))\n";
+    }
+
+    items += "  (gr_line (start 0 0) (end 10 0) (layer Edge.Cuts) (width 0.1))\n";
+
+    for( int ii = 0; ii < ITEM_COUNT; ++ii )
+    {
+        if( ii % 2 )
+            items += "  (via (at " + std::to_string( ii ) + " 0) (size 0.8) (drill 0.4) "
+                     "(layers F.Cu B.Cu) (net 1))\n";
+        else if( ii == 10 )
+            items += segment( ii, " (tstamp 00000000-0000-0000-0000-000000000001)" );
+        else if( ii == 20 )
+            items += segment( ii, " (tstamp 00000000-0000-0000-0000-000000000002)" );
+        else
+            items += segment( ii );
+    }
+
+    items += "  (group \"G\" (id 00000000-0000-0000-0000-000000000003)\n"
+             "    (members\n"
+             "      00000000-0000-0000-0000-000000000001\n"
+             "      00000000-0000-0000-0000-000000000002\n"
+             "    )\n"
+             "  )\n";
+
+    std::unique_ptr<BOARD> board = parseBoard( boardText( items ) );
+
+    BOOST_REQUIRE_EQUAL( board->Modules().size(), (size_t) ITEM_COUNT );
+    BOOST_REQUIRE_EQUAL( board->Tracks().size(), (size_t) ITEM_COUNT );
+    BOOST_CHECK_EQUAL( board->Drawings().size(), 1u );
+
+    int ii = 0;
+
+    for( MODULE* module : board->Modules() )
+    {
+        BOOST_CHECK_EQUAL( module->GetPosition().x, Millimeter2iu( ii ) );
+        BOOST_CHECK_EQUAL( std::string( module->GetFPID().GetLibItemName().c_str() ),
+                           "R_" + std::to_string( ii ) );
+        ++ii;
+    }
+
+    ii = 0;
+
+    for( TRACK* track : board->Tracks() )
+    {
+        BOOST_CHECK_EQUAL( track->Type(), ii % 2 ? PCB_VIA_T : PCB_TRACE_T );
+        BOOST_CHECK_EQUAL( track->GetStart().x, Millimeter2iu( ii ) );
+        BOOST_CHECK_EQUAL( track->GetNetCode(), 1 );
+        ++ii;
+    }
+
+    BOOST_REQUIRE_EQUAL( board->Groups().size(), 1u );
+    BOOST_CHECK_EQUAL( board->Groups().front()->GetItems().size(), 2u );
+}
+
+
+/**
+ * The first error in the file is the one reported, at its place in the file
+ */
+BOOST_AUTO_TEST_CASE( FirstError )
+{
+    const std::string badLine = "  (segment (start 0 0) (bogus 1) (layer F.Cu) (net 1))\n";
+    std::string       items;
+
+    for( int ii = 0; ii < ITEM_COUNT; ++ii )
+        items += ii == 200 ? badLine : segment( ii );
+
+    items += "  (bad_token)\n";
+
+    try
+    {
+        parseBoard( boardText( items ) );
+        BOOST_ERROR( "no error for a bad segment" );
+    }
+    catch( const PARSE_ERROR& error )
+    {
+        // After the header and the two nets
+        BOOST_CHECK_EQUAL( error.lineNumber, 3 + 200 + 1 );
+        BOOST_CHECK_EQUAL( error.byteIndex, (int) badLine.find( "bogus" ) + 1 );
+
+        // The text before the keyword is not kept, only its length
+        BOOST_CHECK_EQUAL( error.inputLine.substr( 3 ), badLine.substr( 3 ) );
+    }
+
+    // A board that ends within an item
+    try
+    {
+        parseBoard( "(kicad_pcb (version 20201002) (generator pcbnew)\n"
+                    "  (segment (start 0 0) (end 1 1)\n" );
+        BOOST_ERROR( "no error for a truncated board" );
+    }
+    catch( const PARSE_ERROR& error )
+    {
+        BOOST_CHECK_EQUAL( error.lineNumber, 2 );
+    }
+}
+
+
+/**
+ * Zone fills left to parse when used are the same as those parsed with the board
+ */
+BOOST_AUTO_TEST_CASE( DeferredZoneFills )
+{
+    std::string items;
+
+    for( int ii = 0; ii < ITEM_COUNT; ++ii )
+    {
+        std::string x0 = std::to_string( ii * 20 );
+        std::string x1 = std::to_string( ii * 20 + 10 );
+
+        items += "  (zone (net 1) (net_name \"A\") (layers F.Cu B.Cu) (hatch edge 0.508)\n"
+                 "    (connect_pads (clearance 0.5)) (min_thickness 0.25)\n"
+                 "    (fill yes (thermal_gap 0.5) (thermal_bridge_width 0.5))\n"
+                 "    (polygon (pts (xy " + x0 + " 0) (xy " + x1 + " 0) (xy " + x1 + " 10)"
+                 " (xy " + x0 + " 10)))\n"
+                 "    (filled_polygon (layer F.Cu)\n"
+                 "      (pts\n"
+                 "        (xy " + x0 + " 0) (xy " + x1 + " 0)\n"
+                 "        (xy " + x1 + " 10) (xy " + x0 + " 10)\n"
+                 "      )\n"
+                 "    )\n"
+                 "    (filled_polygon (layer B.Cu) (island)\n"
+                 "      (pts (xy " + x0 + " 0) (xy " + x1 + " 0) (xy " + x1 + " 5)))\n"
+                 "    (filled_polygon (layer B.Cu)\n"
+                 "      (pts (xy " + x0 + " 5) (xy " + x1 + " 5) (xy " + x1 + " 10)))\n"
+                 "  )\n";
+    }
+
+    std::unique_ptr<BOARD> board = parseBoard( boardText( items ) );
+    std::unique_ptr<BOARD> deferred = parseBoard( boardText( items ), true );
+
+    BOOST_REQUIRE_EQUAL( board->Zones().size(), (size_t) ITEM_COUNT );
+    BOOST_REQUIRE_EQUAL( deferred->Zones().size(), (size_t) ITEM_COUNT );
+
+    for( size_t ii = 0; ii < board->Zones().size(); ++ii )
+    {
+        ZONE_CONTAINER* zone = board->Zones()[ii];
+        ZONE_CONTAINER* deferredZone = deferred->Zones()[ii];
+
+        BOOST_CHECK_EQUAL( deferredZone->GetFilledArea(), zone->GetFilledArea() );
+
+        for( PCB_LAYER_ID layer : { F_Cu, B_Cu } )
+        {
+            const SHAPE_POLY_SET& polys = zone->GetFilledPolysList( layer );
+            const SHAPE_POLY_SET& deferredPolys = deferredZone->GetFilledPolysList( layer );
+
+            BOOST_REQUIRE_EQUAL( deferredPolys.OutlineCount(), polys.OutlineCount() );
+
+            for( int jj = 0; jj < polys.OutlineCount(); ++jj )
+            {
+                BOOST_CHECK( deferredPolys.COutline( jj ).CPoints()
+                             == polys.COutline( jj ).CPoints() );
+                BOOST_CHECK_EQUAL( deferredZone->IsIsland( layer, jj ),
+                                   zone->IsIsland( layer, jj ) );
+            }
+        }
+    }
+
+    BOOST_CHECK_EQUAL( board->Zones()[0]->GetFilledPolysList( B_Cu ).OutlineCount(), 2 );
+    BOOST_CHECK( board->Zones()[0]->IsIsland( B_Cu, 0 ) );
+}
+
+
+/**
+ * A zone fill which turns out to be unreadable when used leaves the zone unfilled and in need
+ * of a refill, so that saving the board doesn't drop the fill without notice.
+ */
+BOOST_AUTO_TEST_CASE( DeferredZoneFillError )
+{
+    std::string items = "  (zone (net 1) (net_name \"A\") (layer F.Cu) (hatch edge 0.508)\n"
+                        "    (connect_pads (clearance 0.5)) (min_thickness 0.25)\n"
+                        "    (fill yes (thermal_gap 0.5) (thermal_bridge_width 0.5))\n"
+                        "    (polygon (pts (xy 0 0) (xy 10 0) (xy 10 10) (xy 0 10)))\n"
+                        "    (filled_polygon (layer F.Cu)\n"
+                        "      (pts (xy 0 0) (xy 10 0) (xy 10 zz) (xy 0 10)))\n"
+                        "  )\n";
+
+    wxLogNull              noErrorDialog;
+    std::unique_ptr<BOARD> board = parseBoard( boardText( items ), true );
+
+    BOOST_REQUIRE_EQUAL( board->Zones().size(), (size_t) 1 );
+
+    ZONE_CONTAINER* zone = board->Zones()[0];
+
+    BOOST_CHECK( !zone->IsFilled() );
+    BOOST_CHECK( zone->NeedRefill() );
+    BOOST_CHECK( zone->GetFilledPolysList( F_Cu ).IsEmpty() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
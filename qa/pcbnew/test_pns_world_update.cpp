@@ -0,0 +1,163 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <pcb_shape.h>
+
+#include <router/pns_kicad_iface.h>
+#include <router/pns_node.h>
+
+#include "board_test_utils.h"
+
+
+struct PNS_WORLD_UPDATE_FIXTURE : public KI_TEST::BOARD_FIXTURE
+{
+    PNS_WORLD_UPDATE_FIXTURE()
+    {
+        for( int ii = 0; ii < 3; ++ii )
+            m_tracks.push_back( addTrackRow( ii ) );
+
+        m_module = addModule();
+
+        KI_TEST::AddPad( *m_module, wxPoint( 0, 0 ), Millimeter2iu( 1 ) );
+
+        m_iface.SetBoard( m_board.get() );
+        m_iface.SyncWorld( &m_world );
+    }
+
+    /// A horizontal track, one of a column of them
+    TRACK* addTrackRow( int aRow )
+    {
+        return addTrack( KI_TEST::MmPoint( 0, 2 * aRow + 2 ), KI_TEST::MmPoint( 10, 2 * aRow + 2 ) );
+    }
+
+    /**
+     * @return the (kind, parent) pairs of the items of aWorld, sorted.
+     */
+    std::vector<std::pair<int, const BOARD_ITEM*>> contents( PNS::NODE* aWorld )
+    {
+        std::vector<PNS::ITEM*>                         items;
+        std::vector<std::pair<int, const BOARD_ITEM*>> result;
+
+        aWorld->AllItems( items );
+
+        for( PNS::ITEM* item : items )
+            result.emplace_back( item->Kind(), item->Parent() );
+
+        std::sort( result.begin(), result.end() );
+        return result;
+    }
+
+    /**
+     * Patch the world and check it against one built from scratch.
+     */
+    void checkUpdate()
+    {
+        BOOST_REQUIRE( m_iface.UpdateWorld( &m_world ) );
+
+        PNS_KICAD_IFACE_BASE reference;
+        PNS::NODE            referenceWorld;
+
+        reference.SetBoard( m_board.get() );
+        reference.SyncWorld( &referenceWorld );
+
+        BOOST_CHECK( contents( &m_world ) == contents( &referenceWorld ) );
+    }
+
+    std::vector<TRACK*>  m_tracks;
+    MODULE*              m_module;
+    PNS_KICAD_IFACE_BASE m_iface;
+    PNS::NODE            m_world;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( PnsWorldUpdate, PNS_WORLD_UPDATE_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( AddRemoveModify )
+{
+    addTrackRow( 5 );
+
+    m_board->Remove( m_tracks[0] );
+    delete m_tracks[0];
+
+    m_tracks[1]->SetLayer( B_Cu );
+    m_board->OnItemChanged( m_tracks[1] );
+
+    checkUpdate();
+}
+
+
+BOOST_AUTO_TEST_CASE( FootprintChanges )
+{
+    KI_TEST::AddPad( *m_module, KI_TEST::MmPoint( 3, 0 ), Millimeter2iu( 1 ) );
+    m_board->OnItemChanged( m_module );
+
+    checkUpdate();
+
+    m_board->Remove( m_module );
+    delete m_module;
+
+    checkUpdate();
+}
+
+
+BOOST_AUTO_TEST_CASE( OutlineChangeNeedsResync )
+{
+    PCB_SHAPE* edge = new PCB_SHAPE( m_board.get() );
+    edge->SetStart( wxPoint( 0, 0 ) );
+    edge->SetEnd( KI_TEST::MmPoint( 20, 0 ) );
+    edge->SetLayer( Edge_Cuts );
+    m_board->Add( edge );
+
+    BOOST_CHECK( !m_iface.UpdateWorld( &m_world ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( StaleSerial )
+{
+    m_board->ResetChangeLog();
+
+    BOOST_CHECK( !m_iface.UpdateWorld( &m_world ) );
+}
+
+
+/**
+ * Property changes made without a commit (as by a script) aren't logged; once they've been
+ * reported as untracked, the world is rebuilt rather than patched.
+ */
+BOOST_AUTO_TEST_CASE( UntrackedChangeNeedsResync )
+{
+    m_tracks[1]->SetLayer( B_Cu );
+    m_tracks[2]->SetWidth( Millimeter2iu( 1 ) );
+    m_board->OnUntrackedChanges();
+
+    BOOST_CHECK( !m_iface.UpdateWorld( &m_world ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,183 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <connectivity/connectivity_data.h>
+#include <ratsnest/ratsnest_data.h>
+
+#include <future>
+
+#include "board_test_utils.h"
+
+
+struct INCREMENTAL_RATSNEST_FIXTURE : public KI_TEST::BOARD_FIXTURE
+{
+    static const int GRID = 16;
+
+    INCREMENTAL_RATSNEST_FIXTURE()
+    {
+        KI_TEST::AddNet( *m_board, "GND", 1 );
+
+        MODULE* module = addModule();
+
+        // A grid of pads, all on one net: plenty of cocircular and collinear anchors
+        for( int ii = 0; ii < GRID * GRID; ++ii )
+        {
+            m_pads.push_back( KI_TEST::AddPad( *module, gridPoint( ii % GRID, ii / GRID ),
+                                               Millimeter2iu( 0.5 ), 1 ) );
+        }
+
+        m_board->BuildConnectivity();
+    }
+
+    static wxPoint gridPoint( int aX, int aY )
+    {
+        return KI_TEST::MmPoint( 2.54 * aX, 2.54 * aY );
+    }
+
+    static uint64_t ratsnestLength( RN_NET* aNet )
+    {
+        uint64_t length = 0;
+
+        for( const CN_EDGE& edge : aNet->GetEdges() )
+            length += edge.GetWeight();
+
+        return length;
+    }
+
+    void movePad( D_PAD* aPad, const wxPoint& aPos )
+    {
+        aPad->SetPosition( aPos );
+        m_board->GetConnectivity()->Update( aPad );
+    }
+
+    /**
+     * Update the ratsnest incrementally and check it against one built from scratch.
+     * @param aIncremental tells whether the update must have edited the triangulation.
+     */
+    void checkRatsnest( bool aIncremental = true )
+    {
+        RN_NET*  net = m_board->GetConnectivity()->GetRatsnestForNet( 1 );
+        unsigned incrementalUpdates = net->GetIncrementalUpdateCount();
+
+        m_board->GetConnectivity()->RecalculateRatsnest();
+
+        if( aIncremental )
+            BOOST_CHECK_EQUAL( net->GetIncrementalUpdateCount(), incrementalUpdates + 1 );
+
+        CONNECTIVITY_DATA reference;
+        reference.Build( m_board.get() );
+
+        RN_NET* expected = reference.GetRatsnestForNet( 1 );
+
+        // Minimum spanning trees may differ, but not in their size and total length
+        BOOST_CHECK_EQUAL( net->GetEdges().size(), expected->GetEdges().size() );
+        BOOST_CHECK_EQUAL( ratsnestLength( net ), ratsnestLength( expected ) );
+    }
+
+    std::vector<D_PAD*> m_pads;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( RatsnestIncremental, INCREMENTAL_RATSNEST_FIXTURE )
+
+
+/**
+ * Pads moving one at a time: inside the grid, on top of other pads and off the hull.
+ */
+BOOST_AUTO_TEST_CASE( MovePads )
+{
+    // Nothing moved yet
+    checkRatsnest( false );
+
+    for( int step = 0; step < 40; ++step )
+    {
+        D_PAD* pad = m_pads[( step * 37 ) % m_pads.size()];
+
+        if( step % 4 == 0 )
+            movePad( pad, gridPoint( ( step * 7 ) % GRID, ( step * 11 ) % GRID ) );
+        else if( step % 4 == 1 )
+            movePad( pad, gridPoint( GRID + step % 3, step % GRID ) );
+        else
+            movePad( pad, pad->GetPosition() + KI_TEST::MmPoint( 0.3 * step, 0 ) );
+
+        checkRatsnest();
+    }
+}
+
+
+/**
+ * Moving a corner of the grid changes the convex hull of the anchors.
+ */
+BOOST_AUTO_TEST_CASE( MoveHullPad )
+{
+    D_PAD* corner = m_pads[0];
+
+    movePad( corner, gridPoint( -5, -5 ) );
+    checkRatsnest();
+
+    movePad( corner, gridPoint( 1, 1 ) + KI_TEST::MmPoint( 1, 0 ) );
+    checkRatsnest();
+
+    movePad( corner, gridPoint( 0, 0 ) );
+    checkRatsnest();
+}
+
+
+/**
+ * The dynamic ratsnest of a moving pad, from the worker thread.
+ */
+BOOST_AUTO_TEST_CASE( DynamicRatsnest )
+{
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    std::vector<BOARD_ITEM*>           items = { m_pads[0] };
+    CONNECTIVITY_DATA                  dynamicData( items, true );
+    std::promise<void>                 done;
+
+    // Drop the pad next to the pad at (5, 5)
+    VECTOR2I delta = gridPoint( 5, 5 ) + KI_TEST::MmPoint( 1, 0 );
+
+    connectivity->BlockRatsnestItems( items );
+    dynamicData.Move( delta );
+    connectivity->ComputeDynamicRatsnest( items, &dynamicData, [&]() { done.set_value(); } );
+
+    BOOST_REQUIRE( done.get_future().wait_for( std::chrono::seconds( 10 ) )
+                   == std::future_status::ready );
+
+    const std::vector<RN_DYNAMIC_LINE>& lines = connectivity->GetDynamicRatsnest();
+
+    BOOST_REQUIRE_EQUAL( lines.size(), 1 );
+    BOOST_CHECK_EQUAL( lines[0].netCode, 1 );
+    BOOST_CHECK_EQUAL( lines[0].a, VECTOR2I( m_pads[0]->GetPosition() ) + delta );
+    BOOST_CHECK_EQUAL( lines[0].b, VECTOR2I( gridPoint( 5, 5 ) ) );
+
+    connectivity->ClearDynamicRatsnest();
+
+    BOOST_CHECK( connectivity->GetDynamicRatsnest().empty() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
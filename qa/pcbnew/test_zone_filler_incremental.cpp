@@ -0,0 +1,232 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <class_board.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <pcb_shape.h>
+#include <drc/drc_engine.h>
+#include <zone_filler.h>
+
+#include "board_test_utils.h"
+
+
+/**
+ * @return the area of a fractured (hole-less) polygon set.
+ */
+static double polysArea( const SHAPE_POLY_SET& aPolys )
+{
+    double area = 0.0;
+
+    for( int ii = 0; ii < aPolys.OutlineCount(); ++ii )
+        area += std::abs( aPolys.COutline( ii ).Area() );
+
+    return area;
+}
+
+
+struct INCREMENTAL_ZONE_FILL_FIXTURE : public KI_TEST::BOARD_FIXTURE
+{
+    INCREMENTAL_ZONE_FILL_FIXTURE()
+    {
+        BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+
+        bds.m_DRCEngine = std::make_shared<DRC_ENGINE>( m_board.get(), &bds );
+        bds.m_DRCEngine->InitEngine( wxFileName() );
+
+        PCB_SHAPE* edge = new PCB_SHAPE( m_board.get() );
+        edge->SetShape( S_RECT );
+        edge->SetStart( KI_TEST::MmPoint( -5, -5 ) );
+        edge->SetEnd( KI_TEST::MmPoint( 65, 45 ) );
+        edge->SetWidth( Millimeter2iu( 0.1 ) );
+        edge->SetLayer( Edge_Cuts );
+        m_board->Add( edge );
+
+        m_zone = new ZONE_CONTAINER( m_board.get() );
+        m_zone->SetLayer( F_Cu );
+        m_zone->SetMinThickness( Millimeter2iu( 0.25 ) );
+        m_zone->SetIslandRemovalMode( ISLAND_REMOVAL_MODE::NEVER );
+        m_zone->Outline()->NewOutline();
+        m_zone->Outline()->Append( 0, 0 );
+        m_zone->Outline()->Append( Millimeter2iu( 60 ), 0 );
+        m_zone->Outline()->Append( Millimeter2iu( 60 ), Millimeter2iu( 40 ) );
+        m_zone->Outline()->Append( 0, Millimeter2iu( 40 ) );
+        m_board->Add( m_zone );
+
+        // A few vias, and a track between two of them
+        for( int ii = 0; ii < 4; ++ii )
+        {
+            m_vias.push_back( KI_TEST::AddVia( *m_board, KI_TEST::MmPoint( 10 + 12 * ii, 20 ),
+                                               Millimeter2iu( 0.8 ), Millimeter2iu( 0.4 ) ) );
+        }
+
+        addTrack( m_vias[2]->GetPosition(), m_vias[3]->GetPosition() );
+
+        m_board->BuildConnectivity();
+    }
+
+    bool fill( bool aIncremental )
+    {
+        std::vector<ZONE_CONTAINER*> zones = { m_zone };
+        ZONE_FILLER                  filler( m_board.get(), nullptr );
+
+        filler.SetIncremental( aIncremental );
+        return filler.Fill( zones );
+    }
+
+    /// Move a via, marking the fills dirty the way BOARD_COMMIT::Push() does.
+    void move( VIA* aVia, const wxPoint& aPos )
+    {
+        m_board->MarkZoneFillsDirty( aVia );
+        aVia->SetPosition( aPos );
+        m_board->MarkZoneFillsDirty( aVia );
+    }
+
+    ZONE_CONTAINER*   m_zone;
+    std::vector<VIA*> m_vias;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ZoneFillerIncremental, INCREMENTAL_ZONE_FILL_FIXTURE )
+
+
+/**
+ * Copper changes mark the zones as partially dirty, board outline changes as entirely dirty.
+ */
+BOOST_AUTO_TEST_CASE( MarkDirty )
+{
+    BOOST_REQUIRE( fill( false ) );
+    BOOST_CHECK( !m_zone->NeedRefill() );
+    BOOST_CHECK( m_zone->GetFillDirtyAreas().empty() );
+
+    move( m_vias[0], KI_TEST::MmPoint( 10, 25 ) );
+
+    BOOST_CHECK( !m_zone->NeedRefill() );
+    BOOST_CHECK_EQUAL( m_zone->GetFillDirtyAreas().size(), 2 );
+
+    PCB_SHAPE* edge = static_cast<PCB_SHAPE*>( m_board->Drawings().front() );
+    m_board->MarkZoneFillsDirty( edge );
+
+    BOOST_CHECK( m_zone->NeedRefill() );
+}
+
+
+/**
+ * Patching the fill around the moved items gives the same result as refilling the whole zone.
+ */
+BOOST_AUTO_TEST_CASE( MatchesFullFill )
+{
+    BOOST_REQUIRE( fill( false ) );
+
+    move( m_vias[0], KI_TEST::MmPoint( 12, 24 ) );
+    move( m_vias[3], KI_TEST::MmPoint( 50, 30 ) );
+
+    BOOST_REQUIRE( fill( true ) );
+    BOOST_CHECK( m_zone->GetFillDirtyAreas().empty() );
+
+    SHAPE_POLY_SET patched = m_zone->GetFilledPolysList( F_Cu );
+    SHAPE_POLY_SET patchedRaw = m_zone->RawPolysList( F_Cu );
+
+    m_zone->SetNeedRefill( true );
+    BOOST_REQUIRE( fill( false ) );
+
+    SHAPE_POLY_SET full = m_zone->GetFilledPolysList( F_Cu );
+    SHAPE_POLY_SET extra = patched;
+    SHAPE_POLY_SET missing = full;
+
+    extra.BooleanSubtract( full, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    missing.BooleanSubtract( patched, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    extra.Fracture( SHAPE_POLY_SET::PM_FAST );
+    missing.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    // Allow for the rounding of the seams between the patch and the previous fill
+    const double tolerance = 1e-6 * polysArea( full );
+
+    BOOST_CHECK_LT( polysArea( extra ), tolerance );
+    BOOST_CHECK_LT( polysArea( missing ), tolerance );
+
+    // The raw fill is fractured and kept whole, as by a full fill
+    for( int ii = 0; ii < patchedRaw.OutlineCount(); ++ii )
+        BOOST_CHECK_EQUAL( patchedRaw.HoleCount( ii ), 0 );
+
+    BOOST_CHECK_CLOSE( polysArea( patchedRaw ), polysArea( full ), 1e-4 );
+}
+
+
+/**
+ * Rule changes don't mark anything dirty, but the fills made with the old rules are refilled
+ * entirely rather than patched.
+ */
+BOOST_AUTO_TEST_CASE( RulesChange )
+{
+    BOOST_REQUIRE( fill( false ) );
+
+    double oldArea = polysArea( m_zone->GetFilledPolysList( F_Cu ) );
+
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    bds.GetDefault()->SetClearance( bds.GetDefault()->GetClearance() + Millimeter2iu( 1 ) );
+    bds.m_DRCEngine->InitEngine( wxFileName() );
+
+    BOOST_CHECK( m_zone->GetFillDirtyAreas().empty() );
+    BOOST_REQUIRE( fill( true ) );
+
+    double newArea = polysArea( m_zone->GetFilledPolysList( F_Cu ) );
+
+    BOOST_CHECK_LT( newArea, oldArea );
+
+    m_zone->SetNeedRefill( true );
+    BOOST_REQUIRE( fill( false ) );
+
+    BOOST_CHECK_CLOSE( polysArea( m_zone->GetFilledPolysList( F_Cu ) ), newArea, 1e-6 );
+}
+
+
+/**
+ * Edits made without marking anything dirty (as by a script) don't leave stale fills behind
+ * once BOARD::OnUntrackedChanges() has been called.
+ */
+BOOST_AUTO_TEST_CASE( UntrackedChanges )
+{
+    BOOST_REQUIRE( fill( false ) );
+
+    double oldArea = polysArea( m_zone->GetFilledPolysList( F_Cu ) );
+
+    m_vias[1]->SetWidth( Millimeter2iu( 3 ) );
+    m_board->OnUntrackedChanges();
+
+    BOOST_CHECK( m_zone->NeedRefill() );
+    BOOST_REQUIRE( fill( true ) );
+
+    double newArea = polysArea( m_zone->GetFilledPolysList( F_Cu ) );
+
+    BOOST_CHECK_LT( newArea, oldArea );
+
+    m_zone->SetNeedRefill( true );
+    BOOST_REQUIRE( fill( false ) );
+
+    BOOST_CHECK_CLOSE( polysArea( m_zone->GetFilledPolysList( F_Cu ) ), newArea, 1e-6 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,156 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <connectivity/connectivity_algo.h>
+#include <connectivity/connectivity_data.h>
+#include <profile.h>
+
+#include <cstdio>
+#include <mutex>
+
+
+/**
+ * Sizes of the connectivity graph of a board.
+ */
+struct GRAPH_STATS
+{
+    size_t m_items = 0;
+    size_t m_anchors = 0;
+    size_t m_connections = 0;
+};
+
+
+static GRAPH_STATS graphStats( const CN_CONNECTIVITY_ALGO& aAlgo )
+{
+    GRAPH_STATS stats;
+
+    aAlgo.ForEachItem(
+            [&stats]( CN_ITEM& aItem )
+            {
+                stats.m_items++;
+                stats.m_anchors += aItem.Anchors().size();
+                stats.m_connections += aItem.ConnectedItems().size();
+            } );
+
+    return stats;
+}
+
+
+/**
+ * Estimate the heap used by the items and anchors, with the anchors either allocated one by
+ * one (shared_ptr control block and all, plus a lock per item) or stored in one block per item.
+ * The connection lists and the spatial index are the same for both and left out.
+ */
+static double estimateMB( const GRAPH_STATS& aStats, bool aAnchorBlocks )
+{
+    // Bookkeeping of the allocator itself, per allocation
+    const size_t mallocOverhead = 16;
+    const size_t controlBlock = 2 * sizeof( long ) + sizeof( void* );
+
+    size_t itemBytes = sizeof( CN_ITEM ) + mallocOverhead;
+    size_t anchorBytes = sizeof( CN_ANCHOR_PTR ) + sizeof( CN_ANCHOR );
+
+    if( aAnchorBlocks )
+    {
+        itemBytes += controlBlock + sizeof( std::vector<CN_ANCHOR> ) + 2 * mallocOverhead;
+    }
+    else
+    {
+        // A lock instead of the block handle
+        itemBytes += sizeof( std::mutex ) - sizeof( std::shared_ptr<std::vector<CN_ANCHOR>> );
+        anchorBytes += controlBlock + mallocOverhead;
+    }
+
+    return ( aStats.m_items * itemBytes + aStats.m_anchors * anchorBytes ) / ( 1024.0 * 1024.0 );
+}
+
+
+static void benchmark( BOARD* aBoard, int aRuns )
+{
+    double      buildTime = 0.0;
+    GRAPH_STATS stats;
+
+    for( int ii = 0; ii < aRuns; ++ii )
+    {
+        CONNECTIVITY_DATA connectivity;
+
+        PROF_COUNTER build;
+        connectivity.Build( aBoard );
+        build.Stop();
+
+        buildTime += build.msecs();
+
+        if( ii == 0 )
+            stats = graphStats( *connectivity.GetConnectivityAlgo() );
+    }
+
+    printf( "%zu items, %zu anchors, %zu connections\n", stats.m_items, stats.m_anchors,
+            stats.m_connections );
+    printf( "  build and ratsnest: %.2f ms\n", buildTime / aRuns );
+    printf( "  items and anchors:  %.1f MB (%.1f MB with one allocation per anchor)\n",
+            estimateMB( stats, true ), estimateMB( stats, false ) );
+}
+
+
+enum CONNECTIVITY_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC
+};
+
+
+int connectivity_benchmark_main( int argc, char* argv[] )
+{
+    if( argc < 2 )
+    {
+        printf( "usage: %s <board file> [...]\n", argv[0] );
+        printf( "  e.g. %s qa/data/*.kicad_pcb\n", argv[0] );
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const int runs = 5;
+
+    for( int ii = 1; ii < argc; ++ii )
+    {
+        std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( argv[ii] );
+
+        if( !brd )
+            return CONNECTIVITY_BENCH_RET_CODES::LOAD_FAILED;
+
+        printf( "%s: ", argv[ii] );
+        benchmark( brd.get(), runs );
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "connectivity_benchmark",
+        "Report the connectivity build and ratsnest times and memory use of PCB files",
+        connectivity_benchmark_main,
+} );
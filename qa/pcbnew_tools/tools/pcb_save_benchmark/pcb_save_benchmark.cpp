@@ -0,0 +1,117 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <plugins/kicad/kicad_plugin.h>
+#include <profile.h>
+#include <richio.h>
+
+#include <cstdio>
+
+
+/**
+ * Format a board to an s-expression string, the way PCB_IO::Save() does.
+ */
+static void formatBoard( BOARD* aBoard, STRING_FORMATTER& aFormatter )
+{
+    PCB_IO io;
+
+    io.SetOutputFormatter( &aFormatter );
+
+    aFormatter.Print( 0, "(kicad_pcb (version %d) (generator pcbnew)\n",
+                      SEXPR_BOARD_FILE_VERSION );
+    io.Format( aBoard, 1 );
+    aFormatter.Print( 0, ")\n" );
+}
+
+
+enum SAVE_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    WRITE_FAILED
+};
+
+
+int pcb_save_benchmark_main( int argc, char* argv[] )
+{
+    if( argc < 2 )
+    {
+        printf( "usage: %s <board file> [<output file>]\n", argv[0] );
+        printf( "  Times formatting the board to a string. The output file, if given, receives\n"
+                "  the formatted board, to compare it byte for byte with another build.\n" );
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( argv[1] );
+
+    if( !brd )
+        return SAVE_BENCH_RET_CODES::LOAD_FAILED;
+
+    const int        runs = 10;
+    double           formatTime = 0.0;
+    STRING_FORMATTER formatter;
+
+    for( int ii = 0; ii < runs; ++ii )
+    {
+        formatter.Clear();
+
+        PROF_COUNTER timer;
+        formatBoard( brd.get(), formatter );
+        timer.Stop();
+
+        formatTime += timer.msecs();
+    }
+
+    const size_t bytes = formatter.GetString().size();
+
+    printf( "%s: %zu bytes\n", argv[1], bytes );
+    printf( "  format: %.2f ms (%.1f MB/s)\n", formatTime / runs,
+            bytes / ( 1024.0 * 1024.0 ) / ( formatTime / runs / 1000.0 ) );
+
+    if( argc > 2 )
+    {
+        FILE* fp = fopen( argv[2], "wb" );
+
+        if( !fp || fwrite( formatter.GetString().data(), 1, bytes, fp ) != bytes )
+        {
+            if( fp )
+                fclose( fp );
+
+            return SAVE_BENCH_RET_CODES::WRITE_FAILED;
+        }
+
+        fclose( fp );
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "pcb_save_benchmark",
+        "Report the time to format PCB files for saving",
+        pcb_save_benchmark_main,
+} );
@@ -0,0 +1,305 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <drc/drc_engine.h>
+#include <profile.h>
+
+#include <router/pns_debug_decorator.h>
+#include <router/pns_kicad_iface.h>
+#include <router/pns_logger.h>
+#include <router/pns_node.h>
+#include <router/pns_perf_counters.h>
+#include <router/pns_router.h>
+#include <router/pns_routing_settings.h>
+#include <router/pns_sizes_settings.h>
+
+#include <wx/filename.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+
+/**
+ * Latencies and router operation counts of the replayed events of one type.
+ */
+struct EVENT_STATS
+{
+    EVENT_STATS() :
+            m_branches( 0 ),
+            m_collisionQueries( 0 ),
+            m_optimizerIterations( 0 )
+    {}
+
+    void Add( double aMsecs, const PNS::PERF_COUNTERS::SNAPSHOT& aBefore,
+              const PNS::PERF_COUNTERS::SNAPSHOT& aAfter )
+    {
+        m_latencies.push_back( aMsecs );
+        m_branches += aAfter.m_branches - aBefore.m_branches;
+        m_collisionQueries += aAfter.m_collisionQueries - aBefore.m_collisionQueries;
+        m_optimizerIterations += aAfter.m_optimizerIterations - aBefore.m_optimizerIterations;
+    }
+
+    double Percentile( double aFraction )
+    {
+        if( m_latencies.empty() )
+            return 0.0;
+
+        size_t idx = std::min( m_latencies.size() - 1,
+                               static_cast<size_t>( aFraction * m_latencies.size() ) );
+
+        std::nth_element( m_latencies.begin(), m_latencies.begin() + idx, m_latencies.end() );
+        return m_latencies[idx];
+    }
+
+    std::vector<double> m_latencies;
+    uint64_t            m_branches;
+    uint64_t            m_collisionQueries;
+    uint64_t            m_optimizerIterations;
+};
+
+
+static const char* eventName( PNS::LOGGER::EVENT_TYPE aType )
+{
+    switch( aType )
+    {
+    case PNS::LOGGER::EVT_START_ROUTE: return "start-route";
+    case PNS::LOGGER::EVT_START_DRAG:  return "start-drag";
+    case PNS::LOGGER::EVT_FIX:         return "fix";
+    case PNS::LOGGER::EVT_MOVE:        return "move";
+    case PNS::LOGGER::EVT_ABORT:       return "stop";
+    default:                           return "?";
+    }
+}
+
+
+/**
+ * Replays the logged events through a headless router, the way ROUTER_TOOL drives it.
+ */
+class PNS_REPLAY
+{
+public:
+    PNS_REPLAY( BOARD* aBoard, PNS::PNS_MODE aMode ) :
+            m_board( aBoard ),
+            m_settings( nullptr, "" )
+    {
+        m_iface.SetBoard( aBoard );
+        m_iface.SetDebugDecorator( &m_decorator );
+
+        m_router.SetInterface( &m_iface );
+        m_router.ClearWorld();
+        m_router.SyncWorld();
+
+        m_settings.SetMode( aMode );
+        m_router.LoadSettings( &m_settings );
+    }
+
+    void Run( const std::vector<PNS::LOGGER::EVENT_ENTRY>& aEvents )
+    {
+        for( const PNS::LOGGER::EVENT_ENTRY& evt : aEvents )
+        {
+            PNS::ITEM* item = findItem( evt.uuid );
+
+            PNS::PERF_COUNTERS::SNAPSHOT before = PNS::PERF_COUNTERS::Get().Snapshot();
+            PROF_COUNTER                 timer;
+
+            if( !replay( evt, item ) )
+                continue;
+
+            timer.Stop();
+
+            m_stats[evt.type].Add( timer.msecs(), before, PNS::PERF_COUNTERS::Get().Snapshot() );
+        }
+
+        m_router.StopRouting();
+    }
+
+    void Report()
+    {
+        printf( "%-12s %7s %9s %9s %9s %9s %10s %12s %12s\n", "event", "count", "p50 (ms)",
+                "p90 (ms)", "p99 (ms)", "max (ms)", "branches", "coll. qrys", "opt. iters" );
+
+        for( std::pair<const PNS::LOGGER::EVENT_TYPE, EVENT_STATS>& entry : m_stats )
+        {
+            EVENT_STATS& stats = entry.second;
+
+            printf( "%-12s %7d %9.3f %9.3f %9.3f %9.3f %10llu %12llu %12llu\n",
+                    eventName( entry.first ), (int) stats.m_latencies.size(),
+                    stats.Percentile( 0.5 ), stats.Percentile( 0.9 ), stats.Percentile( 0.99 ),
+                    stats.Percentile( 1.0 ), (unsigned long long) stats.m_branches,
+                    (unsigned long long) stats.m_collisionQueries,
+                    (unsigned long long) stats.m_optimizerIterations );
+        }
+    }
+
+private:
+    PNS::ITEM* findItem( const KIID& aId )
+    {
+        if( aId == niluuid || !m_router.GetWorld() )
+            return nullptr;
+
+        BOARD_ITEM* parent = m_board->GetItem( aId );
+
+        if( !parent || parent->Type() == NOT_USED )
+            return nullptr;
+
+        return m_router.GetWorld()->FindItemByParent( parent );
+    }
+
+    /**
+     * @return false if the event was skipped because it doesn't fit the router state.
+     */
+    bool replay( const PNS::LOGGER::EVENT_ENTRY& aEvent, PNS::ITEM* aItem )
+    {
+        switch( aEvent.type )
+        {
+        case PNS::LOGGER::EVT_START_ROUTE:
+        {
+            if( m_router.RoutingInProgress() )
+                return false;
+
+            PNS::SIZES_SETTINGS sizes( m_router.Sizes() );
+
+            m_iface.ImportSizes( sizes, aItem, -1 );
+            sizes.AddLayerPair( F_Cu, B_Cu );
+            m_router.UpdateSizes( sizes );
+
+            // The log doesn't record the active layer; start on the one of the start item
+            int layer = aItem ? aItem->Layers().Start() : F_Cu;
+
+            m_router.StartRouting( aEvent.p, aItem, layer );
+            return true;
+        }
+
+        case PNS::LOGGER::EVT_START_DRAG:
+            if( m_router.RoutingInProgress() || !aItem )
+                return false;
+
+            m_router.StartDragging( aEvent.p, aItem, PNS::DM_ANY );
+            return true;
+
+        case PNS::LOGGER::EVT_MOVE:
+            if( !m_router.RoutingInProgress() )
+                return false;
+
+            m_router.Move( aEvent.p, aItem );
+            return true;
+
+        case PNS::LOGGER::EVT_FIX:
+            if( !m_router.RoutingInProgress() )
+                return false;
+
+            m_router.FixRoute( aEvent.p, aItem );
+            return true;
+
+        case PNS::LOGGER::EVT_ABORT:
+            if( !m_router.RoutingInProgress() )
+                return false;
+
+            m_router.StopRouting();
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    BOARD*                 m_board;
+    PNS_KICAD_IFACE_BASE   m_iface;
+    PNS::DEBUG_DECORATOR   m_decorator;     ///< draws nothing
+    PNS::ROUTER            m_router;
+    PNS::ROUTING_SETTINGS  m_settings;
+
+    std::map<PNS::LOGGER::EVENT_TYPE, EVENT_STATS> m_stats;
+};
+
+
+enum PNS_REPLAY_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    BAD_LOG
+};
+
+
+int pns_replay_main( int argc, char* argv[] )
+{
+    if( argc < 3 )
+    {
+        printf( "usage: %s <board file> <router log> [walkaround|shove|mark]\n", argv[0] );
+        printf( "  The log is the one saved by the router (debug builds, '0' key); replay it\n"
+                "  on the board as it was before the logged routing session.\n" );
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    PNS::PNS_MODE mode = PNS::RM_Walkaround;
+
+    if( argc > 3 )
+    {
+        if( !strcmp( argv[3], "shove" ) )
+            mode = PNS::RM_Shove;
+        else if( !strcmp( argv[3], "mark" ) )
+            mode = PNS::RM_MarkObstacles;
+    }
+
+    std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( argv[1] );
+
+    if( !brd )
+        return PNS_REPLAY_RET_CODES::LOAD_FAILED;
+
+    PNS::LOGGER log;
+
+    if( !log.Load( argv[2] ) )
+    {
+        printf( "can't read router log '%s'\n", argv[2] );
+        return PNS_REPLAY_RET_CODES::BAD_LOG;
+    }
+
+    // Use the custom rules of the board, if it has any
+    BOARD_DESIGN_SETTINGS& bds = brd->GetDesignSettings();
+    wxFileName             rules( wxString::FromUTF8( argv[1] ) );
+
+    rules.SetExt( "kicad_dru" );
+
+    bds.m_DRCEngine = std::make_shared<DRC_ENGINE>( brd.get(), &bds );
+    bds.m_DRCEngine->InitEngine( rules.FileExists() ? rules : wxFileName() );
+
+    PNS_REPLAY replay( brd.get(), mode );
+
+    replay.Run( log.GetEvents() );
+    replay.Report();
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "pns_replay",
+        "Replay a router log on a PCB file and report the latency of the routing events",
+        pns_replay_main,
+} );
@@ -0,0 +1,180 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_poly_set.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <macros.h>
+#include <profile.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+
+/**
+ * Collect the clearance holes of the copper items on aLayer which don't belong to the net of
+ * aZone, roughly like the zone filler knocks them out.
+ */
+static void collectKnockouts( BOARD* aBoard, ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer,
+                              int aClearance, SHAPE_POLY_SET& aHoles )
+{
+    auto knockout =
+            [&]( BOARD_CONNECTED_ITEM* aItem )
+            {
+                if( aItem->GetNetCode() == aZone->GetNetCode() || !aItem->IsOnLayer( aLayer ) )
+                    return;
+
+                aItem->TransformShapeWithClearanceToPolygon( aHoles, aLayer, aClearance,
+                                                             ARC_HIGH_DEF, ERROR_OUTSIDE );
+            };
+
+    for( TRACK* track : aBoard->Tracks() )
+        knockout( track );
+
+    for( MODULE* module : aBoard->Modules() )
+    {
+        for( D_PAD* pad : module->Pads() )
+            knockout( pad );
+    }
+}
+
+
+static double polySetArea( const SHAPE_POLY_SET& aSet )
+{
+    double area = 0.0;
+
+    for( int ii = 0; ii < aSet.OutlineCount(); ++ii )
+    {
+        area += std::abs( aSet.COutline( ii ).Area() );
+
+        for( int jj = 0; jj < aSet.HoleCount( ii ); ++jj )
+            area -= std::abs( aSet.CHole( ii, jj ).Area() );
+    }
+
+    return area;
+}
+
+
+/**
+ * @return true if the tiled subtraction gave the same area as the plain one for all the zones.
+ */
+static bool benchmark( BOARD* aBoard, int aClearance, int aThreads )
+{
+    bool match = true;
+
+    printf( "%-24s %10s %10s %12s %12s\n", "zone", "vertices", "holes", "plain (ms)",
+            "tiled (ms)" );
+
+    for( ZONE_CONTAINER* zone : aBoard->Zones() )
+    {
+        if( zone->GetIsRuleArea() || !zone->IsOnCopperLayer() )
+            continue;
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().CuStack() )
+        {
+            SHAPE_POLY_SET holes;
+
+            collectKnockouts( aBoard, zone, layer, aClearance, holes );
+
+            SHAPE_POLY_SET plain = *zone->Outline();
+            SHAPE_POLY_SET tiled = *zone->Outline();
+
+            PROF_COUNTER plainTime;
+            plain.BooleanSubtract( holes, SHAPE_POLY_SET::PM_FAST );
+            plainTime.Stop();
+
+            PROF_COUNTER tiledTime;
+            tiled.BooleanSubtractTiled( holes, SHAPE_POLY_SET::PM_FAST, aThreads );
+            tiledTime.Stop();
+
+            double plainArea = polySetArea( plain );
+            double tiledArea = polySetArea( tiled );
+
+            // Seams are merged exactly, but allow for rounding in the area sums
+            if( std::abs( plainArea - tiledArea ) > 1e-6 * std::max( plainArea, 1.0 ) )
+            {
+                printf( "area mismatch: %g vs %g\n", plainArea, tiledArea );
+                match = false;
+            }
+
+            wxString name = zone->GetNetname() + wxT( " " ) + aBoard->GetLayerName( layer );
+
+            printf( "%-24s %10d %10d %12.2f %12.2f\n", TO_UTF8( name ),
+                    holes.TotalVertices(), holes.OutlineCount(), plainTime.msecs(),
+                    tiledTime.msecs() );
+        }
+    }
+
+    return match;
+}
+
+
+enum TILED_BOOLEAN_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    MISMATCH
+};
+
+
+int tiled_boolean_benchmark_main( int argc, char* argv[] )
+{
+    if( argc < 2 )
+    {
+        printf( "usage: %s <board file> [threads]\n", argv[0] );
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    // A typical clearance, in nm
+    const int clearance = 200000;
+    int       threads = 0;
+
+    if( argc > 2 )
+        threads = atoi( argv[2] );
+
+    std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( argv[1] );
+
+    if( !brd )
+        return TILED_BOOLEAN_BENCH_RET_CODES::LOAD_FAILED;
+
+    if( !benchmark( brd.get(), clearance, threads ) )
+        return TILED_BOOLEAN_BENCH_RET_CODES::MISMATCH;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "tiled_boolean_benchmark",
+        "Compare plain and tiled boolean subtraction of zone knockouts on a PCB file",
+        tiled_boolean_benchmark_main,
+} );
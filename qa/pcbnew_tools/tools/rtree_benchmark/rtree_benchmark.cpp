@@ -0,0 +1,233 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/packed_rtree.h>
+#include <geometry/rtree.h>
+#include <geometry/shape.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <profile.h>
+
+#include <cstdio>
+
+
+using BENCH_ENTRY = PACKED_RTREE<BOARD_ITEM*, 2>::ENTRY;
+
+
+/**
+ * Collect the boxes of the effective (sub)shapes of all the board's items, per layer, the way
+ * DRC_RTREE indexes them.
+ */
+static void collectEntries( BOARD* aBoard, std::vector<BENCH_ENTRY> aEntries[] )
+{
+    std::vector<BOARD_ITEM*> items;
+
+    for( TRACK* track : aBoard->Tracks() )
+        items.push_back( track );
+
+    for( BOARD_ITEM* item : aBoard->Drawings() )
+        items.push_back( item );
+
+    for( ZONE_CONTAINER* zone : aBoard->Zones() )
+        items.push_back( zone );
+
+    for( MODULE* module : aBoard->Modules() )
+    {
+        for( D_PAD* pad : module->Pads() )
+            items.push_back( pad );
+
+        for( BOARD_ITEM* item : module->GraphicalItems() )
+            items.push_back( item );
+    }
+
+    for( BOARD_ITEM* item : items )
+    {
+        for( PCB_LAYER_ID layer : item->GetLayerSet().Seq() )
+        {
+            std::shared_ptr<SHAPE> shape = item->GetEffectiveShape( layer );
+            std::vector<SHAPE*>    subshapes;
+
+            if( shape->HasIndexableSubshapes() )
+                shape->GetIndexableSubshapes( subshapes );
+            else
+                subshapes.push_back( shape.get() );
+
+            for( SHAPE* subshape : subshapes )
+            {
+                BOX2I bbox = subshape->BBox();
+
+                aEntries[layer].push_back( { { bbox.GetX(), bbox.GetY() },
+                                             { bbox.GetRight(), bbox.GetBottom() },
+                                             item } );
+            }
+        }
+    }
+}
+
+
+/**
+ * @return true if both trees found the same number of hits.
+ */
+static bool benchmark( BOARD* aBoard, int aClearance )
+{
+    std::vector<BENCH_ENTRY> entries[PCB_LAYER_ID_COUNT];
+    size_t                   entryCount = 0;
+
+    collectEntries( aBoard, entries );
+
+    for( const std::vector<BENCH_ENTRY>& layerEntries : entries )
+        entryCount += layerEntries.size();
+
+    // Query each shape's box, inflated by the clearance, like the DRC providers do
+    auto queryBox =
+            []( const BENCH_ENTRY& aEntry, int aClearance, int aMin[2], int aMax[2] )
+            {
+                aMin[0] = aEntry.min[0] - aClearance;
+                aMin[1] = aEntry.min[1] - aClearance;
+                aMax[0] = aEntry.max[0] + aClearance;
+                aMax[1] = aEntry.max[1] + aClearance;
+            };
+
+    size_t rtreeHits = 0;
+    size_t packedHits = 0;
+
+    auto countRTree = [&]( BOARD_ITEM* ) -> bool { rtreeHits++; return true; };
+    auto countPacked = [&]( BOARD_ITEM* ) -> bool { packedHits++; return true; };
+
+    // Dynamic R-tree, one insert at a time
+    std::vector<RTree<BOARD_ITEM*, int, 2, double>> rtrees( PCB_LAYER_ID_COUNT );
+
+    PROF_COUNTER rtreeBuild;
+
+    for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+    {
+        for( const BENCH_ENTRY& entry : entries[layer] )
+            rtrees[layer].Insert( entry.min, entry.max, entry.data );
+    }
+
+    rtreeBuild.Stop();
+
+    PROF_COUNTER rtreeQuery;
+
+    for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+    {
+        for( const BENCH_ENTRY& entry : entries[layer] )
+        {
+            int min[2], max[2];
+
+            queryBox( entry, aClearance, min, max );
+            rtrees[layer].Search( min, max, countRTree );
+        }
+    }
+
+    rtreeQuery.Stop();
+
+    // Packed R-tree, built in one go
+    std::vector<PACKED_RTREE<BOARD_ITEM*, 2>> packedTrees( PCB_LAYER_ID_COUNT );
+
+    PROF_COUNTER packedBuild;
+
+    for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+    {
+        std::vector<BENCH_ENTRY> layerEntries( entries[layer] );
+        packedTrees[layer].Build( layerEntries );
+    }
+
+    packedBuild.Stop();
+
+    PROF_COUNTER packedQuery;
+
+    for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+    {
+        for( const BENCH_ENTRY& entry : entries[layer] )
+        {
+            int min[2], max[2];
+
+            queryBox( entry, aClearance, min, max );
+            packedTrees[layer].Search( min, max, countPacked );
+        }
+    }
+
+    packedQuery.Stop();
+
+    printf( "%zu shapes, %zu queries\n", entryCount, entryCount );
+    printf( "%-8s %12s %12s %12s\n", "tree", "build (ms)", "query (ms)", "hits" );
+    printf( "%-8s %12.2f %12.2f %12zu\n", "RTree", rtreeBuild.msecs(), rtreeQuery.msecs(),
+            rtreeHits );
+    printf( "%-8s %12.2f %12.2f %12zu\n", "packed", packedBuild.msecs(), packedQuery.msecs(),
+            packedHits );
+
+    return rtreeHits == packedHits;
+}
+
+
+enum RTREE_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    MISMATCH
+};
+
+
+int rtree_benchmark_main( int argc, char* argv[] )
+{
+    if( argc < 2 )
+    {
+        printf( "usage: %s <board file> [...]\n", argv[0] );
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    // A typical clearance, in nm
+    const int clearance = 200000;
+    bool      match = true;
+
+    for( int ii = 1; ii < argc; ++ii )
+    {
+        std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( argv[ii] );
+
+        if( !brd )
+            return RTREE_BENCH_RET_CODES::LOAD_FAILED;
+
+        printf( "%s: ", argv[ii] );
+        match &= benchmark( brd.get(), clearance );
+    }
+
+    if( !match )
+        return RTREE_BENCH_RET_CODES::MISMATCH;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "rtree_benchmark",
+        "Compare build and query times of the dynamic and packed R-trees on PCB files",
+        rtree_benchmark_main,
+} );